@@ -0,0 +1,1310 @@
+#include "dynamic_struct.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <sstream>
+#include <fstream>
+#include <map>
+#include <unordered_set>
+#include <unordered_map>
+#include <thread>
+
+using namespace dynamic_struct;
+
+/* Prevent the compiler from discarding the measured work */
+volatile int64_t sink = 0;
+
+/* Count heap allocations through `new` */
+size_t allocation_count = 0;
+
+/* Keep GCC from pairing the inlined `free` with `new` and warning about a mismatch */
+#if defined(__GNUC__) && !defined(__clang__)
+#define BENCHMARK_NOINLINE __attribute__((noinline))
+#else
+#define BENCHMARK_NOINLINE
+#endif
+
+BENCHMARK_NOINLINE void* operator new(size_t size) {
+    ++allocation_count;
+    void* ptr = malloc(size == 0 ? 1 : size);
+    if (ptr == nullptr) throw std::bad_alloc();
+    return ptr;
+}
+BENCHMARK_NOINLINE void operator delete(void* ptr) noexcept { free(ptr); }
+BENCHMARK_NOINLINE void operator delete(void* ptr, size_t) noexcept { free(ptr); }
+
+/* Return nanoseconds per iteration of `function` */
+template <typename Function>
+double measure(size_t iterations, Function function) {
+    auto start = std::chrono::steady_clock::now();
+    for (size_t index = 0; index < iterations; ++index) function(index);
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() / iterations;
+}
+
+/**
+ * Results are written as they are measured, either aligned for reading, or as CSV or JSON for tracking regressions
+ * Each result carries the suite, the name of measurement, the value and its unit.
+ */
+enum class Output_Format {
+    Text,
+    CSV,
+    JSON
+};
+Output_Format output_format = Output_Format::Text;
+const char* current_suite = "";
+size_t reported = 0;
+
+std::string escape(const std::string& str, bool json) {
+    std::string escaped;
+    for (char c : str) {
+        if (c == '"') escaped += json ? "\\\"" : "\"\"";
+        else if (c == '\\' && json) escaped += "\\\\";
+        else escaped += c;
+    }
+    return escaped;
+}
+
+void report_value(const std::string& name, double value, const char* unit) {
+    switch (output_format) {
+    case Output_Format::Text:
+        printf("%-48s %12.2f %s\n", name.c_str(), value, unit);
+        break;
+    case Output_Format::CSV:
+        printf("%s,\"%s\",%.2f,%s\n", current_suite, escape(name, false).c_str(), value, unit);
+        break;
+    case Output_Format::JSON:
+        printf("%s\n    { \"suite\": \"%s\", \"name\": \"%s\", \"value\": %.2f, \"unit\": \"%s\" }", reported == 0 ? "" : ",", current_suite, escape(name, true).c_str(), value, unit);
+        break;
+    }
+    ++reported;
+    fflush(stdout);
+}
+
+void report(const std::string& name, double nanoseconds) {
+    report_value(name, nanoseconds, "ns");
+}
+
+void report_allocations(const std::string& name, size_t allocations, size_t iterations) {
+    report_value(name, static_cast<double>(allocations) / iterations, "allocations");
+}
+
+void benchmark_field_path() {
+    const size_t iterations = 1000000;
+    Struct_Type point({
+        Int_64("x"),
+        Int_64("y")
+    }, "point");
+    Struct_Type triangle({
+        Struct_Clone(point, "point_a"),
+        Struct_Clone(point, "point_b"),
+        Tensor(4, 4, 3, Float_32(), "tensor")
+    }, "triangle");
+    triangle.init();
+
+    report("struct key access: operator[]", measure(iterations, [&](size_t index) {
+        *triangle["point_b"]["y"].get_Int_64() += index;
+        sink += *triangle["point_b"]["y"].get_Int_64();
+    }));
+    Field_Path y = triangle.compile_path("point_b.y");
+    report("struct key access: Field_Path", measure(iterations, [&](size_t index) {
+        *y.get_Int_64(triangle.get_data()) += index;
+        sink += *y.get_Int_64(triangle.get_data());
+    }));
+
+    report("array element access: operator[]", measure(iterations, [&](size_t index) {
+        *triangle["tensor"][2]->at(1)->at(2)->get_Float_32() += 1.0f;
+        sink += static_cast<int64_t>(*triangle["tensor"][2]->at(1)->at(2)->get_Float_32());
+    }));
+    Field_Path element = triangle.compile_path("tensor[2][1][2]");
+    report("array element access: Field_Path", measure(iterations, [&](size_t index) {
+        *element.get_Float_32(triangle.get_data()) += 1.0f;
+        sink += static_cast<int64_t>(*element.get_Float_32(triangle.get_data()));
+    }));
+}
+
+void benchmark_array_view() {
+    const size_t length = 1000000;
+    Array_Type array(length, Float_32(), "array");
+    array.init();
+
+    size_t allocations = allocation_count;
+    report("1M elements iteration: operator[]", measure(1, [&](size_t) {
+        float sum = 0.0f;
+        for (size_t index = 0; index < length; ++index) sum += *array[index]->get_Float_32();
+        sink += static_cast<int64_t>(sum);
+    }));
+    report_allocations("1M elements iteration: operator[]", allocation_count - allocations, 1);
+
+    allocations = allocation_count;
+    report("1M elements iteration: Type_View", measure(1, [&](size_t) {
+        Type_View view = array.view();
+        float sum = 0.0f;
+        for (size_t index = 0; index < length; ++index) sum += *view[index].get_Float_32();
+        sink += static_cast<int64_t>(sum);
+    }));
+    report_allocations("1M elements iteration: Type_View", allocation_count - allocations, 1);
+
+    const size_t iterations = 100000;
+    std::unique_ptr<Array_Type> tensor_ptr(Tensor(32, 32, 3, Float_32(), "tensor")->clone());
+    Array_Type& tensor = *tensor_ptr;
+    tensor.init();
+    allocations = allocation_count;
+    report("tensor element access: operator[]", measure(iterations, [&](size_t index) {
+        sink += static_cast<int64_t>(*tensor[index % 32]->at(index % 31)->at(index % 3)->get_Float_32());
+    }));
+    report_allocations("tensor element access: operator[]", allocation_count - allocations, iterations);
+
+    allocations = allocation_count;
+    Type_View tensor_view = tensor.view();
+    report("tensor element access: Type_View", measure(iterations, [&](size_t index) {
+        sink += static_cast<int64_t>(*tensor_view[index % 32][index % 31][index % 3].get_Float_32());
+    }));
+    report_allocations("tensor element access: Type_View", allocation_count - allocations, iterations);
+}
+
+void benchmark_record_batch() {
+    const size_t rows = 1000000;
+    Struct_Type point({
+        Int_64("x"),
+        Int_64("y"),
+        Float_32("weight")
+    }, "point");
+
+    size_t allocations = allocation_count;
+    report("1M rows: Record_Batch append", measure(1, [&](size_t) {
+        Record_Batch batch(&point);
+        for (size_t index = 0; index < rows; ++index) batch.append()["x"].set(static_cast<int64_t>(index));
+        sink += *batch[rows / 2]["x"].get_Int_64();
+    }));
+    report_allocations("1M rows: Record_Batch append", allocation_count - allocations, rows);
+
+    allocations = allocation_count;
+    report("1M rows: clone and init per row", measure(1, [&](size_t) {
+        std::vector<std::unique_ptr<Struct_Type>> instances;
+        instances.reserve(rows);
+        for (size_t index = 0; index < rows; ++index) {
+            instances.emplace_back(point.clone());
+            instances.back()->init();
+            instances.back()->get("x").set(static_cast<int64_t>(index));
+        }
+        sink += *instances[rows / 2]->get("x").get_Int_64();
+    }));
+    report_allocations("1M rows: clone and init per row", allocation_count - allocations, rows);
+}
+
+void benchmark_column_batch() {
+    const size_t rows = 1000000;
+    std::vector<Type*> properties;
+    std::vector<std::unique_ptr<Primitive_Type>> holders;
+    for (size_t index = 0; index < 15; ++index) {
+        holders.emplace_back(new Primitive_Type(Primitive_Data_Types::Int_64, "property_" + std::to_string(index)));
+        properties.push_back(holders.back().get());
+    }
+    holders.emplace_back(new Primitive_Type(Primitive_Data_Types::Float_64, "price"));
+    properties.push_back(holders.back().get());
+    Struct_Type order(properties, "order");
+
+    Record_Batch batch(&order, rows);
+    Field_Path price = order.compile_path("price");
+    for (size_t index = 0; index < rows; ++index) price.set(batch.append().get_data(), index * 0.25);
+
+    report("scan 1 of 16 properties: Record_Batch", measure(1, [&](size_t) {
+        double sum = 0.0;
+        char* data = static_cast<char*>(batch.get_data());
+        for (size_t index = 0; index < rows; ++index) sum += *reinterpret_cast<double*>(price.locate(data + batch.get_Stride() * index));
+        sink += static_cast<int64_t>(sum);
+    }));
+
+    Column_Batch columns(batch);
+    report("scan 1 of 16 properties: Column_Batch", measure(1, [&](size_t) {
+        double sum = 0.0;
+        const double* column = static_cast<const double*>(columns.get_Column(price));
+        for (size_t index = 0; index < rows; ++index) sum += column[index];
+        sink += static_cast<int64_t>(sum);
+    }));
+
+    report("convert 1M rows into columns", measure(1, [&](size_t) {
+        Column_Batch converted(batch);
+        sink += converted.get_Size();
+    }));
+}
+
+void benchmark_reduce() {
+    const size_t length = 1 << 20;
+    const Primitive_Data_Types types[] = {
+        Primitive_Data_Types::Int_8, Primitive_Data_Types::Int_16, Primitive_Data_Types::Int_32, Primitive_Data_Types::Int_64,
+        Primitive_Data_Types::Unsigned_Int_8, Primitive_Data_Types::Unsigned_Int_16, Primitive_Data_Types::Unsigned_Int_32, Primitive_Data_Types::Unsigned_Int_64,
+        Primitive_Data_Types::Char, Primitive_Data_Types::Boolean, Primitive_Data_Types::Float_32, Primitive_Data_Types::Float_64
+    };
+    const Reduction operations[] = { Reduction::Sum, Reduction::Min, Reduction::Max, Reduction::Mean, Reduction::Count_Nonzero };
+    const char* operation_names[] = { "Sum", "Min", "Max", "Mean", "Count_Nonzero" };
+    const Instruction_Set instruction_sets[] = { Instruction_Set::Scalar, Instruction_Set::SSE2, Instruction_Set::AVX2 };
+    const char* instruction_set_names[] = { "Scalar", "SSE2", "AVX2" };
+
+    for (Primitive_Data_Types type : types) {
+        Array_Type array(length, Primitive_Type_ptr(type, ""), "array");
+        array.init();
+        // Fill with small values, which are valid for every Primitive Type
+        unsigned char* bytes = static_cast<unsigned char*>(array.get_data());
+        for (size_t index = 0; index < length; ++index) {
+            Type_View element = array.view()[index];
+            switch (type) {
+            case Primitive_Data_Types::Boolean: element.set(index % 3 == 0); break;
+            case Primitive_Data_Types::Float_32: element.set(static_cast<float>(index % 100)); break;
+            case Primitive_Data_Types::Float_64: element.set(static_cast<double>(index % 100)); break;
+            default: bytes[index * array.get_Element_Type().size_of()] = static_cast<unsigned char>(index % 100);
+            }
+        }
+        for (size_t operation = 0; operation < 5; ++operation) {
+            for (size_t instruction_set = 0; instruction_set < 3; ++instruction_set) {
+                if (instruction_sets[instruction_set] > detect_instruction_set()) continue;
+                std::string name = "reduce 1M " + get_string_from_type(type) + " " + operation_names[operation] + " " + instruction_set_names[instruction_set];
+                report(name.c_str(), measure(10, [&](size_t) {
+                    sink += static_cast<int64_t>(reduce(operations[operation], array, instruction_sets[instruction_set]).as_Float_64());
+                }));
+            }
+        }
+    }
+}
+
+void benchmark_binary() {
+    const size_t rows = 100000;
+    Struct_Type point({
+        Int_64("x"),
+        Int_64("y"),
+        Float_64("weight")
+    }, "point");
+    Record_Batch batch(&point, rows);
+    for (size_t index = 0; index < rows; ++index) {
+        Type_View row = batch.append();
+        row["x"].set(static_cast<int64_t>(index));
+        row["weight"].set(index * 0.5);
+    }
+
+    report("100K rows round trip: string and set", measure(1, [&](size_t) {
+        std::stringstream stream;
+        for (size_t index = 0; index < rows; ++index) {
+            Type_View row = batch[index];
+            stream << row["x"].string() << " " << row["y"].string() << " " << row["weight"].string() << "\n";
+        }
+        Record_Batch loaded(&point, rows);
+        std::unique_ptr<Type> row(point.clone());
+        std::string x, y, weight;
+        for (size_t index = 0; index < rows; ++index) {
+            stream >> x >> y >> weight;
+            loaded.append();
+            loaded.hold(*row, index);
+            row->get("x").set(x);
+            row->get("y").set(y);
+            row->get("weight").set(weight);
+        }
+        sink += *loaded[rows / 2]["x"].get_Int_64();
+    }));
+
+    report("100K rows round trip: Save and Load_Batch", measure(1, [&](size_t) {
+        std::stringstream stream;
+        Save(stream, batch);
+        std::unique_ptr<Record_Batch> loaded = Load_Batch(stream);
+        sink += *loaded->at(rows / 2)["x"].get_Int_64();
+    }));
+}
+
+void benchmark_mapped_file() {
+    const size_t rows = 1000000;
+    Struct_Type point({
+        Int_64("x"),
+        Int_64("y"),
+        Float_64("weight")
+    }, "point");
+    {
+        Mapped_Record_File file("benchmark.bin", &point, rows);
+        for (size_t index = 0; index < rows; ++index) file.append()["x"].set(static_cast<int64_t>(index));
+    }
+
+    report("open 1M rows: Load_Batch", measure(1, [&](size_t) {
+        std::ifstream input("benchmark.bin", std::ios::binary);
+        std::unique_ptr<Record_Batch> loaded = Load_Batch(input);
+        sink += *loaded->at(rows / 2)["x"].get_Int_64();
+    }));
+    report("open 1M rows: Mapped_Record_File", measure(1, [&](size_t) {
+        Mapped_Record_File file("benchmark.bin");
+        sink += *file[rows / 2]["x"].get_Int_64();
+    }));
+    remove("benchmark.bin");
+}
+
+void benchmark_text_loader() {
+    const size_t rows = 1000000;
+    Struct_Type order({
+        Int_64("id"),
+        Int_32("quantity"),
+        Float_64("price"),
+        Boolean("paid")
+    }, "order");
+    std::string text;
+    for (size_t index = 0; index < rows; ++index) {
+        text += std::to_string(index * 7919) + " " + std::to_string(index % 1000) + " " + std::to_string(index % 10000) + "." + std::to_string(index % 100) + (index % 2 == 0 ? " true\n" : " false\n");
+    }
+    double megabytes = text.length() / 1e6;
+
+    double nanoseconds = measure(1, [&](size_t) {
+        std::stringstream stream(text);
+        Record_Batch batch(&order, rows);
+        std::unique_ptr<Type> row(order.clone());
+        for (size_t index = 0; index < rows; ++index) {
+            batch.append();
+            batch.hold(*row, index);
+            stream >> row->get("id") >> row->get("quantity") >> row->get("price") >> row->get("paid");
+        }
+        sink += *batch[rows / 2]["id"].get_Int_64();
+    });
+    report("1M rows text: operator>>", nanoseconds);
+    report_value("1M rows text: operator>>", megabytes / (nanoseconds / 1e9), "MB/s");
+
+    nanoseconds = measure(1, [&](size_t) {
+        Record_Batch batch(&order, rows);
+        Text_Loader loader(&order, ' ');
+        loader.load(text, batch);
+        sink += *batch[rows / 2]["id"].get_Int_64();
+    });
+    report("1M rows text: Text_Loader", nanoseconds);
+    report_value("1M rows text: Text_Loader", megabytes / (nanoseconds / 1e9), "MB/s");
+}
+
+void benchmark_text_writer() {
+    const size_t rows = 1000000;
+    Struct_Type order({
+        Int_64("id"),
+        Int_32("quantity"),
+        Float_64("price"),
+        Boolean("paid")
+    }, "order");
+    Record_Batch batch(&order, rows);
+    for (size_t index = 0; index < rows; ++index) {
+        Type_View row = batch.append();
+        row["id"].set(static_cast<int64_t>(index * 7919));
+        row["quantity"].set(static_cast<int32_t>(index % 1000));
+        row["price"].set(index * 0.37);
+        row["paid"].set(index % 2 == 0);
+    }
+
+    size_t bytes = 0;
+    double nanoseconds = measure(1, [&](size_t) {
+        std::ostringstream stream;
+        std::unique_ptr<Type> row(order.clone());
+        for (size_t index = 0; index < rows; ++index) {
+            batch.hold(*row, index);
+            stream << row->get("id") << "," << row->get("quantity") << "," << row->get("price") << "," << row->get("paid") << "\n";
+        }
+        bytes = stream.str().length();
+        sink += bytes;
+    });
+    report("1M rows text: operator<<", nanoseconds);
+    report_value("1M rows text: operator<<", bytes / 1e6 / (nanoseconds / 1e9), "MB/s");
+
+    nanoseconds = measure(1, [&](size_t) {
+        std::ostringstream stream;
+        Text_Writer writer(&order, stream);
+        writer.write(batch);
+        writer.flush();
+        bytes = stream.str().length();
+        sink += bytes;
+    });
+    report("1M rows text: Text_Writer", nanoseconds);
+    report_value("1M rows text: Text_Writer", bytes / 1e6 / (nanoseconds / 1e9), "MB/s");
+}
+
+void benchmark_layout() {
+    const size_t rows = 1000000;
+    const Layout_Policy policies[] = { Layout_Policy::Packed, Layout_Policy::Aligned, Layout_Policy::Compact };
+    const char* policy_names[] = { "Packed", "Aligned", "Compact" };
+    for (size_t policy = 0; policy < 3; ++policy) {
+        Struct_Type order({
+            Char("status"),
+            Int_64("id"),
+            Int_16("quantity"),
+            Float_64("price")
+        }, "order", policies[policy]);
+        Record_Batch batch(&order, rows);
+        Field_Path price = order.compile_path("price");
+        for (size_t index = 0; index < rows; ++index) price.set(batch.append().get_data(), index * 0.25);
+
+        std::string name = std::string("scan price of 1M rows: ") + policy_names[policy] + " (" + std::to_string(order.size_of()) + " bytes)";
+        report(name.c_str(), measure(10, [&](size_t) {
+            double sum = 0.0;
+            char* data = static_cast<char*>(batch.get_data());
+            for (size_t index = 0; index < rows; ++index) sum += *price.get_Float_64(data + batch.get_Stride() * index);
+            sink += static_cast<int64_t>(sum);
+        }));
+    }
+}
+
+void benchmark_schema() {
+    std::vector<std::unique_ptr<Primitive_Type>> properties;
+    std::vector<Type*> types;
+    for (size_t index = 0; index < 1000; ++index) {
+        properties.push_back(_Int_32("field_" + std::to_string(index)));
+        types.push_back(properties.back().get());
+    }
+    Struct_Type wide(types, "wide");
+    std::unique_ptr<Type> deep(Int_32("leaf")->clone());
+    for (size_t depth = 0; depth < 64; ++depth) deep.reset(new Struct_Type({ deep.get(), Int_8("tag") }, "level_" + std::to_string(depth)));
+
+    const size_t iterations = 10000;
+    const std::pair<const char*, Type*> schemas[] = { { "1000 properties", &wide }, { "64 levels", deep.get() } };
+    for (const std::pair<const char*, Type*>& schema : schemas) {
+        std::string name = std::string("clone of ") + schema.first;
+        size_t allocations = allocation_count;
+        report(name.c_str(), measure(iterations, [&](size_t) {
+            std::unique_ptr<Type> copy(schema.second->clone());
+            sink += static_cast<int64_t>(copy->size_of());
+        }));
+        report_allocations(name.c_str(), allocation_count - allocations, iterations);
+
+        // Rebuilding the tree is what cloning used to cost
+        std::string descriptor = Serialize(schema.second);
+        name = std::string("rebuild of ") + schema.first;
+        report(name.c_str(), measure(10, [&](size_t) {
+            sink += static_cast<int64_t>(Deserialize(descriptor)->size_of());
+        }));
+
+        name = std::string("instantiate and init of ") + schema.first;
+        report(name.c_str(), measure(iterations, [&](size_t) {
+            std::unique_ptr<Type> instance = instantiate(schema.second->get_Schema());
+            instance->init();
+            sink += static_cast<int64_t>(*static_cast<char*>(instance->get_data()));
+        }));
+
+        name = std::string("schema equality of ") + schema.first;
+        std::unique_ptr<Type> other(schema.second->clone());
+        report(name.c_str(), measure(iterations * 100, [&](size_t) {
+            sink += other->get_Schema() == schema.second->get_Schema();
+        }));
+    }
+}
+
+void benchmark_deserialize() {
+    std::string wide = "{wide";
+    for (size_t index = 0; index < 1000; ++index) wide += ",(field_" + std::to_string(index) + ",Int_32)";
+    wide += "}";
+    std::string deep = "(leaf,Int_32)";
+    for (size_t depth = 0; depth < 512; ++depth) deep = "{level_" + std::to_string(depth) + "," + deep + ",(tag,Int_8)}";
+
+    const std::pair<const char*, const std::string*> descriptors[] = { { "1000 properties", &wide }, { "512 levels", &deep } };
+    for (const std::pair<const char*, const std::string*>& descriptor : descriptors) {
+        std::string name = std::string("Deserialize of ") + descriptor.first;
+        size_t allocations = allocation_count;
+        double nanoseconds = measure(100, [&](size_t) {
+            sink += static_cast<int64_t>(Deserialize_Schema(*descriptor.second)->size_of());
+        });
+        report(name.c_str(), nanoseconds);
+        report_value(name.c_str(), descriptor.second->length() / 1e6 / (nanoseconds / 1e9), "MB/s");
+        report_allocations(name.c_str(), allocation_count - allocations, 100);
+    }
+
+    // Startup of a registry, where every descriptor is distinct
+    const size_t count = 10000;
+    std::vector<std::string> registry;
+    for (size_t index = 0; index < count; ++index) {
+        registry.push_back("{record_" + std::to_string(index) + ",(id,Int_64),[values,8,(,Float_32)],{point,(x,Int_32),(y,Int_32)}}");
+    }
+    std::vector<std::shared_ptr<const Schema>> schemas(count);
+    report("Deserialize of 10K registry descriptors", measure(1, [&](size_t) {
+        for (size_t index = 0; index < count; ++index) schemas[index] = Deserialize_Schema(registry[index]);
+    }));
+}
+
+void benchmark_binary_descriptor() {
+    const char* type_names[] = { "Int_32", "Unsigned_Int_64", "Float_64", "Boolean" };
+    std::string text = "{wide";
+    for (size_t index = 0; index < 1000; ++index) text += ",(f" + std::to_string(index) + "," + type_names[index % 4] + ")";
+    text += "}";
+    std::string binary = text_to_binary_descriptor(text);
+    report_value("descriptor of 1000 properties: text", static_cast<double>(text.length()), "bytes");
+    report_value("descriptor of 1000 properties: binary", static_cast<double>(binary.length()), "bytes");
+
+    report("decode 1000 properties: text", measure(100, [&](size_t) {
+        sink += static_cast<int64_t>(Deserialize_Schema(text)->size_of());
+    }));
+    report("decode 1000 properties: binary", measure(100, [&](size_t) {
+        sink += static_cast<int64_t>(Deserialize_Binary(binary)->size_of());
+    }));
+}
+
+void benchmark_key_index() {
+    const size_t lookups = 1000000;
+    const size_t counts[] = { 8, 100, 1000 };
+    for (size_t count : counts) {
+        std::vector<std::unique_ptr<Primitive_Type>> properties;
+        std::vector<Type*> types;
+        std::map<std::string, size_t> key_to_pos;
+        std::vector<std::string> keys;
+        for (size_t index = 0; index < count; ++index) {
+            keys.push_back("property_" + std::to_string(index));
+            properties.push_back(_Int_32(keys.back()));
+            types.push_back(properties.back().get());
+            key_to_pos[keys.back()] = index;
+        }
+        Struct_Type wide(types, "wide");
+        const Schema& schema = *wide.get_Schema();
+        std::vector<const char*> c_keys;
+        for (const std::string& key : keys) c_keys.push_back(key.c_str());
+
+        std::string name = "key lookup of " + std::to_string(count) + " properties: std::map";
+        report(name.c_str(), measure(lookups, [&](size_t index) {
+            sink += key_to_pos.find(keys[index * 7919 % count])->second;
+        }));
+        name = "key lookup of " + std::to_string(count) + " properties: flat index";
+        report(name.c_str(), measure(lookups, [&](size_t index) {
+            sink += schema.find(keys[index * 7919 % count]);
+        }));
+        name = "key lookup of " + std::to_string(count) + " properties: const char*";
+        report(name.c_str(), measure(lookups, [&](size_t index) {
+            sink += schema.find(c_keys[index * 7919 % count]);
+        }));
+    }
+}
+
+struct Native_Point {
+    int64_t x;
+    int64_t y;
+    double weight;
+};
+
+void benchmark_native_binding() {
+    const size_t rows = 1000000;
+    Struct_Type point({
+        Int_64("x"),
+        Int_64("y"),
+        Float_64("weight")
+    }, "point");
+    Record_Batch batch(&point, rows);
+    for (size_t index = 0; index < rows; ++index) batch.append()["weight"].set(index * 0.5);
+
+    report("scan weight of 1M rows: Type_View", measure(10, [&](size_t) {
+        double sum = 0.0;
+        for (size_t index = 0; index < rows; ++index) sum += *batch[index]["weight"].get_Float_64();
+        sink += static_cast<int64_t>(sum);
+    }));
+    Field_Path weight = point.compile_path("weight");
+    report("scan weight of 1M rows: Field_Path", measure(10, [&](size_t) {
+        double sum = 0.0;
+        char* data = static_cast<char*>(batch.get_data());
+        for (size_t index = 0; index < rows; ++index) sum += *weight.get_Float_64(data + batch.get_Stride() * index);
+        sink += static_cast<int64_t>(sum);
+    }));
+    Native_Binding<Native_Point> binding(&point, { NATIVE_FIELD(Native_Point, x), NATIVE_FIELD(Native_Point, y), NATIVE_FIELD(Native_Point, weight) });
+    report("scan weight of 1M rows: Native_Binding", measure(10, [&](size_t) {
+        double sum = 0.0;
+        const Native_Point* points = binding.rows(batch);
+        for (size_t index = 0; index < rows; ++index) sum += points[index].weight;
+        sink += static_cast<int64_t>(sum);
+    }));
+    std::vector<Native_Point> native(rows);
+    for (size_t index = 0; index < rows; ++index) native[index].weight = index * 0.5;
+    report("scan weight of 1M rows: std::vector", measure(10, [&](size_t) {
+        double sum = 0.0;
+        for (size_t index = 0; index < rows; ++index) sum += native[index].weight;
+        sink += static_cast<int64_t>(sum);
+    }));
+}
+
+void benchmark_try_parse() {
+    Struct_Type reading({
+        Int_32("id"),
+        Float_64("value")
+    }, "reading");
+    reading.init();
+    Type& id = reading["id"];
+    Type& value = reading["value"];
+
+    // Every 20th input is malformed in the dirty feed, i.e. 5%
+    const size_t count = 100000;
+    std::vector<std::string> clean, dirty;
+    for (size_t index = 0; index < count; ++index) {
+        clean.push_back(std::to_string(index * 7));
+        dirty.push_back(index % 20 == 0 ? std::to_string(index) + "x" : clean.back());
+    }
+    const std::pair<const char*, std::vector<std::string>*> feeds[] = { { "clean", &clean }, { "dirty 5%", &dirty } };
+    for (const std::pair<const char*, std::vector<std::string>*>& feed : feeds) {
+        const std::vector<std::string>& inputs = *feed.second;
+        size_t failures = 0;
+        report(std::string("Int_32 ") + feed.first + ": set(std::string) with catch", measure(count, [&](size_t index) {
+            try {
+                id.set(inputs[index]);
+            } catch (const std::exception&) {
+                ++failures;
+            }
+            sink += *id.get_Int_32();
+        }));
+        report(std::string("Int_32 ") + feed.first + ": try_parse", measure(count, [&](size_t index) {
+            failures += id.try_parse(inputs[index]) != Status::Ok;
+            int32_t result = 0;
+            id.try_get(result);
+            sink += result;
+        }));
+        report(std::string("Float_64 ") + feed.first + ": set(std::string) with catch", measure(count, [&](size_t index) {
+            try {
+                value.set(inputs[index]);
+            } catch (const std::exception&) {
+                ++failures;
+            }
+            sink += static_cast<int64_t>(*value.get_Float_64());
+        }));
+        report(std::string("Float_64 ") + feed.first + ": try_parse", measure(count, [&](size_t index) {
+            failures += value.try_parse(inputs[index]) != Status::Ok;
+            sink += static_cast<int64_t>(*value.get_Float_64());
+        }));
+        sink += failures;
+    }
+
+    const size_t iterations = 1000000;
+    size_t mismatches = 0;
+    report("set(int32_t) into Float_64 with catch", measure(iterations / 10, [&](size_t index) {
+        try {
+            value.set(static_cast<int32_t>(index));
+        } catch (const std::exception&) {
+            ++mismatches;
+        }
+    }));
+    report("try_set(int32_t) into Float_64", measure(iterations, [&](size_t index) {
+        mismatches += value.try_set(static_cast<int32_t>(index)) != Status::Ok;
+    }));
+    sink += mismatches;
+}
+
+void benchmark_cursor_scaling() {
+    Struct_Type trade({
+        Int_64("id"),
+        Float_64("price"),
+        Int_32("quantity")
+    }, "trade");
+    const size_t rows = 1 << 22;
+    Record_Batch batch(trade.freeze(), rows);
+    batch.resize(rows);
+    Field_Path id = trade.compile_path("id"), price = trade.compile_path("price");
+
+    size_t max_threads = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+    std::vector<size_t> counts;
+    for (size_t threads = 1; threads < max_threads; threads *= 2) counts.push_back(threads);
+    counts.push_back(max_threads);
+    double single = 0;
+    for (size_t threads : counts) {
+        std::vector<double> totals(threads * 8);
+        auto scan = [&](size_t) {
+            std::vector<std::thread> workers;
+            for (size_t part = 0; part < threads; ++part) {
+                workers.emplace_back([&, part]() {
+                    double total = 0;
+                    for (Cursor cursor = Cursor(batch).partition(part, threads); cursor.valid(); cursor.next()) {
+                        *id.get_Int_64(cursor.get_data()) += 1;
+                        total += *price.get_Float_64(cursor.get_data());
+                    }
+                    // Padded apart to avoid false sharing
+                    totals[part * 8] = total;
+                });
+            }
+            for (std::thread& worker : workers) worker.join();
+        };
+        double nanoseconds = measure(10, scan) / rows;
+        if (threads == 1) single = nanoseconds;
+        std::string name = "update and scan with " + std::to_string(threads) + " threads";
+        report(name + " per row", nanoseconds);
+        report_value(name + " speedup", single / nanoseconds, "x");
+        sink += static_cast<int64_t>(totals[0]);
+    }
+}
+
+void benchmark_predicate() {
+    Struct_Type item({
+        Int_64("id"),
+        Float_64("price"),
+        Boolean("active"),
+        Char("region")
+    }, "item", Layout_Policy::Aligned);
+    const size_t rows = 1 << 22;
+    Record_Batch batch(&item, rows);
+    batch.resize(rows);
+    Field_Path price = item.compile_path("price"), active = item.compile_path("active"), region = item.compile_path("region");
+    uint64_t state = 1;
+    for (size_t row = 0; row < rows; ++row) {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        // Uniform in [0, 100), so that `price < s` selects s% of rows
+        *price.get_Float_64(batch[row].get_data()) = (state >> 11) * (100.0 / 9007199254740992.0);
+        *active.get_Boolean(batch[row].get_data()) = true;
+        *region.get_Char(batch[row].get_data()) = "NESW"[row % 4];
+    }
+    Column_Batch columns(batch);
+    size_t threads = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+
+    const int selectivities[] = { 1, 10, 50, 90, 99 };
+    for (int selectivity : selectivities) {
+        std::string suffix = " at " + std::to_string(selectivity) + "% per row";
+        Predicate predicate(&item, "price < " + std::to_string(selectivity) + " && active == true && region != 'Z'");
+        report("ad hoc operator[] loop" + suffix, measure(1, [&](size_t) {
+            size_t selected = 0;
+            for (size_t row = 0; row < rows; ++row) {
+                Type_View view = batch[row];
+                selected += *view["price"].get_Float_64() < selectivity && *view["active"].get_Boolean() == true && *view["region"].get_Char() != 'Z';
+            }
+            sink += selected;
+        }) / rows);
+        report("select rows with 1 thread" + suffix, measure(5, [&](size_t) {
+            sink += predicate.select(batch, 1).size();
+        }) / rows);
+        report("select columns with 1 thread" + suffix, measure(5, [&](size_t) {
+            sink += predicate.select(columns, 1).size();
+        }) / rows);
+        report("select columns on " + std::to_string(threads) + " cores" + suffix, measure(5, [&](size_t) {
+            sink += predicate.select(columns, threads).size();
+        }) / rows);
+        report("bitmap of columns on " + std::to_string(threads) + " cores" + suffix, measure(5, [&](size_t) {
+            sink += predicate.bitmap(columns, threads).size();
+        }) / rows);
+    }
+}
+
+/* Migrate a row by walking keys and copying values through text, which is what `Copy_Plan` replaces */
+void migrate_by_string(Type& src, Type& dst, const std::map<std::string, std::string>& renames) {
+    std::vector<std::string> keys = src.get_Keys();
+    for (const std::string& key : dst.get_Keys()) {
+        std::map<std::string, std::string>::const_iterator rename = renames.find(key);
+        const std::string& origin = rename == renames.end() ? key : rename->second;
+        if (std::find(keys.begin(), keys.end(), origin) == keys.end()) continue;
+        Type& target = dst.get(key);
+        if (target.get_Type_Class() == Type_Class::Struct) migrate_by_string(src.get(origin), target, renames);
+        else target.set(src.get(origin).string());
+    }
+}
+
+void benchmark_copy_plan() {
+    const size_t rows = 1000000;
+    Struct_Type point({
+        Int_32("x"),
+        Int_32("y")
+    }, "point");
+    Struct_Type version_1({
+        Int_32("id"),
+        Int_16("quantity"),
+        Float_32("price"),
+        Struct_Clone(point, "point"),
+        Char("grade")
+    }, "order");
+    Struct_Type widened({
+        Int_64("id"),
+        Struct_Clone(point, "position"),
+        Int_32("quantity"),
+        Float_64("price"),
+        Char("grade"),
+        Boolean("paid")
+    }, "order", Layout_Policy::Aligned);
+    Struct_Type appended({
+        Int_32("id"),
+        Int_16("quantity"),
+        Float_32("price"),
+        Struct_Clone(point, "point"),
+        Char("grade"),
+        Int_64("total")
+    }, "order");
+    const std::map<std::string, std::string> renames = { { "position", "point" } };
+    Record_Batch source(&version_1, rows);
+    for (size_t index = 0; index < rows; ++index) {
+        Type_View row = source.append();
+        row["id"].set(static_cast<int32_t>(index));
+        row["quantity"].set(static_cast<int16_t>(index % 1000));
+        row["price"].set(static_cast<float>(index % 10000) / 4);
+        row["point"]["x"].set(static_cast<int32_t>(index * 3));
+        row["grade"].set("ABC"[index % 3]);
+    }
+    Record_Batch target(&widened, rows);
+    Record_Batch target_appended(&appended, rows);
+    Record_Batch target_identity(&version_1, rows);
+    // Touch every page of the targets, so that page faults are not measured
+    target_appended.resize(rows);
+    target_identity.resize(rows);
+
+    double megabytes = (source.get_Stride() + target.get_Stride()) * rows / 1e6;
+    double nanoseconds = measure(1, [&](size_t) {
+        std::unique_ptr<Type> old_row(version_1.clone()), new_row(widened.clone());
+        target.resize(rows);
+        for (size_t index = 0; index < rows; ++index) {
+            source.hold(*old_row, index);
+            target.hold(*new_row, index);
+            migrate_by_string(*old_row, *new_row, renames);
+        }
+        sink += *target[rows / 2]["id"].get_Int_64();
+    });
+    report("1M rows widened: string() and set(std::string)", nanoseconds);
+    report_value("1M rows widened: string() and set(std::string)", megabytes / (nanoseconds / 1e9), "MB/s");
+
+    Copy_Plan plan(&version_1, &widened, renames);
+    nanoseconds = measure(5, [&](size_t) {
+        plan.apply(source, target);
+        sink += *target[rows / 2]["id"].get_Int_64();
+    });
+    report("1M rows widened: Copy_Plan with " + std::to_string(plan.get_Steps().size()) + " steps", nanoseconds);
+    report_value("1M rows widened: Copy_Plan with " + std::to_string(plan.get_Steps().size()) + " steps", megabytes / (nanoseconds / 1e9), "MB/s");
+
+    Copy_Plan append_plan(&version_1, &appended);
+    megabytes = (source.get_Stride() + target_appended.get_Stride()) * rows / 1e6;
+    nanoseconds = measure(5, [&](size_t) {
+        append_plan.apply(source, target_appended);
+        sink += *target_appended[rows / 2]["id"].get_Int_32();
+    });
+    report_value("1M rows appended: Copy_Plan with " + std::to_string(append_plan.get_Steps().size()) + " steps", megabytes / (nanoseconds / 1e9), "MB/s");
+
+    Copy_Plan identity_plan(&version_1, &version_1);
+    megabytes = 2 * source.get_Stride() * rows / 1e6;
+    nanoseconds = measure(5, [&](size_t) {
+        identity_plan.apply(source, target_identity);
+        sink += *target_identity[rows / 2]["id"].get_Int_32();
+    });
+    report_value("1M rows identity: Copy_Plan", megabytes / (nanoseconds / 1e9), "MB/s");
+
+    std::vector<char> buffer(source.get_Stride() * rows);
+    nanoseconds = measure(5, [&](size_t) {
+        memcpy(buffer.data(), source.get_data(), buffer.size());
+        sink += buffer[buffer.size() / 2];
+    });
+    report_value("1M rows identity: memcpy", megabytes / (nanoseconds / 1e9), "MB/s");
+}
+
+/* Hash of a row combined field by field through getters, which is what `Record_Hasher` replaces */
+size_t hash_by_getters(Type& row) {
+    size_t hash = std::hash<int64_t>()(*row["customer"].get_Int_64());
+    hash = hash * 31 + std::hash<int32_t>()(*row["day"].get_Int_32());
+    hash = hash * 31 + std::hash<double>()(*row["amount"].get_Float_64());
+    return hash;
+}
+bool equal_by_getters(Type& a, Type& b) {
+    return *a["customer"].get_Int_64() == *b["customer"].get_Int_64() && *a["day"].get_Int_32() == *b["day"].get_Int_32() && *a["amount"].get_Float_64() == *b["amount"].get_Float_64();
+}
+
+void benchmark_hash() {
+    const size_t rows = 1000000;
+    const size_t customers = 100000;
+    Struct_Type order({
+        Int_64("customer"),
+        Int_32("day"),
+        Float_64("amount"),
+        Char("status")
+    }, "order", Layout_Policy::Aligned);
+    Struct_Type customer({
+        Int_64("id"),
+        Int_32("region")
+    }, "customer", Layout_Policy::Aligned);
+    Record_Batch orders(&order, rows);
+    uint64_t state = 1;
+    for (size_t index = 0; index < rows; ++index) {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        Type_View row = orders.append();
+        row["customer"].set(static_cast<int64_t>((state >> 33) % customers));
+        row["day"].set(static_cast<int32_t>((state >> 20) % 30));
+        row["amount"].set(static_cast<double>((state >> 40) % 100));
+    }
+    Record_Batch customer_rows(&customer, customers);
+    for (size_t index = 0; index < customers; ++index) customer_rows.append()["id"].set(static_cast<int64_t>(index * 2));
+
+    Record_Hasher hasher(&order, { "customer", "day", "amount" });
+    report("1M rows hash: getters", measure(1, [&](size_t) {
+        std::unique_ptr<Type> row(order.clone());
+        size_t hash = 0;
+        for (size_t index = 0; index < rows; ++index) {
+            orders.hold(*row, index);
+            hash ^= hash_by_getters(*row);
+        }
+        sink += hash;
+    }) / rows);
+    report("1M rows hash: Record_Hasher", measure(5, [&](size_t) {
+        uint64_t hash = 0;
+        const char* data = static_cast<const char*>(orders.get_data());
+        for (size_t index = 0; index < rows; ++index) hash ^= hasher.hash(data + orders.get_Stride() * index);
+        sink += hash;
+    }) / rows);
+
+    report("1M rows distinct: std::unordered_set with getters", measure(1, [&](size_t) {
+        std::vector<std::unique_ptr<Type>> views;
+        for (size_t index = 0; index < rows; ++index) {
+            views.emplace_back(order.clone());
+            orders.hold(*views.back(), index);
+        }
+        auto hash = [](Type* row) { return hash_by_getters(*row); };
+        auto equal = [](Type* a, Type* b) { return equal_by_getters(*a, *b); };
+        std::unordered_set<Type*, decltype(hash), decltype(equal)> seen(rows, hash, equal);
+        for (const std::unique_ptr<Type>& view : views) seen.insert(view.get());
+        sink += seen.size();
+    }) / rows);
+    report("1M rows distinct: Record_Hash_Table", measure(5, [&](size_t) {
+        sink += distinct(orders, { "customer", "day", "amount" }).size();
+    }) / rows);
+    report("1M rows distinct of 1 key: Record_Hash_Table", measure(5, [&](size_t) {
+        sink += distinct(orders, { "customer" }).size();
+    }) / rows);
+    report("1M rows hash join with 100K rows: hash_join", measure(5, [&](size_t) {
+        sink += hash_join(customer_rows, { "id" }, orders, { "customer" }).size();
+    }) / rows);
+}
+
+void benchmark_sort() {
+    const size_t rows = 1000000;
+    Struct_Type trade({
+        Int_64("id"),
+        Float_64("price"),
+        Unsigned_Int_32("volume"),
+        Char("side")
+    }, "trade", Layout_Policy::Aligned);
+    Record_Batch batch(&trade, rows);
+    uint64_t state = 1;
+    for (size_t index = 0; index < rows; ++index) {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        Type_View row = batch.append();
+        row["id"].set(static_cast<int64_t>(state));
+        row["price"].set(static_cast<double>(state >> 40) / 100 - 50000);
+        row["volume"].set(static_cast<uint32_t>(state >> 54));
+    }
+    size_t threads = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+
+    report("1M rows by Int_64: std::sort with operator[]", measure(1, [&](size_t) {
+        std::vector<size_t> permutation(rows);
+        for (size_t index = 0; index < rows; ++index) permutation[index] = index;
+        std::sort(permutation.begin(), permutation.end(), [&batch](size_t a, size_t b) {
+            return *batch[a]["id"].get_Int_64() < *batch[b]["id"].get_Int_64();
+        });
+        sink += permutation[rows / 2];
+    }) / rows);
+    Record_Sorter by_id(&trade, { "id" });
+    report("1M rows by Int_64: Record_Sorter with 1 thread", measure(3, [&](size_t) {
+        sink += by_id.order(batch, 1)[rows / 2];
+    }) / rows);
+
+    report("1M rows by Unsigned_Int_32 and Float_64: std::stable_sort with operator[]", measure(1, [&](size_t) {
+        std::vector<size_t> permutation(rows);
+        for (size_t index = 0; index < rows; ++index) permutation[index] = index;
+        std::stable_sort(permutation.begin(), permutation.end(), [&batch](size_t a, size_t b) {
+            Type_View x = batch[a], y = batch[b];
+            if (*x["volume"].get_Unsigned_Int_32() != *y["volume"].get_Unsigned_Int_32()) return *x["volume"].get_Unsigned_Int_32() < *y["volume"].get_Unsigned_Int_32();
+            return *x["price"].get_Float_64() > *y["price"].get_Float_64();
+        });
+        sink += permutation[rows / 2];
+    }) / rows);
+    Record_Sorter by_volume(&trade, { "volume", { "price", Sort_Order::Descending } });
+    report("1M rows by Unsigned_Int_32 and Float_64: Record_Sorter with 1 thread", measure(3, [&](size_t) {
+        sink += by_volume.order(batch, 1)[rows / 2];
+    }) / rows);
+    report("1M rows by Unsigned_Int_32 and Float_64: Record_Sorter on " + std::to_string(threads) + " cores", measure(3, [&](size_t) {
+        sink += by_volume.order(batch, threads)[rows / 2];
+    }) / rows);
+    report("1M rows by Int_64: sort rows in place on " + std::to_string(threads) + " cores", measure(3, [&](size_t) {
+        by_id.sort(batch, threads);
+        sink += *batch[rows / 2]["id"].get_Int_64();
+    }) / rows);
+}
+
+void benchmark_group_by() {
+    const size_t rows = 1000000;
+    Struct_Type sale({
+        Char("region"),
+        Int_32("product"),
+        Float_64("amount"),
+        Int_64("ts")
+    }, "sale", Layout_Policy::Aligned);
+    Record_Batch batch(&sale, rows);
+    size_t threads = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+    const size_t cardinalities[] = { 1000, 100000 };
+    for (size_t products : cardinalities) {
+        batch.clear();
+        uint64_t state = 1;
+        for (size_t index = 0; index < rows; ++index) {
+            state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+            Type_View row = batch.append();
+            row["region"].set("NSEW"[(state >> 60) & 3]);
+            row["product"].set(static_cast<int32_t>((state >> 33) % (products / 4)));
+            row["amount"].set(static_cast<double>((state >> 20) % 100));
+            row["ts"].set(static_cast<int64_t>(index));
+        }
+        std::string suffix = " into " + std::to_string(products) + " groups";
+        report("1M rows std::unordered_map with operator[]" + suffix, measure(1, [&](size_t) {
+            struct Totals {
+                double amount;
+                uint64_t count;
+                int64_t ts;
+            };
+            std::unordered_map<int64_t, Totals> groups;
+            for (size_t index = 0; index < rows; ++index) {
+                Type_View row = batch[index];
+                int64_t key = static_cast<int64_t>(*row["region"].get_Char()) << 32 | static_cast<uint32_t>(*row["product"].get_Int_32());
+                std::pair<std::unordered_map<int64_t, Totals>::iterator, bool> inserted = groups.insert(std::make_pair(key, Totals{ 0.0, 0, *row["ts"].get_Int_64() }));
+                Totals& totals = inserted.first->second;
+                totals.amount += *row["amount"].get_Float_64();
+                ++totals.count;
+                totals.ts = std::max(totals.ts, *row["ts"].get_Int_64());
+            }
+            sink += groups.size();
+        }) / rows);
+        Group_By group_by(&sale, { "region", "product" }, { { Reduction::Sum, "amount" }, { Reduction::Count }, { Reduction::Max, "ts" } });
+        report("1M rows Group_By with 1 thread" + suffix, measure(5, [&](size_t) {
+            sink += group_by.run(batch, 1)->get_Size();
+        }) / rows);
+        report("1M rows Group_By on " + std::to_string(threads) + " cores" + suffix, measure(5, [&](size_t) {
+            sink += group_by.run(batch, threads)->get_Size();
+        }) / rows);
+    }
+}
+
+void benchmark_string() {
+    const size_t rows = 1000000;
+    Struct_Type person({
+        Int_64("id"),
+        String("name")
+    }, "person", Layout_Policy::Aligned);
+    // Half of the names fit inline in the slot, and the other half live in the arena
+    std::vector<std::string> names(rows);
+    uint64_t state = 1;
+    for (size_t index = 0; index < rows; ++index) {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        names[index] = std::string(index % 2 == 0 ? 4 + (state >> 61) : 16 + (state >> 59), static_cast<char>('a' + index % 26));
+    }
+    size_t total = 0;
+    for (const std::string& name : names) total += name.length();
+
+    report("1M rows std::vector<std::string> push_back", measure(5, [&](size_t) {
+        std::vector<std::string> copies;
+        copies.reserve(rows);
+        for (size_t index = 0; index < rows; ++index) copies.push_back(names[index]);
+        sink += copies.size();
+    }) / rows);
+    Record_Batch batch(&person, rows);
+    report("1M rows Record_Batch append and set String", measure(5, [&](size_t) {
+        batch.clear();
+        for (size_t index = 0; index < rows; ++index) {
+            Type_View row = batch.append();
+            row["id"].set(static_cast<int64_t>(index));
+            row["name"].set_bytes(names[index].data(), names[index].length());
+        }
+        sink += batch.get_Size();
+    }) / rows);
+    Field_Path name_path = person.compile_path("name");
+    report("1M rows read String by Field_Path", measure(20, [&](size_t) {
+        size_t length = 0;
+        const char* data = static_cast<const char*>(batch.get_data());
+        String_Ref value = { "", 0 };
+        for (size_t index = 0; index < rows; ++index) {
+            load_string(data + batch.get_Stride() * index + name_path.get_Offset(), &batch.get_Arena(), value);
+            length += value.length;
+        }
+        sink += length == total;
+    }) / rows);
+    std::string text;
+    report("1M rows Save and Load_Batch with arena", measure(5, [&](size_t) {
+        std::stringstream stream;
+        Save(stream, batch);
+        sink += Load_Batch(stream)->get_Arena().get_Size();
+    }) / rows);
+    report("1M rows Text_Writer of String", measure(5, [&](size_t) {
+        Text_Writer writer(&person);
+        writer.write(batch);
+        text = writer.get_Text();
+        sink += text.length();
+    }) / rows);
+    Record_Batch parsed(&person, rows);
+    Text_Loader loader(&person);
+    report("1M rows Text_Loader of String", measure(5, [&](size_t) {
+        parsed.clear();
+        sink += loader.load(text, parsed);
+    }) / rows);
+}
+
+/* Small, wide and deep Struct shared by the core suite */
+struct Core_Schemas {
+    std::unique_ptr<Type> small;
+    std::unique_ptr<Type> wide;
+    std::unique_ptr<Type> deep;
+};
+
+Core_Schemas make_core_schemas() {
+    Core_Schemas schemas;
+    schemas.small.reset(new Struct_Type({
+        Int_32("x"),
+        Int_32("y"),
+        Float_64("weight")
+    }, "small"));
+    std::vector<std::unique_ptr<Primitive_Type>> properties;
+    std::vector<Type*> types;
+    for (size_t index = 0; index < 1000; ++index) {
+        properties.push_back(_Int_32("field_" + std::to_string(index)));
+        types.push_back(properties.back().get());
+    }
+    schemas.wide.reset(new Struct_Type(types, "wide"));
+    schemas.deep.reset(Int_32("leaf")->clone());
+    for (size_t depth = 0; depth < 64; ++depth) schemas.deep.reset(new Struct_Type({ schemas.deep.get(), Int_8("tag") }, "level_" + std::to_string(depth)));
+    return schemas;
+}
+
+void benchmark_core() {
+    Core_Schemas schemas = make_core_schemas();
+    const std::pair<const char*, Type*> shapes[] = { { "small", schemas.small.get() }, { "wide", schemas.wide.get() }, { "deep", schemas.deep.get() } };
+
+    const size_t iterations = 100000;
+    for (const std::pair<const char*, Type*>& shape : shapes) {
+        std::unique_ptr<Type> instance(shape.second->clone());
+        std::string name = std::string("init and release: ") + shape.first;
+        size_t allocations = allocation_count;
+        report(name, measure(iterations, [&](size_t) {
+            instance->init();
+            sink += *static_cast<char*>(instance->get_data());
+            instance->release();
+        }));
+        report_allocations(name, allocation_count - allocations, iterations);
+    }
+
+    const size_t accesses = 1000000;
+    Type& small = *schemas.small;
+    small.init();
+    report("struct key access: small", measure(accesses, [&](size_t index) {
+        *small["y"].get_Int_32() += static_cast<int32_t>(index);
+        sink += *small["y"].get_Int_32();
+    }));
+    Type& wide = *schemas.wide;
+    wide.init();
+    std::vector<std::string> keys = wide.get_Keys();
+    report("struct key access: wide", measure(accesses, [&](size_t index) {
+        sink += *wide[keys[index % keys.size()]].get_Int_32();
+    }));
+    Type& deep = *schemas.deep;
+    deep.init();
+    report("struct key access: deep (8 levels)", measure(accesses, [&](size_t) {
+        Type* level = &deep;
+        for (size_t depth = 63; depth > 55; --depth) level = &(*level)["level_" + std::to_string(depth - 1)];
+        sink += *(*level)["tag"].get_Int_8();
+    }));
+
+    std::unique_ptr<Array_Type> arrays[] = {
+        std::unique_ptr<Array_Type>(Array(512, Int_32(), "vector")->clone()),
+        std::unique_ptr<Array_Type>(Matrix(32, 16, Int_32(), "matrix")->clone()),
+        std::unique_ptr<Array_Type>(Tensor(8, 8, 8, Int_32(), "tensor")->clone())
+    };
+    for (size_t depth = 1; depth <= 3; ++depth) {
+        Array_Type& array = *arrays[depth - 1];
+        array.init();
+        std::string name = "array element access: depth " + std::to_string(depth);
+        size_t allocations = allocation_count;
+        report(name + " operator[]", measure(accesses, [&](size_t index) {
+            std::unique_ptr<Type> element = array[index % array.get_Size()];
+            for (size_t level = 1; level < depth; ++level) element = element->at(index % element->get_Size());
+            sink += *element->get_Int_32();
+        }));
+        report_allocations(name + " operator[]", allocation_count - allocations, accesses);
+        Type_View view = array.view();
+        report(name + " Type_View", measure(accesses, [&](size_t index) {
+            Type_View element = view[index % view.get_Size()];
+            for (size_t level = 1; level < depth; ++level) element = element[index % element.get_Size()];
+            sink += *element.get_Int_32();
+        }));
+    }
+
+    const std::pair<Primitive_Data_Types, const char*> values[] = {
+        { Primitive_Data_Types::Int_32, "-1234567" },
+        { Primitive_Data_Types::Unsigned_Int_64, "18446744073709551615" },
+        { Primitive_Data_Types::Float_64, "3.14159265358979" },
+        { Primitive_Data_Types::Boolean, "true" },
+        { Primitive_Data_Types::Char, "c" }
+    };
+    for (const std::pair<Primitive_Data_Types, const char*>& value : values) {
+        Primitive_Type primitive(value.first, "value");
+        primitive.init();
+        std::string text = value.second;
+        report("set(std::string): " + get_string_from_type(value.first), measure(accesses, [&](size_t) {
+            primitive.set(text);
+            sink += *static_cast<char*>(primitive.get_data());
+        }));
+        report("string(): " + get_string_from_type(value.first), measure(accesses, [&](size_t) {
+            sink += static_cast<int64_t>(primitive.string().length());
+        }));
+    }
+
+    for (const std::pair<const char*, Type*>& shape : shapes) {
+        std::string descriptor = Serialize(shape.second);
+        report(std::string("Serialize: ") + shape.first, measure(1000, [&](size_t) {
+            sink += static_cast<int64_t>(Serialize(shape.second).length());
+        }));
+        report(std::string("Deserialize: ") + shape.first, measure(1000, [&](size_t) {
+            sink += static_cast<int64_t>(Deserialize(descriptor)->size_of());
+        }));
+    }
+}
+
+/* Suites in the order they run, which could be selected by `--suite=` */
+const std::pair<const char*, void (*)()> suites[] = {
+    { "core", benchmark_core },
+    { "field_path", benchmark_field_path },
+    { "array_view", benchmark_array_view },
+    { "record_batch", benchmark_record_batch },
+    { "column_batch", benchmark_column_batch },
+    { "reduce", benchmark_reduce },
+    { "binary", benchmark_binary },
+    { "mapped_file", benchmark_mapped_file },
+    { "text_loader", benchmark_text_loader },
+    { "text_writer", benchmark_text_writer },
+    { "layout", benchmark_layout },
+    { "schema", benchmark_schema },
+    { "deserialize", benchmark_deserialize },
+    { "binary_descriptor", benchmark_binary_descriptor },
+    { "key_index", benchmark_key_index },
+    { "native_binding", benchmark_native_binding },
+    { "try_parse", benchmark_try_parse },
+    { "cursor_scaling", benchmark_cursor_scaling },
+    { "predicate", benchmark_predicate },
+    { "copy_plan", benchmark_copy_plan },
+    { "hash", benchmark_hash },
+    { "sort", benchmark_sort },
+    { "group_by", benchmark_group_by },
+    { "string", benchmark_string }
+};
+
+void usage() {
+    fprintf(stderr, "Usage: benchmark [--format=text|csv|json] [--suite=name,...] [--list]\n");
+}
+
+/**
+ * Usage: benchmark [--format=text|csv|json] [--suite=name,...] [--list]
+ * Every suite runs by default.
+ */
+int main(int argc, char* argv[]) {
+    std::vector<std::string> selected;
+    for (int index = 1; index < argc; ++index) {
+        std::string argument = argv[index];
+        if (argument == "--format=text") output_format = Output_Format::Text;
+        else if (argument == "--format=csv") output_format = Output_Format::CSV;
+        else if (argument == "--format=json") output_format = Output_Format::JSON;
+        else if (argument.compare(0, 8, "--suite=") == 0) {
+            std::stringstream names(argument.substr(8));
+            std::string name;
+            while (std::getline(names, name, ',')) selected.push_back(name);
+        } else if (argument == "--list") {
+            for (const std::pair<const char*, void (*)()>& suite : suites) printf("%s\n", suite.first);
+            return 0;
+        } else {
+            usage();
+            return 1;
+        }
+    }
+    for (const std::string& name : selected) {
+        if (std::find_if(std::begin(suites), std::end(suites), [&name](const std::pair<const char*, void (*)()>& suite) { return name == suite.first; }) == std::end(suites)) {
+            fprintf(stderr, "Unknown suite '%s'\n", name.c_str());
+            return 1;
+        }
+    }
+
+    if (output_format == Output_Format::CSV) printf("suite,name,value,unit\n");
+    if (output_format == Output_Format::JSON) printf("{\n  \"library\": \"dynamic_struct\",\n  \"results\": [");
+    for (const std::pair<const char*, void (*)()>& suite : suites) {
+        if (!selected.empty() && std::find(selected.begin(), selected.end(), suite.first) == selected.end()) continue;
+        current_suite = suite.first;
+        if (output_format == Output_Format::Text) printf("[%s]\n", suite.first);
+        suite.second();
+    }
+    if (output_format == Output_Format::JSON) printf("\n  ]\n}\n");
+    return 0;
+}
@@ -12,12 +12,57 @@
 #include <vector>
 #include <string>
 #include <cstring>
+#include <cstdint>
+#include <cstddef>
+#include <utility>
 #include <iostream>
 #include <memory>
 #include <map>
 #include <stack>
 #include <functional>
 #include <algorithm>
+#include <limits>
+#include <type_traits>
+#include <stdexcept>
+#include <cerrno>
+#include <clocale>
+#include <cmath>
+#include <cstdlib>
+#include <cctype>
+#include <cstdio>
+#include <mutex>
+#include <atomic>
+#include <unordered_map>
+#include <thread>
+#include <exception>
+
+/**
+ * SIMD kernels are compiled for x86 with per-function target attributes,
+ * so that they are selected at run-time without any compiler flag.
+ */
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    #define DYNAMIC_STRUCT_X86
+    #define DYNAMIC_STRUCT_TARGET(instruction_set) __attribute__((target(instruction_set)))
+    #include <immintrin.h>
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    #define DYNAMIC_STRUCT_X86
+    #define DYNAMIC_STRUCT_TARGET(instruction_set)
+    #include <immintrin.h>
+    #include <intrin.h>
+#endif
+
+/* Memory-mapped files are supported through Win32 or POSIX */
+#if defined(_WIN32)
+    #ifndef NOMINMAX
+        #define NOMINMAX
+    #endif
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
 
 namespace dynamic_struct {
     enum class Primitive_Data_Types {
@@ -36,7 +81,11 @@ namespace dynamic_struct {
         Boolean,
 
         Float_32,
-        Float_64
+        Float_64,
+
+        /* Variable-length text and bytes, kept in a slot of `STRING_SLOT_BYTES` bytes or in an arena */
+        String,
+        Blob
     };
 
     inline Primitive_Data_Types get_type_from_string(std::string type_name) {
@@ -52,6 +101,8 @@ namespace dynamic_struct {
         else if (type_name == "Boolean") return Primitive_Data_Types::Boolean;
         else if (type_name == "Float_32") return Primitive_Data_Types::Float_32;
         else if (type_name == "Float_64") return Primitive_Data_Types::Float_64;
+        else if (type_name == "String") return Primitive_Data_Types::String;
+        else if (type_name == "Blob") return Primitive_Data_Types::Blob;
         else {
             throw std::invalid_argument(("Cannot parse type name '" + type_name + "'").c_str());
         }
@@ -70,12 +121,275 @@ namespace dynamic_struct {
         else if (type == Primitive_Data_Types::Boolean) return "Boolean";
         else if (type == Primitive_Data_Types::Float_32) return "Float_32";
         else if (type == Primitive_Data_Types::Float_64) return "Float_64";
+        else if (type == Primitive_Data_Types::String) return "String";
+        else if (type == Primitive_Data_Types::Blob) return "Blob";
         else {
             throw std::invalid_argument("Cannot parse type");
         }
     }
 
-    const std::string FORBIDDEN_VARIABLE_NAME_CHARS = "()[]{},";
+    /**
+     * Layout of properties of Struct
+     *  Packed: back to back without padding, which is compatible with files written before
+     *  Aligned: in the order of keys, each at a multiple of its alignment
+     *  Compact: in the descending order of alignment, which never needs padding between properties
+     * Keys keep their order under every policy, only offsets differ.
+     */
+    enum class Layout_Policy {
+        Packed,
+        Aligned,
+        Compact
+    };
+
+    inline Layout_Policy get_layout_policy_from_string(std::string policy_name) {
+        if (policy_name == "packed") return Layout_Policy::Packed;
+        else if (policy_name == "aligned") return Layout_Policy::Aligned;
+        else if (policy_name == "compact") return Layout_Policy::Compact;
+        else {
+            throw std::invalid_argument(("Cannot parse layout policy '" + policy_name + "'").c_str());
+        }
+    }
+
+    inline std::string get_string_from_layout_policy(Layout_Policy policy) {
+        if (policy == Layout_Policy::Packed) return "packed";
+        else if (policy == Layout_Policy::Aligned) return "aligned";
+        else if (policy == Layout_Policy::Compact) return "compact";
+        else {
+            throw std::invalid_argument("Cannot parse layout policy");
+        }
+    }
+
+    const std::string FORBIDDEN_VARIABLE_NAME_CHARS = "()[]{},:";
+
+    /**
+     * Bytes of the slot of String and Blob inside data, which starts with the length as `uint32_t`
+     * Values of at most `STRING_INLINE_BYTES` bytes follow the length inside the slot, padded with zero,
+     * while longer values are followed by their first 4 bytes and the `uint64_t` offset of the value in a `String_Arena`.
+     * Zero-filled slots are empty values.
+     */
+    const size_t STRING_SLOT_BYTES = 16;
+    const size_t STRING_INLINE_BYTES = 12;
+
+    /* Whether values of `type` are kept in slots referring to an arena */
+    inline bool is_variable_length(Primitive_Data_Types type) {
+        return type == Primitive_Data_Types::String || type == Primitive_Data_Types::Blob;
+    }
+
+    /**
+     * Hot-path counters of `Type`, which are only compiled with `DYNAMIC_STRUCT_INSTRUMENTATION` defined before including this header
+     * Events are counted into tables of the current thread, keyed by the name of the top-level type that the event happens in.
+     * Without the definition, `DYNAMIC_STRUCT_COUNT` expands to nothing and snapshots are always empty.
+     */
+    enum class Counter {
+        Allocations,
+        Allocated_Bytes,
+        Clones,
+        Key_Lookups,
+        Element_Views,
+        Parses,
+        Exceptions
+    };
+    const size_t COUNTER_COUNT = 7;
+
+    inline std::string get_string_from_counter(Counter counter) {
+        switch (counter) {
+        case Counter::Allocations: return "allocations";
+        case Counter::Allocated_Bytes: return "allocated_bytes";
+        case Counter::Clones: return "clones";
+        case Counter::Key_Lookups: return "key_lookups";
+        case Counter::Element_Views: return "element_views";
+        case Counter::Parses: return "parses";
+        case Counter::Exceptions: return "exceptions";
+        }
+        throw std::invalid_argument("Cannot parse counter");
+    }
+
+    /* Counters of one top-level type, summed over threads */
+    struct Instrumentation_Counters {
+        uint64_t values[COUNTER_COUNT] = {};
+
+        uint64_t operator[](Counter counter) const { return values[static_cast<size_t>(counter)]; }
+        uint64_t& operator[](Counter counter) { return values[static_cast<size_t>(counter)]; }
+    };
+    /* Counters keyed by the name of top-level type */
+    typedef std::map<std::string, Instrumentation_Counters> Instrumentation_Snapshot;
+
+#ifdef DYNAMIC_STRUCT_INSTRUMENTATION
+    struct _Thread_Counters;
+    struct _Instrumentation_Registry {
+        std::mutex mutex;
+        std::vector<_Thread_Counters*> threads;
+        /* Counters of exited threads */
+        Instrumentation_Snapshot retired;
+    };
+    inline _Instrumentation_Registry& _instrumentation_registry() {
+        // Never destroyed, since threads might exit during static destruction
+        static _Instrumentation_Registry* registry = new _Instrumentation_Registry();
+        return *registry;
+    }
+
+    /**
+     * Tables of one thread, which are only inserted into by the owner thread under the registry mutex,
+     * so that the owner looks up without locking and other threads only read atomics under the mutex.
+     */
+    struct _Thread_Counters {
+        struct Table {
+            std::atomic<uint64_t> values[COUNTER_COUNT];
+            Table() {
+                for (std::atomic<uint64_t>& value : values) value.store(0, std::memory_order_relaxed);
+            }
+        };
+        std::unordered_map<std::string, Table> tables;
+
+        _Thread_Counters() {
+            _Instrumentation_Registry& registry = _instrumentation_registry();
+            std::lock_guard<std::mutex> lock(registry.mutex);
+            registry.threads.push_back(this);
+        }
+        ~_Thread_Counters() {
+            _Instrumentation_Registry& registry = _instrumentation_registry();
+            std::lock_guard<std::mutex> lock(registry.mutex);
+            collect(registry.retired);
+            registry.threads.erase(std::find(registry.threads.begin(), registry.threads.end(), this));
+        }
+        Table& table(const std::string& name) {
+            std::unordered_map<std::string, Table>::iterator found = tables.find(name);
+            if (found != tables.end()) return found->second;
+            std::lock_guard<std::mutex> lock(_instrumentation_registry().mutex);
+            return tables[name];
+        }
+        void collect(Instrumentation_Snapshot& snapshot) const {
+            for (const std::pair<const std::string, Table>& table : tables) {
+                Instrumentation_Counters& counters = snapshot[table.first];
+                for (size_t counter = 0; counter < COUNTER_COUNT; ++counter) counters.values[counter] += table.second.values[counter].load(std::memory_order_relaxed);
+            }
+        }
+        void reset() {
+            for (std::pair<const std::string, Table>& table : tables) {
+                for (std::atomic<uint64_t>& value : table.second.values) value.store(0, std::memory_order_relaxed);
+            }
+        }
+    };
+
+    inline void _count(const std::string& name, Counter counter, uint64_t amount) {
+        static thread_local _Thread_Counters counters;
+        counters.table(name).values[static_cast<size_t>(counter)].fetch_add(amount, std::memory_order_relaxed);
+    }
+
+    #define DYNAMIC_STRUCT_COUNT(name, counter, amount) ::dynamic_struct::_count(name, ::dynamic_struct::Counter::counter, amount)
+
+    const bool INSTRUMENTATION_ENABLED = true;
+#else
+    #define DYNAMIC_STRUCT_COUNT(name, counter, amount)
+
+    const bool INSTRUMENTATION_ENABLED = false;
+#endif
+
+    /* Sum counters of every thread, including exited ones */
+    inline Instrumentation_Snapshot instrumentation_snapshot() {
+        Instrumentation_Snapshot snapshot;
+#ifdef DYNAMIC_STRUCT_INSTRUMENTATION
+        _Instrumentation_Registry& registry = _instrumentation_registry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        snapshot = registry.retired;
+        for (const _Thread_Counters* thread : registry.threads) thread->collect(snapshot);
+#endif
+        return snapshot;
+    }
+
+    /* Zero counters of every thread */
+    inline void reset_instrumentation() {
+#ifdef DYNAMIC_STRUCT_INSTRUMENTATION
+        _Instrumentation_Registry& registry = _instrumentation_registry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        registry.retired.clear();
+        for (_Thread_Counters* thread : registry.threads) thread->reset();
+#endif
+    }
+
+    /* One line of counters per top-level type, omitting zeros */
+    inline std::string instrumentation_report(const Instrumentation_Snapshot& snapshot = instrumentation_snapshot()) {
+        if (!INSTRUMENTATION_ENABLED) return "Instrumentation is disabled, define DYNAMIC_STRUCT_INSTRUMENTATION to enable it\n";
+        std::string report;
+        for (const std::pair<const std::string, Instrumentation_Counters>& type : snapshot) {
+            std::string line;
+            for (size_t counter = 0; counter < COUNTER_COUNT; ++counter) {
+                if (type.second.values[counter] == 0) continue;
+                line += " " + get_string_from_counter(static_cast<Counter>(counter)) + "=" + std::to_string(type.second.values[counter]);
+            }
+            if (!line.empty()) report += (type.first.empty() ? "<anonymous>" : type.first) + ":" + line + "\n";
+        }
+        return report;
+    }
+
+    #define PATH_GET_POINTER_MACRO(pointer_type, type_name) if (data == nullptr) {\
+                throw std::invalid_argument(("Nullpointer Error: Cannot turn null pointer into " + std::string(#type_name) + " pointer of path at offset " + std::to_string(offset)).c_str());\
+            }\
+            if (this->primitive_data_type != Primitive_Data_Types::type_name) {\
+                throw std::invalid_argument(("Value Error: Cannot get " + std::string(#type_name) + " pointer from path at offset " + std::to_string(offset) + ", whose data type is " + get_string_from_type(primitive_data_type)).c_str());\
+            }\
+            return reinterpret_cast<pointer_type*>(static_cast<char*>(data) + offset);
+
+    #define PATH_SET_MACRO(type_name) if (this->primitive_data_type != Primitive_Data_Types::type_name) {\
+                throw std::invalid_argument(("Value Error: Cannot set " + std::string(#type_name) + " to path at offset " + std::to_string(offset) + ", whose data type is " + get_string_from_type(primitive_data_type)).c_str());\
+            }\
+            if (data == nullptr) {\
+                throw std::invalid_argument(("Nullpointer Error: Cannot set to null pointer of path at offset " + std::to_string(offset)).c_str());\
+            }\
+            memcpy(static_cast<char*>(data) + offset, &src, sizeof(src));
+
+    /**
+     * Precompiled location of a primitive field, produced by `Type::compile_path`
+     * It only records the byte offset from the beginning of data and the primitive data type,
+     * so it could be applied to the data of any instance of the same type,
+     * and each access is a single pointer shift without lookups, allocations or virtual calls.
+     */
+    class Field_Path {
+    private:
+        size_t offset;
+        Primitive_Data_Types primitive_data_type;
+    public:
+        Field_Path(size_t _offset, Primitive_Data_Types type):offset(_offset), primitive_data_type(type) {}
+        size_t get_Offset() const { return offset; }
+        Primitive_Data_Types get_Type() const { return primitive_data_type; }
+        /* Return the address of the field inside `data`, without type checking */
+        void* locate(void* data) const { return static_cast<char*>(data) + offset; }
+        const void* locate(const void* data) const { return static_cast<const char*>(data) + offset; }
+
+        int8_t* get_Int_8(void* data) const { PATH_GET_POINTER_MACRO(int8_t, Int_8) }
+        int16_t* get_Int_16(void* data) const { PATH_GET_POINTER_MACRO(int16_t, Int_16) }
+        int32_t* get_Int_32(void* data) const { PATH_GET_POINTER_MACRO(int32_t, Int_32) }
+        int64_t* get_Int_64(void* data) const { PATH_GET_POINTER_MACRO(int64_t, Int_64) }
+
+        uint8_t* get_Unsigned_Int_8(void* data) const { PATH_GET_POINTER_MACRO(uint8_t, Unsigned_Int_8) }
+        uint16_t* get_Unsigned_Int_16(void* data) const { PATH_GET_POINTER_MACRO(uint16_t, Unsigned_Int_16) }
+        uint32_t* get_Unsigned_Int_32(void* data) const { PATH_GET_POINTER_MACRO(uint32_t, Unsigned_Int_32) }
+        uint64_t* get_Unsigned_Int_64(void* data) const { PATH_GET_POINTER_MACRO(uint64_t, Unsigned_Int_64) }
+
+        char* get_Char(void* data) const { PATH_GET_POINTER_MACRO(char, Char) }
+
+        float* get_Float_32(void* data) const { PATH_GET_POINTER_MACRO(float, Float_32) }
+        double* get_Float_64(void* data) const { PATH_GET_POINTER_MACRO(double, Float_64) }
+
+        bool* get_Boolean(void* data) const { PATH_GET_POINTER_MACRO(bool, Boolean) }
+
+        void set(void* data, int8_t src) const { PATH_SET_MACRO(Int_8) }
+        void set(void* data, int16_t src) const { PATH_SET_MACRO(Int_16) }
+        void set(void* data, int32_t src) const { PATH_SET_MACRO(Int_32) }
+        void set(void* data, int64_t src) const { PATH_SET_MACRO(Int_64) }
+
+        void set(void* data, uint8_t src) const { PATH_SET_MACRO(Unsigned_Int_8) }
+        void set(void* data, uint16_t src) const { PATH_SET_MACRO(Unsigned_Int_16) }
+        void set(void* data, uint32_t src) const { PATH_SET_MACRO(Unsigned_Int_32) }
+        void set(void* data, uint64_t src) const { PATH_SET_MACRO(Unsigned_Int_64) }
+
+        void set(void* data, char src) const { PATH_SET_MACRO(Char) }
+
+        void set(void* data, float src) const { PATH_SET_MACRO(Float_32) }
+        void set(void* data, double src) const { PATH_SET_MACRO(Float_64) }
+
+        void set(void* data, bool src) const { PATH_SET_MACRO(Boolean) }
+    };
 
     /**
      * Generally Supported Data Type
@@ -86,158 +400,1073 @@ namespace dynamic_struct {
         Struct
     };
 
+    class Schema;
+
+    struct _Schema_Registry {
+        std::mutex mutex;
+        std::unordered_multimap<size_t, std::weak_ptr<const Schema>> nodes;
+        /* Expired nodes are swept when the registry grows beyond this size */
+        size_t sweep_size;
+    };
+    inline _Schema_Registry& _schema_registry() {
+        // Never destroyed, since schemas might be released during static destruction
+        static _Schema_Registry* registry = new _Schema_Registry{ {}, {}, 1024 };
+        return *registry;
+    }
+
     /**
-     * Class representation for `Type`
-     * Specifically, `Type` could be `Primitive Data Types`, `Array of Any Type`, `Struct of Stacked Types`
+     * Immutable description of a `Type`, which is shared by every instance and clone of the type
+     * Schemas are interned, so that structurally equal schemas are the same node and are compared by address.
+     * A schema is never modified once created; renaming or appending creates another one.
      */
-    class Type {
+    class Schema {
     private:
-        friend class Primitive_Type;
-        friend class Array_Type;
-        friend class Struct_Type;
-    protected:
+        friend class Type;
+        friend class Type_View;
         Type_Class type_class;
+        std::string name;
+        /* For Primitive Type */
+        Primitive_Data_Types primitive_data_type;
+        /* For Array Type */
+        size_t length;
+        std::shared_ptr<const Schema> element;
+        /* For Struct Type, in the order of keys */
+        std::vector<std::shared_ptr<const Schema>> fields;
+        std::vector<size_t> offsets;
         /**
-         * Pointer to data chunk
+         * Open-addressing index from keys into positions, built once with the Struct
+         * Its size is a power of 2 at least twice the number of properties, and each slot keeps the hash of its key,
+         * so a lookup probes a few adjacent slots and compares bytes of a key only when hashes are equal.
          */
-        void* data;
-        bool hold_or_possess; // true - hold | false - possess
-        std::string name;
-        Type* parent_type;
+        struct Key_Slot {
+            size_t hash;
+            size_t pos;
+        };
+        std::vector<Key_Slot> key_slots;
+        Layout_Policy layout_policy;
+        /* Bytes and alignment, including padding */
+        size_t size;
+        size_t alignment;
+        size_t hash;
+        /* Whether any String or Blob is inside, whose long values live in an arena */
+        bool variable_length;
+
+        Schema(Type_Class type, const std::string& _name):type_class(type), name(_name), primitive_data_type(Primitive_Data_Types::Int_8), length(0), layout_policy(Layout_Policy::Packed), size(0), alignment(1), hash(0), variable_length(false) {
+            if (!check_name(name)) throw std::invalid_argument(("Value Error: Cannot assign name '" + name + "' to type").c_str());
+        }
+        static size_t combine(size_t seed, size_t value) {
+            return seed ^ (value + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2));
+        }
+        /* FNV-1a, which reads the key in place */
+        static size_t hash_key(const char* key, size_t length) {
+            uint64_t hash = 0xcbf29ce484222325ULL;
+            for (size_t index = 0; index < length; ++index) {
+                hash ^= static_cast<unsigned char>(key[index]);
+                hash *= 0x100000001b3ULL;
+            }
+            return static_cast<size_t>(hash ^ (hash >> 32));
+        }
+        /* Return the slot of `key`, or the empty slot where it would be inserted */
+        size_t probe(const char* key, size_t length, size_t hash) const {
+            size_t mask = key_slots.size() - 1;
+            for (size_t slot = hash & mask; ; slot = (slot + 1) & mask) {
+                const Key_Slot& candidate = key_slots[slot];
+                if (candidate.pos == npos) return slot;
+                if (candidate.hash == hash) {
+                    const std::string& name = fields[candidate.pos]->name;
+                    if (name.length() == length && memcmp(name.data(), key, length) == 0) return slot;
+                }
+            }
+        }
+        /* Children are interned, so they are compared by address */
+        bool same_as(const Schema& other) const {
+            return type_class == other.type_class && name == other.name && primitive_data_type == other.primitive_data_type
+                && length == other.length && element == other.element && fields == other.fields && layout_policy == other.layout_policy;
+        }
+        /* Return the existing node equal to `candidate`, or register `candidate` */
+        static std::shared_ptr<const Schema> intern(Schema* candidate) {
+            std::unique_ptr<Schema> owned(candidate);
+            size_t hash = std::hash<std::string>()(candidate->name);
+            hash = combine(hash, static_cast<size_t>(candidate->type_class));
+            hash = combine(hash, static_cast<size_t>(candidate->primitive_data_type));
+            hash = combine(hash, candidate->length);
+            hash = combine(hash, std::hash<const Schema*>()(candidate->element.get()));
+            for (const std::shared_ptr<const Schema>& field : candidate->fields) hash = combine(hash, std::hash<const Schema*>()(field.get()));
+            hash = combine(hash, static_cast<size_t>(candidate->layout_policy));
+            candidate->hash = hash;
+
+            _Schema_Registry& registry = _schema_registry();
+            std::lock_guard<std::mutex> lock(registry.mutex);
+            auto range = registry.nodes.equal_range(hash);
+            for (auto iter = range.first; iter != range.second;) {
+                std::shared_ptr<const Schema> node = iter->second.lock();
+                if (node == nullptr) {
+                    iter = registry.nodes.erase(iter);
+                    continue;
+                }
+                if (node->same_as(*candidate)) return node;
+                ++iter;
+            }
+            if (registry.nodes.size() >= registry.sweep_size) {
+                for (auto iter = registry.nodes.begin(); iter != registry.nodes.end();) {
+                    if (iter->second.expired()) iter = registry.nodes.erase(iter);
+                    else ++iter;
+                }
+                registry.sweep_size = std::max<size_t>(1024, registry.nodes.size() * 2);
+            }
+            std::shared_ptr<const Schema> node(owned.release());
+            registry.nodes.emplace(hash, node);
+            return node;
+        }
+        std::string _type(std::string prefix, bool with_name) const {
+            switch (type_class) {
+            case Type_Class::Primitive:
+                return prefix + get_string_from_type(primitive_data_type) + (with_name == true ? " " + name : "");
+            case Type_Class::Array:
+                return prefix + "[" + std::to_string(length) + "]" + element->_type("", false) + (with_name == true? " " + name: "");
+            case Type_Class::Struct: {
+                std::string policy = layout_policy == Layout_Policy::Packed ? "" : get_string_from_layout_policy(layout_policy) + " ";
+                std::string str = prefix + (with_name == true? name + " " : "") + policy + "{\n";
+                for (size_t index = 0; index < fields.size(); ++index) {
+                    str += prefix + fields[index]->_type("    ", true);
+                    if (index != fields.size() - 1) str += ", \n";
+                    else str += "\n";
+                }
+                str += prefix + "}";
+                return str;
+            }
+            }
+            return "";
+        }
+        void check_class(Type_Class expected, const char* operation) const {
+            if (type_class != expected) {
+                throw std::invalid_argument(("Compile Error: Cannot " + std::string(operation) + " of type '" + name + "'").c_str());
+            }
+        }
+    public:
+        /* Position returned by `find` for missing keys */
+        static const size_t npos = static_cast<size_t>(-1);
         /**
          * Check for legitimacy of variable name
          */
-        bool check_name(std::string name) {
+        static bool check_name(const std::string& name) {
             return name.find_first_of(FORBIDDEN_VARIABLE_NAME_CHARS) == std::string::npos;
         }
-        virtual std::string _type(std::string prefix, bool with_name) const = 0;
-        /**
-         * For Struct Type
-         */
-        virtual void change_key(std::string target, std::string origin) = 0;
 
-        Type(Type_Class type, std::string _name):type_class(type), name(""), data(nullptr), hold_or_possess(true), parent_type(nullptr) {
-            if (!check_name(_name)) throw std::invalid_argument(("Value Error: Cannot assign name '" + _name + "' to type").c_str());
-            else name = _name;
+        static std::shared_ptr<const Schema> make_Primitive(Primitive_Data_Types type, const std::string& name) {
+            Schema* schema = new Schema(Type_Class::Primitive, name);
+            schema->primitive_data_type = type;
+            switch (type) {
+            case Primitive_Data_Types::Int_8: schema->size = sizeof(int8_t); break;
+            case Primitive_Data_Types::Int_16: schema->size = sizeof(int16_t); break;
+            case Primitive_Data_Types::Int_32: schema->size = sizeof(int32_t); break;
+            case Primitive_Data_Types::Int_64: schema->size = sizeof(int64_t); break;
+
+            case Primitive_Data_Types::Unsigned_Int_8: schema->size = sizeof(uint8_t); break;
+            case Primitive_Data_Types::Unsigned_Int_16: schema->size = sizeof(uint16_t); break;
+            case Primitive_Data_Types::Unsigned_Int_32: schema->size = sizeof(uint32_t); break;
+            case Primitive_Data_Types::Unsigned_Int_64: schema->size = sizeof(uint64_t); break;
+
+            case Primitive_Data_Types::Char: schema->size = sizeof(char); break;
+
+            case Primitive_Data_Types::Boolean: schema->size = sizeof(bool); break;
+
+            case Primitive_Data_Types::Float_32: schema->size = sizeof(float); break;
+            case Primitive_Data_Types::Float_64: schema->size = sizeof(double); break;
+
+            case Primitive_Data_Types::String:
+            case Primitive_Data_Types::Blob:
+                schema->size = STRING_SLOT_BYTES;
+                schema->variable_length = true;
+                break;
+            }
+            // Slots of String and Blob hold an 8-byte offset
+            schema->alignment = schema->variable_length ? sizeof(uint64_t) : schema->size;
+            return intern(schema);
+        }
+        static std::shared_ptr<const Schema> make_Array(size_t length, const std::shared_ptr<const Schema>& element, const std::string& name) {
+            if (element == nullptr) throw std::invalid_argument(("Nullpointer Error: Element Type of Array Type '" + name + "' is null").c_str());
+            std::unique_ptr<Schema> schema(new Schema(Type_Class::Array, name));
+            if (element->size != 0 && length > std::numeric_limits<size_t>::max() / element->size) {
+                throw std::overflow_error(("Memory Error: Array Type '" + name + "' is too large").c_str());
+            }
+            schema->length = length;
+            schema->element = element;
+            schema->size = element->size * length;
+            schema->alignment = element->alignment;
+            schema->variable_length = element->variable_length;
+            return intern(schema.release());
         }
-    public:
-        std::string type() const {
-            return _type("", true);
+        /**
+         * Properties are arranged corresponding to their positions in `fields`, and placed by `policy`
+         */
+        static std::shared_ptr<const Schema> make_Struct(std::vector<std::shared_ptr<const Schema>> _fields, const std::string& name, Layout_Policy policy = Layout_Policy::Packed) {
+            std::unique_ptr<Schema> schema(new Schema(Type_Class::Struct, name));
+            schema->fields = std::move(_fields);
+            const std::vector<std::shared_ptr<const Schema>>& fields = schema->fields;
+            schema->layout_policy = policy;
+            size_t slot_count = 2;
+            while (slot_count < fields.size() * 2) slot_count *= 2;
+            schema->key_slots.assign(slot_count, Key_Slot{ 0, npos });
+            for (size_t index = 0; index < fields.size(); ++index) {
+                const std::string& key = fields[index]->name;
+                size_t hash = hash_key(key.data(), key.length());
+                size_t slot = schema->probe(key.data(), key.length(), hash);
+                // Check for Duplication
+                if (schema->key_slots[slot].pos != npos) {
+                    throw std::invalid_argument(("Value Error: Cannot set duplicate property with name '" + key + "' in type '" + name + "'").c_str());
+                }
+                schema->key_slots[slot] = Key_Slot{ hash, index };
+            }
+            std::vector<size_t> order(fields.size());
+            for (size_t index = 0; index < order.size(); ++index) order[index] = index;
+            if (policy == Layout_Policy::Compact) {
+                std::stable_sort(order.begin(), order.end(), [&fields](size_t u, size_t v) { return fields[u]->alignment > fields[v]->alignment; });
+            }
+            schema->offsets.resize(fields.size());
+            size_t offset = 0;
+            for (size_t index : order) {
+                size_t alignment = policy == Layout_Policy::Packed ? 1 : fields[index]->alignment;
+                offset = (offset + alignment - 1) / alignment * alignment;
+                schema->offsets[index] = offset;
+                offset += fields[index]->size;
+                schema->alignment = std::max(schema->alignment, alignment);
+                schema->variable_length = schema->variable_length || fields[index]->variable_length;
+            }
+            // Tail padding keeps every element of Array aligned
+            schema->size = (offset + schema->alignment - 1) / schema->alignment * schema->alignment;
+            return intern(schema.release());
+        }
+        /* The same schema under another name */
+        std::shared_ptr<const Schema> rename(const std::string& _name) const {
+            switch (type_class) {
+            case Type_Class::Primitive: return make_Primitive(primitive_data_type, _name);
+            case Type_Class::Array: return make_Array(length, element, _name);
+            case Type_Class::Struct: return make_Struct(fields, _name, layout_policy);
+            }
+            return nullptr;
         }
-        virtual Type* clone() const = 0;
+
+        /* Interned schemas are equal only if they are the same node */
+        bool operator==(const Schema& other) const { return this == &other; }
+        bool operator!=(const Schema& other) const { return this != &other; }
+        size_t get_Hash() const { return hash; }
+
+        Type_Class get_Type_Class() const { return type_class; }
+        const std::string& get_name() const { return name; }
+        std::string type() const { return _type("", true); }
         /* Return the Bytes of `Type` */
-        virtual size_t size_of() const = 0;
-        Type_Class get_Type_Class() const {
-            return type_class;
-        }
+        size_t size_of() const { return size; }
+        /* Return the Bytes which the address of `Type` should be a multiple of */
+        size_t alignment_of() const { return alignment; }
+        /* Whether any String or Blob is inside, so that data refers to an arena */
+        bool has_Variable_Length() const { return variable_length; }
         /**
-         * For Struct Type
+         * For Primitive Type
          */
-        virtual Type& operator[](std::string key) = 0;
-        Type& get(std::string key) {
-            return (*this)[key];
+        Primitive_Data_Types get_Type() const {
+            check_class(Type_Class::Primitive, "get raw primitive data type");
+            return primitive_data_type;
         }
-        /* Get names of components of Struct */
-        virtual std::vector<std::string> get_Keys() const = 0;
-        virtual Type& append(Type* type) = 0;
         /**
          * For Array Type
          */
-        virtual std::unique_ptr<Type> operator[](size_t pos) = 0;
-        std::unique_ptr<Type> at(size_t pos) {
-            return (*this)[pos];
-        }
-        virtual Type& get_Element_Type() = 0;
         /* Get Size of Array */
-        virtual size_t get_Size() const = 0;
+        size_t get_Size() const {
+            check_class(Type_Class::Array, "get size");
+            return length;
+        }
+        const std::shared_ptr<const Schema>& get_Element() const {
+            check_class(Type_Class::Array, "get Element Type");
+            return element;
+        }
         /**
-         * For Primitive Type
+         * For Struct Type
          */
-        /* Get Raw Primitive Type */
-        virtual Primitive_Data_Types get_Type() const = 0;
-        
-        /* `init` malloc a piece of memory to hold data, which will be deleted automatically if not used. */
-        virtual void init() {
-            release();
-            data = malloc(size_of());
-            if (data == nullptr) {
-                throw std::overflow_error(("Memory Error: Fail to allocate memory for type '" + name + "'").c_str());
-            }
-            memset(data, 0, size_of());
-            hold_or_possess = false;
+        size_t get_Field_Count() const {
+            check_class(Type_Class::Struct, "get properties");
+            return fields.size();
         }
-        /* `hold` will pass a pointer of data, which will not be deleted automatically if this object is not used. */
-        virtual void hold(void* _data) {
-            release();
-            data = _data;
-            hold_or_possess = true;
+        const std::shared_ptr<const Schema>& get_Field(size_t pos) const {
+            if (pos >= get_Field_Count()) throw std::out_of_range(("Index Error: Cannot index over the number of properties of type '" + name + "'").c_str());
+            return fields[pos];
         }
-        virtual void release() {
-            if (data != nullptr && hold_or_possess == false) free(data);
-            data = nullptr;
+        /* Get Bytes between the beginning of Struct and the property at `pos` */
+        size_t get_Field_Offset(size_t pos) const {
+            if (pos >= get_Field_Count()) throw std::out_of_range(("Index Error: Cannot index over the number of properties of type '" + name + "'").c_str());
+            return offsets[pos];
         }
-        void* get_data() { return data; }
-        ~Type() {
-            release();
+        /* Get position of the property `key` of `length` bytes, or `npos` if not found, without constructing `std::string` */
+        size_t find(const char* key, size_t length) const {
+            check_class(Type_Class::Struct, "find key");
+            return key_slots[probe(key, length, hash_key(key, length))].pos;
+        }
+        size_t find(const char* key) const {
+            return find(key, strlen(key));
+        }
+        size_t find(const std::string& key) const {
+            return find(key.data(), key.length());
+        }
+        /* Get names of components of Struct */
+        std::vector<std::string> get_Keys() const {
+            check_class(Type_Class::Struct, "get keys");
+            std::vector<std::string> keys;
+            keys.reserve(fields.size());
+            for (const std::shared_ptr<const Schema>& field : fields) keys.push_back(field->name);
+            return keys;
+        }
+        /* Get Bytes between the beginning of Struct and the property `key` */
+        size_t get_Offset(const std::string& key) const {
+            size_t pos = find(key);
+            if (pos == npos) throw std::invalid_argument(("Value Error: Cannot find key '" + key + "' in type '" + name + "'").c_str());
+            return offsets[pos];
+        }
+        Layout_Policy get_Layout_Policy() const {
+            check_class(Type_Class::Struct, "get layout policy");
+            return layout_policy;
         }
-        
-        /* Notice that this function does not have type checking */
-        virtual void set(void* src) = 0;
-        virtual void set(int8_t src) = 0;
-        virtual void set(int16_t src) = 0;
-        virtual void set(int32_t src) = 0;
-        virtual void set(int64_t src) = 0;
-
-        virtual void set(uint8_t src) = 0;
-        virtual void set(uint16_t src) = 0;
-        virtual void set(uint32_t src) = 0;
-        virtual void set(uint64_t src) = 0;
-
-        virtual void set(char src) = 0;
-
-        virtual void set(float src) = 0;
-        virtual void set(double src) = 0;
-
-        virtual void set(bool src) = 0;
-
-        /* Useful Function, which will parse `src` automatically into appropriate internal data type */
-        virtual void set(std::string src) = 0;
-
-        virtual int8_t* get_Int_8() const = 0;
-        virtual int16_t* get_Int_16() const = 0;
-        virtual int32_t* get_Int_32() const = 0;
-        virtual int64_t* get_Int_64() const = 0;
 
-        virtual uint8_t* get_Unsigned_Int_8() const = 0;
-        virtual uint16_t* get_Unsigned_Int_16() const = 0;
-        virtual uint32_t* get_Unsigned_Int_32() const = 0;
-        virtual uint64_t* get_Unsigned_Int_64() const = 0;
+        /**
+         * Resolve `path` into a `Field_Path`, which could be reused on the data of any instance of this type
+         * Keys of Struct are separated by `.` and positions of Array are wrapped by `[]`, e.g. "point_a.x" or "tensor[3][0][1]"
+         */
+        Field_Path compile_path(const std::string& path) const {
+            std::string parse_error = "Value Error: Unable to parse path '" + path + "' of type '" + name + "'";
+            const Schema* current = this;
+            size_t offset = 0;
+            size_t index = 0;
+            while (index < path.length()) {
+                if (path[index] == '[') {
+                    size_t end = path.find(']', index);
+                    if (end == std::string::npos || end == index + 1) throw std::invalid_argument(parse_error.c_str());
+                    size_t pos = 0;
+                    // Positions which overflow `size_t` are over the length of any Array
+                    bool overflow = false;
+                    for (size_t digit = index + 1; digit < end; ++digit) {
+                        if (path[digit] < '0' || path[digit] > '9') throw std::invalid_argument(parse_error.c_str());
+                        size_t value = static_cast<size_t>(path[digit] - '0');
+                        if (pos > (std::numeric_limits<size_t>::max() - value) / 10) overflow = true;
+                        else pos = pos * 10 + value;
+                    }
+                    if (current->type_class != Type_Class::Array) {
+                        throw std::invalid_argument(("Compile Error: Type '" + current->name + "' in path '" + path + "' cannot be indexed with `pos`").c_str());
+                    }
+                    if (overflow || pos >= current->length) {
+                        throw std::out_of_range(("Index Error: Cannot index over the length of type '" + current->name + "' in path '" + path + "'").c_str());
+                    }
+                    current = current->element.get();
+                    offset += current->size * pos;
+                    index = end + 1;
+                } else {
+                    // Keys lead the path or follow a separator
+                    if (path[index] == '.' && index != 0) ++index;
+                    else if (index != 0 || path[index] == '.') throw std::invalid_argument(parse_error.c_str());
+                    size_t end = path.find_first_of(".[", index);
+                    if (end == std::string::npos) end = path.length();
+                    if (end == index) throw std::invalid_argument(parse_error.c_str());
+                    if (current->type_class != Type_Class::Struct) {
+                        std::string type_class = current->type_class == Type_Class::Primitive ? "Primitive Type" : "Array Type";
+                        throw std::invalid_argument(("Compile Error: Cannot get offset of key in " + type_class + " '" + current->name + "'").c_str());
+                    }
+                    size_t pos = current->find(path.data() + index, end - index);
+                    if (pos == npos) throw std::invalid_argument(("Value Error: Cannot find key '" + path.substr(index, end - index) + "' in type '" + current->name + "'").c_str());
+                    offset += current->offsets[pos];
+                    current = current->fields[pos].get();
+                    index = end;
+                }
+            }
+            if (current->type_class != Type_Class::Primitive) {
+                throw std::invalid_argument(("Value Error: Path '" + path + "' of type '" + name + "' does not end with a Primitive Type").c_str());
+            }
+            return Field_Path(offset, current->primitive_data_type);
+        }
+    };
 
-        virtual char* get_Char() const = 0;
+    /* Result of operations which report errors without throwing */
+    enum class Status {
+        Ok,
+        Invalid_Value,
+        Out_Of_Range,
+        Missing_Value,
+        Extra_Value,
+        /* Type is not the Primitive Type requested */
+        Type_Mismatch,
+        /* Type holds no data */
+        Null_Data
+    };
 
-        virtual float* get_Float_32() const = 0;
-        virtual double* get_Float_64() const = 0;
+    inline std::string get_string_from_status(Status status) {
+        switch (status) {
+        case Status::Ok: return "Ok";
+        case Status::Invalid_Value: return "Invalid_Value";
+        case Status::Out_Of_Range: return "Out_Of_Range";
+        case Status::Missing_Value: return "Missing_Value";
+        case Status::Extra_Value: return "Extra_Value";
+        case Status::Type_Mismatch: return "Type_Mismatch";
+        case Status::Null_Data: return "Null_Data";
+        }
+        return "Unknown";
+    }
 
-        virtual bool* get_Boolean() const = 0;
+    /**
+     * Append-only storage of values of String and Blob longer than `STRING_INLINE_BYTES`, owned by an instance of `Type` or by rows
+     * Slots refer to values by offsets, which stay valid when the arena grows, so the arena is saved or copied along with its rows as is.
+     * Overwritten values are not reclaimed until the arena is cleared.
+     */
+    class String_Arena {
+    private:
+        char* data;
+        size_t size;
+        size_t capacity;
+    public:
+        String_Arena():data(nullptr), size(0), capacity(0) {}
+        String_Arena(const String_Arena&) = delete;
+        String_Arena& operator=(const String_Arena&) = delete;
+        ~String_Arena() {
+            if (data != nullptr) free(data);
+        }
+        /* Get Bytes of all values */
+        size_t get_Size() const { return size; }
+        size_t get_Capacity() const { return capacity; }
+        char* get_data() { return data; }
+        const char* get_data() const { return data; }
 
-        Type* set_name(std::string _name) {
-            if (!check_name(_name)) throw std::invalid_argument(("Value Error: Cannot assign name '" + _name + "' to type").c_str());
-            // Change Upper side Type
-            if (parent_type != nullptr && parent_type->type_class == Type_Class::Struct) {
-                parent_type->change_key(_name, name);
+        void reserve(size_t _capacity) {
+            if (_capacity <= capacity) return;
+            char* new_data = static_cast<char*>(realloc(data, _capacity));
+            if (new_data == nullptr) throw std::overflow_error("Memory Error: Fail to allocate memory for arena of String");
+            data = new_data;
+            capacity = _capacity;
+        }
+        /* Append `length` bytes, which might be inside this arena, returning their offset */
+        uint64_t append(const void* src, size_t length) {
+            if (length > capacity - size) {
+                uintptr_t address = reinterpret_cast<uintptr_t>(src), base = reinterpret_cast<uintptr_t>(data);
+                bool inside = data != nullptr && address >= base && address < base + size;
+                reserve(std::max(size + length, capacity < 256 ? 256 : capacity * 2));
+                if (inside) src = data + (address - base);
             }
-            name = _name;
-            return this;
+            if (length != 0) memcpy(data + size, src, length);
+            size += length;
+            return size - length;
         }
-        std::string get_name() const {
-            return this->name;
+        /* `resize` changes the Bytes of values without initializing new bytes, e.g. before reading them from a file */
+        void resize(size_t _size) {
+            reserve(_size);
+            size = _size;
         }
+        void clear() { size = 0; }
+    };
 
-        virtual std::string string() const = 0;
+    /* Bytes of a String or Blob, which point into its slot or its arena until either of them changes */
+    struct String_Ref {
+        const char* data;
+        size_t length;
+        std::string str() const { return std::string(data, length); }
+    };
 
-        friend std::ostream& operator<< (std::ostream& stream, const Type& operand) {
-            stream << operand.string();
-            return stream;
+    /**
+     * Write `length` bytes from `src` into the String or Blob `slot`, where long values are appended to `arena`
+     * Long values without an arena are `Null_Data`, and values over 4 GiB are `Out_Of_Range`.
+     */
+    inline Status store_string(void* slot, const void* src, size_t length, String_Arena* arena) {
+        if (length > std::numeric_limits<uint32_t>::max()) return Status::Out_Of_Range;
+        char* _slot = static_cast<char*>(slot);
+        uint32_t _length = static_cast<uint32_t>(length);
+        if (length <= STRING_INLINE_BYTES) {
+            char inline_value[STRING_SLOT_BYTES] = {};
+            memcpy(inline_value, &_length, sizeof(_length));
+            if (length != 0) memcpy(inline_value + sizeof(_length), src, length);
+            memcpy(_slot, inline_value, STRING_SLOT_BYTES);
+            return Status::Ok;
+        }
+        if (arena == nullptr) return Status::Null_Data;
+        uint64_t offset = arena->append(src, length);
+        memcpy(_slot, &_length, sizeof(_length));
+        // The prefix is copied from the arena, since `src` might have moved with it
+        memcpy(_slot + sizeof(_length), arena->get_data() + offset, 4);
+        memcpy(_slot + 8, &offset, sizeof(offset));
+        return Status::Ok;
+    }
+    /**
+     * Read the value of the String or Blob `slot` into `dst`
+     * Long values without an arena are `Null_Data`, and those outside `arena` are `Out_Of_Range`.
+     */
+    inline Status load_string(const void* slot, const String_Arena* arena, String_Ref& dst) {
+        const char* _slot = static_cast<const char*>(slot);
+        uint32_t length;
+        memcpy(&length, _slot, sizeof(length));
+        if (length <= STRING_INLINE_BYTES) {
+            dst = String_Ref{ _slot + sizeof(length), length };
+            return Status::Ok;
+        }
+        if (arena == nullptr) return Status::Null_Data;
+        uint64_t offset;
+        memcpy(&offset, _slot + 8, sizeof(offset));
+        if (offset > arena->get_Size() || length > arena->get_Size() - offset) return Status::Out_Of_Range;
+        dst = String_Ref{ arena->get_data() + offset, length };
+        return Status::Ok;
+    }
+    /* Copy long values of `count` slots `stride` bytes apart from `from` into `to`, rewriting their offsets */
+    inline void _rehome_strings(char* slots, size_t stride, size_t count, const String_Arena* from, String_Arena& to) {
+        if (from == &to) return;
+        for (size_t index = 0; index < count; ++index) {
+            char* slot = slots + stride * index;
+            uint32_t length;
+            memcpy(&length, slot, sizeof(length));
+            if (length <= STRING_INLINE_BYTES) continue;
+            String_Ref value;
+            if (load_string(slot, from, value) != Status::Ok) {
+                throw std::invalid_argument("Value Error: Cannot copy String or Blob, which is outside its arena");
+            }
+            store_string(slot, value.data, value.length, &to);
+        }
+    }
+    /* Write `length` bytes at `dst` as lowercase hexadecimal digits, returning the end of text */
+    inline char* format_hex(char* dst, const char* src, size_t length) {
+        static const char digits[] = "0123456789abcdef";
+        for (size_t index = 0; index < length; ++index) {
+            unsigned char byte = static_cast<unsigned char>(src[index]);
+            *dst++ = digits[byte >> 4];
+            *dst++ = digits[byte & 0xF];
+        }
+        return dst;
+    }
+    inline int _hex_digit(char c) {
+        if (c >= '0' && c <= '9') return c - '0';
+        if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+        if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+        return -1;
+    }
+
+    /* Read a value of `T` at `src`, which might not be aligned to `T`, e.g. inside a Packed Struct */
+    template <typename T>
+    inline T _load_value(const void* src) {
+        T value;
+        memcpy(&value, src, sizeof(T));
+        return value;
+    }
+    /* Text of the fixed-width Primitive value at `src`, the same as `std::to_string` */
+    inline std::string _primitive_string(Primitive_Data_Types type, const void* src) {
+        switch (type) {
+        case Primitive_Data_Types::Int_8: return std::to_string(_load_value<int8_t>(src));
+        case Primitive_Data_Types::Int_16: return std::to_string(_load_value<int16_t>(src));
+        case Primitive_Data_Types::Int_32: return std::to_string(_load_value<int32_t>(src));
+        case Primitive_Data_Types::Int_64: return std::to_string(_load_value<int64_t>(src));
+
+        case Primitive_Data_Types::Unsigned_Int_8: return std::to_string(_load_value<uint8_t>(src));
+        case Primitive_Data_Types::Unsigned_Int_16: return std::to_string(_load_value<uint16_t>(src));
+        case Primitive_Data_Types::Unsigned_Int_32: return std::to_string(_load_value<uint32_t>(src));
+        case Primitive_Data_Types::Unsigned_Int_64: return std::to_string(_load_value<uint64_t>(src));
+
+        case Primitive_Data_Types::Char: return std::string(1, _load_value<char>(src));
+
+        case Primitive_Data_Types::Boolean: return _load_value<bool>(src) ? "true" : "false";
+
+        case Primitive_Data_Types::Float_32: return std::to_string(_load_value<float>(src));
+        case Primitive_Data_Types::Float_64: return std::to_string(_load_value<double>(src));
+
+        // Values live in the slot or in an arena, which callers resolve
+        case Primitive_Data_Types::String:
+        case Primitive_Data_Types::Blob: break;
+        }
+        return "";
+    }
+
+    template <typename T>
+    inline Status _parse_signed(const char* begin, const char* end, void* dst) {
+        bool negative = begin != end && *begin == '-';
+        if (begin != end && (*begin == '-' || *begin == '+')) ++begin;
+        if (begin == end) return Status::Invalid_Value;
+        uint64_t limit = static_cast<uint64_t>(std::numeric_limits<T>::max()) + (negative ? 1 : 0);
+        uint64_t quotient = limit / 10, remainder = limit % 10;
+        uint64_t value = 0;
+        for (; begin != end; ++begin) {
+            uint64_t digit = static_cast<unsigned char>(*begin) - static_cast<unsigned char>('0');
+            if (digit > 9) return Status::Invalid_Value;
+            if (value > quotient || (value == quotient && digit > remainder)) return Status::Out_Of_Range;
+            value = value * 10 + digit;
+        }
+        // Avoid overflow when negating the minimum
+        T result = negative ? (value == 0 ? 0 : static_cast<T>(-static_cast<int64_t>(value - 1) - 1)) : static_cast<T>(value);
+        memcpy(dst, &result, sizeof(T));
+        return Status::Ok;
+    }
+    template <typename T>
+    inline Status _parse_unsigned(const char* begin, const char* end, void* dst) {
+        if (begin != end && *begin == '+') ++begin;
+        if (begin == end) return Status::Invalid_Value;
+        const uint64_t quotient = std::numeric_limits<T>::max() / 10, remainder = std::numeric_limits<T>::max() % 10;
+        uint64_t value = 0;
+        for (; begin != end; ++begin) {
+            uint64_t digit = static_cast<unsigned char>(*begin) - static_cast<unsigned char>('0');
+            if (digit > 9) return Status::Invalid_Value;
+            if (value > quotient || (value == quotient && digit > remainder)) return Status::Out_Of_Range;
+            value = value * 10 + digit;
+        }
+        T result = static_cast<T>(value);
+        memcpy(dst, &result, sizeof(T));
+        return Status::Ok;
+    }
+
+    template <typename T> struct _Float_Traits;
+    template <> struct _Float_Traits<float> {
+        /* Largest mantissa and power of 10 which are exact in float */
+        static constexpr uint64_t max_mantissa = uint64_t(1) << 24;
+        static constexpr int max_exponent = 10;
+        static float parse(const char* str, char** end) { return strtof(str, end); }
+    };
+    template <> struct _Float_Traits<double> {
+        static constexpr uint64_t max_mantissa = uint64_t(1) << 53;
+        static constexpr int max_exponent = 22;
+        static double parse(const char* str, char** end) { return strtod(str, end); }
+    };
+    /**
+     * Decimal floats with a short mantissa and a small exponent are exactly `mantissa * 10^exponent` or `mantissa / 10^-exponent`,
+     * which needs one correctly rounded operation. Others, including `inf` and `nan`, fall back to `strtod`.
+     */
+    template <typename T>
+    inline Status _parse_float(const char* begin, const char* end, void* dst, std::string& scratch) {
+        static const T powers_of_10[] = {
+            T(1e0), T(1e1), T(1e2), T(1e3), T(1e4), T(1e5), T(1e6), T(1e7), T(1e8), T(1e9), T(1e10), T(1e11),
+            T(1e12), T(1e13), T(1e14), T(1e15), T(1e16), T(1e17), T(1e18), T(1e19), T(1e20), T(1e21), T(1e22)
+        };
+        const char* pos = begin;
+        bool negative = pos != end && *pos == '-';
+        if (pos != end && (*pos == '-' || *pos == '+')) ++pos;
+        uint64_t mantissa = 0;
+        int significant_digits = 0, exponent = 0;
+        bool any_digit = false, exact = true;
+        for (; pos != end && static_cast<unsigned>(*pos - '0') <= 9; ++pos) {
+            any_digit = true;
+            if (mantissa == 0 && *pos == '0') continue;
+            if (significant_digits < 19) { mantissa = mantissa * 10 + (*pos - '0'); ++significant_digits; }
+            else { ++exponent; exact = exact && *pos == '0'; }
+        }
+        if (pos != end && *pos == '.') {
+            for (++pos; pos != end && static_cast<unsigned>(*pos - '0') <= 9; ++pos) {
+                any_digit = true;
+                if (mantissa == 0 && *pos == '0') { --exponent; continue; }
+                if (significant_digits < 19) { mantissa = mantissa * 10 + (*pos - '0'); ++significant_digits; --exponent; }
+                else exact = exact && *pos == '0';
+            }
+        }
+        if (any_digit && pos != end && (*pos == 'e' || *pos == 'E')) {
+            ++pos;
+            bool negative_exponent = pos != end && *pos == '-';
+            if (pos != end && (*pos == '-' || *pos == '+')) ++pos;
+            if (pos == end) return Status::Invalid_Value;
+            int explicit_exponent = 0;
+            for (; pos != end && static_cast<unsigned>(*pos - '0') <= 9; ++pos) {
+                if (explicit_exponent < 100000) explicit_exponent = explicit_exponent * 10 + (*pos - '0');
+            }
+            exponent += negative_exponent ? -explicit_exponent : explicit_exponent;
+        }
+        if (any_digit && pos != end) return Status::Invalid_Value;
+        if (any_digit && exact && (mantissa == 0 || (mantissa <= _Float_Traits<T>::max_mantissa && exponent >= -_Float_Traits<T>::max_exponent && exponent <= _Float_Traits<T>::max_exponent))) {
+            T result = static_cast<T>(mantissa);
+            if (exponent < 0) result /= powers_of_10[-exponent];
+            else result *= powers_of_10[exponent];
+            if (negative) result = -result;
+            memcpy(dst, &result, sizeof(T));
+            return Status::Ok;
+        }
+        // `strtod` follows the decimal point of current locale
+        scratch.assign(begin, end);
+        char decimal_point = *localeconv()->decimal_point;
+        if (decimal_point != '.') std::replace(scratch.begin(), scratch.end(), '.', decimal_point);
+        char* stop = nullptr;
+        errno = 0;
+        T result = _Float_Traits<T>::parse(scratch.c_str(), &stop);
+        if (scratch.empty() || stop != scratch.c_str() + scratch.length() || isspace(static_cast<unsigned char>(scratch[0]))) return Status::Invalid_Value;
+        if (errno == ERANGE && std::abs(result) > std::numeric_limits<T>::max()) return Status::Out_Of_Range;
+        memcpy(dst, &result, sizeof(T));
+        return Status::Ok;
+    }
+
+    /**
+     * Parse the text in [begin, end) as a value of `type` into `dst` without allocation or locale
+     * Integers out of the range of `type` are reported instead of being truncated, and no spaces are skipped.
+     * String takes the text as is, and Blob takes pairs of hexadecimal digits, whose long values are appended to `arena`.
+     * \param scratch buffer reused by rare floats which need the slow path, and by Blob
+     */
+    inline Status parse_value(Primitive_Data_Types type, const char* begin, const char* end, void* dst, std::string& scratch, String_Arena* arena = nullptr) {
+        switch (type) {
+        case Primitive_Data_Types::Int_8: return _parse_signed<int8_t>(begin, end, dst);
+        case Primitive_Data_Types::Int_16: return _parse_signed<int16_t>(begin, end, dst);
+        case Primitive_Data_Types::Int_32: return _parse_signed<int32_t>(begin, end, dst);
+        case Primitive_Data_Types::Int_64: return _parse_signed<int64_t>(begin, end, dst);
+
+        case Primitive_Data_Types::Unsigned_Int_8: return _parse_unsigned<uint8_t>(begin, end, dst);
+        case Primitive_Data_Types::Unsigned_Int_16: return _parse_unsigned<uint16_t>(begin, end, dst);
+        case Primitive_Data_Types::Unsigned_Int_32: return _parse_unsigned<uint32_t>(begin, end, dst);
+        case Primitive_Data_Types::Unsigned_Int_64: return _parse_unsigned<uint64_t>(begin, end, dst);
+
+        case Primitive_Data_Types::Char:
+            if (end - begin != 1) return Status::Invalid_Value;
+            *static_cast<char*>(dst) = *begin;
+            return Status::Ok;
+
+        case Primitive_Data_Types::Boolean: {
+            bool result;
+            if (end - begin == 4 && memcmp(begin, "true", 4) == 0) result = true;
+            else if (end - begin == 5 && memcmp(begin, "false", 5) == 0) result = false;
+            else return Status::Invalid_Value;
+            memcpy(dst, &result, sizeof(bool));
+            return Status::Ok;
+        }
+
+        case Primitive_Data_Types::Float_32: return _parse_float<float>(begin, end, dst, scratch);
+        case Primitive_Data_Types::Float_64: return _parse_float<double>(begin, end, dst, scratch);
+
+        case Primitive_Data_Types::String: return store_string(dst, begin, end - begin, arena);
+        case Primitive_Data_Types::Blob: {
+            if ((end - begin) % 2 != 0) return Status::Invalid_Value;
+            scratch.resize((end - begin) / 2);
+            for (size_t index = 0; index < scratch.length(); ++index) {
+                int high = _hex_digit(begin[index * 2]), low = _hex_digit(begin[index * 2 + 1]);
+                if (high < 0 || low < 0) return Status::Invalid_Value;
+                scratch[index] = static_cast<char>(high << 4 | low);
+            }
+            return store_string(dst, scratch.data(), scratch.length(), arena);
+        }
+        }
+        return Status::Invalid_Value;
+    }
+
+    class Type_View;
+    class Type;
+
+    /* Create an instance of `Type` without data, which shares `schema` */
+    inline std::unique_ptr<Type> instantiate(const std::shared_ptr<const Schema>& schema);
+
+    /**
+     * Class representation for `Type`
+     * Specifically, `Type` could be `Primitive Data Types`, `Array of Any Type`, `Struct of Stacked Types`
+     */
+    class Type {
+    private:
+        friend class Primitive_Type;
+        friend class Array_Type;
+        friend class Struct_Type;
+        friend class Type_View;
+        friend class Column_View;
+    protected:
+        /**
+         * Shared and immutable description, so that cloning or instantiating `Type` only copies a pointer
+         */
+        std::shared_ptr<const Schema> schema;
+        /**
+         * Pointer to data chunk
+         */
+        void* data;
+        bool hold_or_possess; // true - hold | false - possess
+        Type* parent_type;
+        bool frozen;
+        /* Arena of long String and Blob values, which is `owned_arena` while possessing data */
+        String_Arena* arena;
+        std::unique_ptr<String_Arena> owned_arena;
+        /**
+         * For Struct Type
+         */
+        virtual void change_key(std::string target, std::string origin) = 0;
+        /* Rebuild `schema` after a component changes, which is propagated to upper side Type */
+        virtual void relayout() {
+            if (parent_type != nullptr) parent_type->relayout();
+        }
+
+        Type(const std::shared_ptr<const Schema>& _schema):schema(_schema), data(nullptr), hold_or_possess(true), parent_type(nullptr), frozen(false), arena(nullptr) {}
+        /* Changes of schema are rejected once this Type or any Type containing it is frozen */
+        void check_unfrozen(const char* operation) const {
+            for (const Type* type = this; type != nullptr; type = type->parent_type) {
+                if (type->frozen) throw std::invalid_argument(("Value Error: Cannot " + std::string(operation) + " of type '" + get_name() + "', which is frozen").c_str());
+            }
+        }
+        /* Setting checks the data type before data, while getting checks data first */
+        Status check_set(Primitive_Data_Types type) const {
+            if (schema->type_class != Type_Class::Primitive || schema->primitive_data_type != type) return Status::Type_Mismatch;
+            return data == nullptr ? Status::Null_Data : Status::Ok;
+        }
+        Status check_get(Primitive_Data_Types type) const {
+            if (data == nullptr) return Status::Null_Data;
+            return schema->type_class != Type_Class::Primitive || schema->primitive_data_type != type ? Status::Type_Mismatch : Status::Ok;
+        }
+        Status try_copy_in(Primitive_Data_Types type, const void* src, size_t size) {
+            Status status = check_set(type);
+            if (status == Status::Ok) memcpy(data, src, size);
+            return status;
+        }
+        Status try_copy_out(Primitive_Data_Types type, void* dst, size_t size) const {
+            Status status = check_get(type);
+            if (status == Status::Ok) memcpy(dst, data, size);
+            return status;
+        }
+        [[noreturn]] void throw_bytes_error(Status status, const char* operation) const {
+            DYNAMIC_STRUCT_COUNT(top_name(), Exceptions, 1);
+            if (status == Status::Null_Data && data == nullptr) throw std::invalid_argument(("Nullpointer Error: Cannot " + std::string(operation) + " null pointer of type '" + get_name() + "'").c_str());
+            if (status == Status::Null_Data) throw std::invalid_argument(("Nullpointer Error: Cannot " + std::string(operation) + " type '" + get_name() + "' without an arena for values over " + std::to_string(STRING_INLINE_BYTES) + " bytes").c_str());
+            if (status == Status::Out_Of_Range) throw std::out_of_range(("Value Error: Cannot " + std::string(operation) + " type '" + get_name() + "', whose value is over 4 GiB or outside its arena").c_str());
+            throw std::invalid_argument(("Value Error: Cannot " + std::string(operation) + " type '" + get_name() + "', whose data type is " + type()).c_str());
+        }
+        /* Name of the outermost Type, which instrumentation counters are attributed to */
+        const std::string& top_name() const {
+            const Type* top = this;
+            while (top->parent_type != nullptr) top = top->parent_type;
+            return top->schema->get_name();
+        }
+    public:
+        std::string type() const {
+            return schema->type();
+        }
+        const std::shared_ptr<const Schema>& get_Schema() const {
+            return schema;
+        }
+        /**
+         * Reject later changes of schema through this Type or its components, i.e. `set_name`, `append` and `set_Layout_Policy`
+         * The returned schema is what `Cursor` of every thread shares; data could still be changed.
+         */
+        const std::shared_ptr<const Schema>& freeze() {
+            frozen = true;
+            return schema;
+        }
+        bool is_frozen() const { return frozen; }
+        /* Cloning shares `schema` and never copies data */
+        virtual Type* clone() const = 0;
+        /* Return the Bytes of `Type` */
+        size_t size_of() const {
+            return schema->size_of();
+        }
+        /* Return the Bytes which the address of `Type` should be a multiple of */
+        size_t alignment_of() const {
+            return schema->alignment_of();
+        }
+        Type_Class get_Type_Class() const {
+            return schema->get_Type_Class();
+        }
+        /**
+         * For Struct Type
+         */
+        virtual Type& operator[](std::string key) = 0;
+        Type& get(std::string key) {
+            return (*this)[key];
+        }
+        /* Get names of components of Struct */
+        virtual std::vector<std::string> get_Keys() const = 0;
+        virtual Type& append(Type* type) = 0;
+        /* Get Bytes between the beginning of Struct and the property `key` */
+        virtual size_t get_Offset(std::string key) const = 0;
+        virtual Layout_Policy get_Layout_Policy() const = 0;
+        /* Change the layout of properties, which is only allowed without data */
+        virtual Type& set_Layout_Policy(Layout_Policy policy) = 0;
+        /**
+         * Resolve `path` into a `Field_Path`, which could be reused on the data of any instance of this type
+         * Keys of Struct are separated by `.` and positions of Array are wrapped by `[]`, e.g. "point_a.x" or "tensor[3][0][1]"
+         */
+        Field_Path compile_path(std::string path) const {
+            return schema->compile_path(path);
+        }
+        /**
+         * For Array Type
+         */
+        virtual std::unique_ptr<Type> operator[](size_t pos) = 0;
+        std::unique_ptr<Type> at(size_t pos) {
+            return (*this)[pos];
+        }
+        virtual Type& get_Element_Type() = 0;
+        /* Get Size of Array */
+        virtual size_t get_Size() const = 0;
+        /**
+         * For Primitive Type
+         */
+        /* Get Raw Primitive Type */
+        virtual Primitive_Data_Types get_Type() const = 0;
+        
+        /* `init` malloc a piece of memory to hold data, which will be deleted automatically if not used. */
+        virtual void init() {
+            release();
+            data = malloc(size_of());
+            DYNAMIC_STRUCT_COUNT(top_name(), Allocations, 1);
+            DYNAMIC_STRUCT_COUNT(top_name(), Allocated_Bytes, size_of());
+            if (data == nullptr) {
+                DYNAMIC_STRUCT_COUNT(top_name(), Exceptions, 1);
+                throw std::overflow_error(("Memory Error: Fail to allocate memory for type '" + get_name() + "'").c_str());
+            }
+            memset(data, 0, size_of());
+            hold_or_possess = false;
+            if (schema->has_Variable_Length()) {
+                if (owned_arena == nullptr) owned_arena.reset(new String_Arena());
+                owned_arena->clear();
+                arena = owned_arena.get();
+            }
+        }
+        /**
+         * `hold` will pass a pointer of data, which will not be deleted automatically if this object is not used.
+         * Long values of String and Blob in held data need the arena of their rows, given by `set_Arena`.
+         */
+        virtual void hold(void* _data) {
+            release();
+            data = _data;
+            hold_or_possess = true;
+        }
+        virtual void release() {
+            if (data != nullptr && hold_or_possess == false) free(data);
+            data = nullptr;
+            arena = nullptr;
+        }
+        void* get_data() { return data; }
+        /* Arena of long String and Blob values, which is the nearest one of this Type or the Types containing it */
+        String_Arena* get_Arena() const {
+            for (const Type* type = this; type != nullptr; type = type->parent_type) {
+                if (type->arena != nullptr) return type->arena;
+            }
+            return nullptr;
+        }
+        /* Let long String and Blob values of held data live in `_arena`, until data is held or released again */
+        void set_Arena(String_Arena* _arena) {
+            arena = _arena;
+        }
+        /* Non-owning view of current data, whose indexing never allocates */
+        Type_View view();
+        virtual ~Type() {
+            release();
+        }
+        
+        /* Notice that this function does not have type checking */
+        virtual void set(void* src) = 0;
+        virtual void set(int8_t src) = 0;
+        virtual void set(int16_t src) = 0;
+        virtual void set(int32_t src) = 0;
+        virtual void set(int64_t src) = 0;
+
+        virtual void set(uint8_t src) = 0;
+        virtual void set(uint16_t src) = 0;
+        virtual void set(uint32_t src) = 0;
+        virtual void set(uint64_t src) = 0;
+
+        virtual void set(char src) = 0;
+
+        virtual void set(float src) = 0;
+        virtual void set(double src) = 0;
+
+        virtual void set(bool src) = 0;
+
+        /* Useful Function, which will parse `src` automatically into appropriate internal data type */
+        virtual void set(std::string src) = 0;
+
+        virtual int8_t* get_Int_8() const = 0;
+        virtual int16_t* get_Int_16() const = 0;
+        virtual int32_t* get_Int_32() const = 0;
+        virtual int64_t* get_Int_64() const = 0;
+
+        virtual uint8_t* get_Unsigned_Int_8() const = 0;
+        virtual uint16_t* get_Unsigned_Int_16() const = 0;
+        virtual uint32_t* get_Unsigned_Int_32() const = 0;
+        virtual uint64_t* get_Unsigned_Int_64() const = 0;
+
+        virtual char* get_Char() const = 0;
+
+        virtual float* get_Float_32() const = 0;
+        virtual double* get_Float_64() const = 0;
+
+        virtual bool* get_Boolean() const = 0;
+
+        /**
+         * Non-throwing counterparts of `set`, `set(std::string)` and `get_X`, which report errors by `Status` without allocation
+         * `Type_Mismatch` is returned for Array, Struct or another Primitive Type, and `Null_Data` for Type without data.
+         * Data is left unchanged unless `Status::Ok` is returned.
+         */
+        Status try_set(int8_t src) { return try_copy_in(Primitive_Data_Types::Int_8, &src, sizeof(src)); }
+        Status try_set(int16_t src) { return try_copy_in(Primitive_Data_Types::Int_16, &src, sizeof(src)); }
+        Status try_set(int32_t src) { return try_copy_in(Primitive_Data_Types::Int_32, &src, sizeof(src)); }
+        Status try_set(int64_t src) { return try_copy_in(Primitive_Data_Types::Int_64, &src, sizeof(src)); }
+
+        Status try_set(uint8_t src) { return try_copy_in(Primitive_Data_Types::Unsigned_Int_8, &src, sizeof(src)); }
+        Status try_set(uint16_t src) { return try_copy_in(Primitive_Data_Types::Unsigned_Int_16, &src, sizeof(src)); }
+        Status try_set(uint32_t src) { return try_copy_in(Primitive_Data_Types::Unsigned_Int_32, &src, sizeof(src)); }
+        Status try_set(uint64_t src) { return try_copy_in(Primitive_Data_Types::Unsigned_Int_64, &src, sizeof(src)); }
+
+        Status try_set(char src) { return try_copy_in(Primitive_Data_Types::Char, &src, sizeof(src)); }
+
+        Status try_set(float src) { return try_copy_in(Primitive_Data_Types::Float_32, &src, sizeof(src)); }
+        Status try_set(double src) { return try_copy_in(Primitive_Data_Types::Float_64, &src, sizeof(src)); }
+
+        Status try_set(bool src) { return try_copy_in(Primitive_Data_Types::Boolean, &src, sizeof(src)); }
+        /* Parse [begin, end) as `parse_value` does, where integers out of range are `Out_Of_Range` instead of truncated */
+        Status try_parse(const char* begin, const char* end) {
+            DYNAMIC_STRUCT_COUNT(top_name(), Parses, 1);
+            if (schema->type_class != Type_Class::Primitive) return Status::Type_Mismatch;
+            if (data == nullptr) return Status::Null_Data;
+            // Only floats which need `strtod` use the scratch
+            static thread_local std::string scratch;
+            return parse_value(schema->primitive_data_type, begin, end, data, scratch, get_Arena());
+        }
+        Status try_parse(const std::string& src) {
+            return try_parse(src.data(), src.data() + src.length());
+        }
+
+        Status try_get(int8_t& dst) const { return try_copy_out(Primitive_Data_Types::Int_8, &dst, sizeof(dst)); }
+        Status try_get(int16_t& dst) const { return try_copy_out(Primitive_Data_Types::Int_16, &dst, sizeof(dst)); }
+        Status try_get(int32_t& dst) const { return try_copy_out(Primitive_Data_Types::Int_32, &dst, sizeof(dst)); }
+        Status try_get(int64_t& dst) const { return try_copy_out(Primitive_Data_Types::Int_64, &dst, sizeof(dst)); }
+
+        Status try_get(uint8_t& dst) const { return try_copy_out(Primitive_Data_Types::Unsigned_Int_8, &dst, sizeof(dst)); }
+        Status try_get(uint16_t& dst) const { return try_copy_out(Primitive_Data_Types::Unsigned_Int_16, &dst, sizeof(dst)); }
+        Status try_get(uint32_t& dst) const { return try_copy_out(Primitive_Data_Types::Unsigned_Int_32, &dst, sizeof(dst)); }
+        Status try_get(uint64_t& dst) const { return try_copy_out(Primitive_Data_Types::Unsigned_Int_64, &dst, sizeof(dst)); }
+
+        Status try_get(char& dst) const { return try_copy_out(Primitive_Data_Types::Char, &dst, sizeof(dst)); }
+
+        Status try_get(float& dst) const { return try_copy_out(Primitive_Data_Types::Float_32, &dst, sizeof(dst)); }
+        Status try_get(double& dst) const { return try_copy_out(Primitive_Data_Types::Float_64, &dst, sizeof(dst)); }
+
+        Status try_get(bool& dst) const { return try_copy_out(Primitive_Data_Types::Boolean, &dst, sizeof(dst)); }
+
+        /**
+         * For String and Blob Type
+         * Values are copied in as bytes, and long values are appended to the arena of `get_Arena`.
+         * Values read out point into the data or the arena, which are invalidated by the next change of either.
+         */
+        Status try_set_bytes(const void* src, size_t length) {
+            if (schema->type_class != Type_Class::Primitive || !is_variable_length(schema->primitive_data_type)) return Status::Type_Mismatch;
+            if (data == nullptr) return Status::Null_Data;
+            return store_string(data, src, length, get_Arena());
+        }
+        Status try_get_bytes(String_Ref& dst) const {
+            if (data == nullptr) return Status::Null_Data;
+            if (schema->type_class != Type_Class::Primitive || !is_variable_length(schema->primitive_data_type)) return Status::Type_Mismatch;
+            return load_string(data, get_Arena(), dst);
+        }
+        void set_bytes(const void* src, size_t length) {
+            Status status = try_set_bytes(src, length);
+            if (status != Status::Ok) throw_bytes_error(status, "set bytes to");
+        }
+        String_Ref get_bytes() const {
+            String_Ref value;
+            Status status = try_get_bytes(value);
+            if (status != Status::Ok) throw_bytes_error(status, "get bytes from");
+            return value;
+        }
+
+        Type* set_name(std::string _name) {
+            if (!Schema::check_name(_name)) throw std::invalid_argument(("Value Error: Cannot assign name '" + _name + "' to type").c_str());
+            check_unfrozen("change name");
+            // Change Upper side Type
+            if (parent_type != nullptr && parent_type->get_Type_Class() == Type_Class::Struct) {
+                parent_type->change_key(_name, get_name());
+            }
+            schema = schema->rename(_name);
+            if (parent_type != nullptr) parent_type->relayout();
+            return this;
+        }
+        std::string get_name() const {
+            return schema->get_name();
+        }
+
+        virtual std::string string() const = 0;
+
+        friend std::ostream& operator<< (std::ostream& stream, const Type& operand) {
+            stream << operand.string();
+            return stream;
         }
 
         friend std::istream& operator>> (std::istream& stream, Type& operand) {
@@ -248,76 +1477,79 @@ namespace dynamic_struct {
         }
     };
 
-    #define GET_POINTER_MACRO(pointer_type, type_name) if (this->data == nullptr) {\
-                throw std::invalid_argument(("Nullpointer Error: Cannot turn null pointer into " + std::string(#type_name) + " pointer of type '" + name + "'").c_str());\
-            }\
-            if (this->primitive_data_type != Primitive_Data_Types::type_name) {\
-                throw std::invalid_argument(("Value Error: Cannot get " + std::string(#type_name) + " pointer from type '" + name + "', whose data type is " + type()).c_str());\
-            }\
+    #define GET_POINTER_MACRO(pointer_type, type_name) Status status = check_get(Primitive_Data_Types::type_name);\
+            if (status != Status::Ok) throw_get_error(status, #type_name);\
             return static_cast<pointer_type*>(data);
     
-    #define SET_MACRO(type_name) if (this->primitive_data_type != Primitive_Data_Types::type_name) {\
-                throw std::invalid_argument(("Value Error: Cannot set " + std::string(#type_name) + " to type '" + name + "', whose data type is " + type()).c_str());\
-            }\
-            set(static_cast<void*>(&src));
+    #define SET_MACRO(type_name) Status status = try_set(src);\
+            if (status != Status::Ok) throw_set_error(status, #type_name);
 
     class Primitive_Type: public Type {
     private:
+        friend class Type_View;
+        /* Cached from `schema`, which is checked on every access */
         Primitive_Data_Types primitive_data_type;
-    protected:
-        virtual std::string _type(std::string prefix, bool with_name) const {
-            std::string suffix = with_name == true ? " " + name : "";
-            return prefix + get_string_from_type(primitive_data_type) + suffix;
+
+        /* Throw the error of `status` reported by `try_set` or `check_get` for `type_name` */
+        void throw_set_error(Status status, const char* type_name) const {
+            DYNAMIC_STRUCT_COUNT(top_name(), Exceptions, 1);
+            if (status == Status::Null_Data) throw std::invalid_argument(("Nullpointer Error: Cannot set to null pointer of type '" + get_name() + "'").c_str());
+            throw std::invalid_argument(("Value Error: Cannot set " + std::string(type_name) + " to type '" + get_name() + "', whose data type is " + type()).c_str());
+        }
+        void throw_get_error(Status status, const char* type_name) const {
+            DYNAMIC_STRUCT_COUNT(top_name(), Exceptions, 1);
+            if (status == Status::Null_Data) throw std::invalid_argument(("Nullpointer Error: Cannot turn null pointer into " + std::string(type_name) + " pointer of type '" + get_name() + "'").c_str());
+            throw std::invalid_argument(("Value Error: Cannot get " + std::string(type_name) + " pointer from type '" + get_name() + "', whose data type is " + type()).c_str());
+        }
+        void throw_parse_error(Status status, const std::string& src) const {
+            DYNAMIC_STRUCT_COUNT(top_name(), Exceptions, 1);
+            if (status == Status::Null_Data) throw_bytes_error(status, "set to");
+            if (status == Status::Out_Of_Range) throw std::out_of_range(("Value Error: Cannot set " + src + ", which is out of range, into " + get_string_from_type(primitive_data_type) + " type '" + get_name() + "'").c_str());
+            if (primitive_data_type == Primitive_Data_Types::Char) throw std::invalid_argument(("Value Error: Cannot set string, whose length is not 1, into Char type '" + get_name() + "'").c_str());
+            throw std::invalid_argument(("Value Error: Cannot set " + src + " into " + get_string_from_type(primitive_data_type) + " type '" + get_name() + "'").c_str());
         }
+    protected:
         virtual void change_key(std::string target, std::string origin) {
-            throw std::invalid_argument(("Compile Error: Cannot change key of a Primitive Type '" + name + "'").c_str());
+            throw std::invalid_argument(("Compile Error: Cannot change key of a Primitive Type '" + get_name() + "'").c_str());
         }
     public:
-        Primitive_Type(Primitive_Data_Types type, std::string name):primitive_data_type(type), Type(Type_Class::Primitive, name) {}
+        Primitive_Type(Primitive_Data_Types type, std::string name):Type(Schema::make_Primitive(type, name)), primitive_data_type(type) {}
+        explicit Primitive_Type(const std::shared_ptr<const Schema>& _schema):Type(_schema), primitive_data_type(_schema->get_Type()) {}
         virtual Primitive_Type* clone() const {
-            return new Primitive_Type(primitive_data_type, name);
-        }
-        virtual size_t size_of() const {
-            switch (primitive_data_type) {
-            case Primitive_Data_Types::Int_8: return sizeof(int8_t);
-            case Primitive_Data_Types::Int_16: return sizeof(int16_t);
-            case Primitive_Data_Types::Int_32: return sizeof(int32_t);
-            case Primitive_Data_Types::Int_64: return sizeof(int64_t);
-
-            case Primitive_Data_Types::Unsigned_Int_8: return sizeof(uint8_t);
-            case Primitive_Data_Types::Unsigned_Int_16: return sizeof(uint16_t);
-            case Primitive_Data_Types::Unsigned_Int_32: return sizeof(uint32_t);
-            case Primitive_Data_Types::Unsigned_Int_64: return sizeof(uint64_t);
-
-            case Primitive_Data_Types::Char: return sizeof(char);
-
-            case Primitive_Data_Types::Boolean: return sizeof(bool);
-
-            case Primitive_Data_Types::Float_32: return sizeof(float);
-            case Primitive_Data_Types::Float_64: return sizeof(double);
-            }
+            DYNAMIC_STRUCT_COUNT(top_name(), Clones, 1);
+            return new Primitive_Type(schema);
         }
         virtual Type& operator[](std::string key) {
-            throw std::invalid_argument(("Compile Error: Primitive_Type '" + name + "' cannot be indexed with `key`").c_str());
+            throw std::invalid_argument(("Compile Error: Primitive_Type '" + get_name() + "' cannot be indexed with `key`").c_str());
         }
         virtual std::unique_ptr<Type> operator[](size_t pos) {
-            throw std::invalid_argument(("Compile Error: Primitive_Type '" + name + "'cannot be indexed with `pos`").c_str());
+            throw std::invalid_argument(("Compile Error: Primitive_Type '" + get_name() + "'cannot be indexed with `pos`").c_str());
         }
         virtual size_t get_Size() const {
-            throw std::invalid_argument(("Compile Error: Cannot get size of Primitive Type '" + name + "'").c_str());
+            throw std::invalid_argument(("Compile Error: Cannot get size of Primitive Type '" + get_name() + "'").c_str());
         }
         virtual Type& get_Element_Type() {
-            throw std::invalid_argument(("Compile Error: Cannot get Element Type of Primitive Type '" + name + "'").c_str());
+            throw std::invalid_argument(("Compile Error: Cannot get Element Type of Primitive Type '" + get_name() + "'").c_str());
         }
         virtual std::vector<std::string> get_Keys() const {
-            throw std::invalid_argument(("Compile Error: Cannot get keys of Primitive Type '" + name + "'").c_str());
+            throw std::invalid_argument(("Compile Error: Cannot get keys of Primitive Type '" + get_name() + "'").c_str());
         }
         virtual Type& append(Type* type) {
-            throw std::invalid_argument(("Compile Error: Cannot append to Primitive Type '" + name + "'").c_str());
+            throw std::invalid_argument(("Compile Error: Cannot append to Primitive Type '" + get_name() + "'").c_str());
+        }
+        virtual size_t get_Offset(std::string key) const {
+            throw std::invalid_argument(("Compile Error: Cannot get offset of key in Primitive Type '" + get_name() + "'").c_str());
+        }
+        virtual Layout_Policy get_Layout_Policy() const {
+            throw std::invalid_argument(("Compile Error: Cannot get layout policy of Primitive Type '" + get_name() + "'").c_str());
+        }
+        virtual Type& set_Layout_Policy(Layout_Policy policy) {
+            throw std::invalid_argument(("Compile Error: Cannot set layout policy of Primitive Type '" + get_name() + "'").c_str());
         }
         virtual void set(void* src) {
             if (this->data == nullptr) {
-                throw std::invalid_argument(("Nullpointer Error: Cannot set to null pointer of type '" + name + "'").c_str());
+                DYNAMIC_STRUCT_COUNT(top_name(), Exceptions, 1);
+                throw std::invalid_argument(("Nullpointer Error: Cannot set to null pointer of type '" + get_name() + "'").c_str());
             }
             memcpy(data, src, size_of());
         }
@@ -363,75 +1595,8 @@ namespace dynamic_struct {
         }
 
         virtual void set(std::string src) {
-            switch (primitive_data_type) {
-            case Primitive_Data_Types::Int_8: {
-                int src_data = std::stoi(src);
-                set(static_cast<int8_t>(src_data));
-                break;
-            }
-            case Primitive_Data_Types::Int_16: {
-                int src_data = std::stoi(src);
-                set(static_cast<int16_t>(src_data));
-                break;
-            }
-            case Primitive_Data_Types::Int_32: {
-                int src_data = std::stoi(src);
-                set(static_cast<int32_t>(src_data));
-                break;
-            }
-            case Primitive_Data_Types::Int_64: {
-                int64_t src_data = std::stoll(src);
-                set(src_data);
-                break;
-            }
-            case Primitive_Data_Types::Unsigned_Int_8: {
-                unsigned long src_data = std::stoul(src);
-                set(static_cast<uint8_t>(src_data));
-                break;
-            }
-            case Primitive_Data_Types::Unsigned_Int_16: {
-                unsigned long src_data = std::stoul(src);
-                set(static_cast<uint16_t>(src_data));
-                break;
-            }
-            case Primitive_Data_Types::Unsigned_Int_32: {
-                unsigned long src_data = std::stoul(src);
-                set(static_cast<uint32_t>(src_data));
-                break;
-            }
-            case Primitive_Data_Types::Unsigned_Int_64: {
-                unsigned long long src_data = std::stoull(src);
-                set(static_cast<uint64_t>(src_data));
-                break;
-            }
-            case Primitive_Data_Types::Char: {
-                if (src.size() != 1) {
-                    throw std::invalid_argument(("Value Error: Cannot set string, whose length is not 1, into Char type '" + name + "'").c_str());
-                }
-                set(src[0]);
-                break;
-            }
-            case Primitive_Data_Types::Boolean: {
-                if (src == "true") {
-                    set(true);
-                } else if (src == "false") {
-                    set(false);
-                } else {
-                    throw std::invalid_argument(("Value Error: Cannot set " + src + " into Boolean type '" + name + "'").c_str());
-                }
-                break;
-            }
-            case Primitive_Data_Types::Float_32: {
-                float src_data = std::stof(src);
-                set(src_data);
-                break;
-            }
-            case Primitive_Data_Types::Float_64: {
-                double src_data = std::stod(src);
-                set(src_data);
-                break;
-            }
-            }
+            Status status = try_parse(src);
+            if (status != Status::Ok) throw_parse_error(status, src);
         }
 
         virtual int8_t* get_Int_8() const {
@@ -482,22 +1647,15 @@ namespace dynamic_struct {
         virtual std::string string() const {
             if (data == nullptr) return "<void>";
             switch (primitive_data_type) {
-            case Primitive_Data_Types::Int_8: return std::to_string(*get_Int_8());
-            case Primitive_Data_Types::Int_16: return std::to_string(*get_Int_16());
-            case Primitive_Data_Types::Int_32: return std::to_string(*get_Int_32());
-            case Primitive_Data_Types::Int_64: return std::to_string(*get_Int_64());
-
-            case Primitive_Data_Types::Unsigned_Int_8: return std::to_string(*get_Unsigned_Int_8());
-            case Primitive_Data_Types::Unsigned_Int_16: return std::to_string(*get_Unsigned_Int_16());
-            case Primitive_Data_Types::Unsigned_Int_32: return std::to_string(*get_Unsigned_Int_32());
-            case Primitive_Data_Types::Unsigned_Int_64: return std::to_string(*get_Unsigned_Int_64());
-
-            case Primitive_Data_Types::Char: return std::string(1, *get_Char());
-
-            case Primitive_Data_Types::Boolean: return *get_Boolean() == true ? "true" : "false";
-
-            case Primitive_Data_Types::Float_32: return std::to_string(*get_Float_32());
-            case Primitive_Data_Types::Float_64: return std::to_string(*get_Float_64());
+            case Primitive_Data_Types::String: return get_bytes().str();
+            case Primitive_Data_Types::Blob: {
+                String_Ref value = get_bytes();
+                std::string text(value.length * 2, '\0');
+                format_hex(&text[0], value.data, value.length);
+                return text;
+            }
+            default:
+                return _primitive_string(primitive_data_type, data);
             }
         }
     };
@@ -567,147 +1725,177 @@ namespace dynamic_struct {
     }
     #define Float_64(name) _Float_64(name).get()
 
+    inline std::unique_ptr<Primitive_Type> _String(std::string name = "") {
+        return std::unique_ptr<Primitive_Type>(new Primitive_Type(Primitive_Data_Types::String, name));
+    }
+    #define String(name) _String(name).get()
+
+    inline std::unique_ptr<Primitive_Type> _Blob(std::string name = "") {
+        return std::unique_ptr<Primitive_Type>(new Primitive_Type(Primitive_Data_Types::Blob, name));
+    }
+    #define Blob(name) _Blob(name).get()
+
     class Array_Type: public Type {
     private:
-        Type* element_type;
-        size_t size;
+        /* Materialized on demand by `get_Element_Type`, which never holds data */
+        std::unique_ptr<Type> element_type;
     protected:
-        virtual std::string _type(std::string prefix, bool with_name) const {
-            return prefix + "[" + std::to_string(size) + "]" + element_type->_type("", false) + (with_name == true? " " + name: "");
-        }
         virtual void change_key(std::string target, std::string origin) {
-            throw std::invalid_argument(("Compile Error: Cannot change key of an Array Type '" + name + "'").c_str());
+            throw std::invalid_argument(("Compile Error: Cannot change key of an Array Type '" + get_name() + "'").c_str());
+        }
+        virtual void relayout() {
+            schema = Schema::make_Array(schema->get_Size(), element_type != nullptr ? element_type->get_Schema() : schema->get_Element(), get_name());
+            Type::relayout();
         }
     public:
-        Array_Type(size_t _size, const Type* type, std::string name):size(_size), element_type(type->clone()), Type(Type_Class::Array, name) {
-            element_type->parent_type = this;
+        Array_Type(size_t _size, const Type* type, std::string name):Type(Schema::make_Array(_size, type->get_Schema(), name)) {}
+        explicit Array_Type(const std::shared_ptr<const Schema>& _schema):Type(_schema) {
+            _schema->get_Element();
         }
-        ~Array_Type() { delete element_type; }
         virtual Array_Type* clone() const {
-            return new Array_Type(size, element_type, name);
-        }
-        virtual size_t size_of() const {
-            return element_type->size_of() * size;
+            DYNAMIC_STRUCT_COUNT(top_name(), Clones, 1);
+            return new Array_Type(schema);
         }
         virtual Type& operator[](std::string key) {
-            throw std::invalid_argument(("Compile Error: Array_Type '" + name + "' cannot be indexed with string `key`").c_str());
+            throw std::invalid_argument(("Compile Error: Array_Type '" + get_name() + "' cannot be indexed with string `key`").c_str());
         }
         virtual std::unique_ptr<Type> operator[](size_t pos) {
-            if (data == NULL) throw std::invalid_argument(("Nullpointer Error: Cannot index into null pointer of type '" + name + "'").c_str());
+            DYNAMIC_STRUCT_COUNT(top_name(), Element_Views, 1);
+            if (data == NULL) {
+                DYNAMIC_STRUCT_COUNT(top_name(), Exceptions, 1);
+                throw std::invalid_argument(("Nullpointer Error: Cannot index into null pointer of type '" + get_name() + "'").c_str());
+            }
             // Check for length
-            if (pos >= size) throw std::out_of_range(("Index Error: Cannot index over the length of type '" + name + "'").c_str());
-            void* shifted_data = static_cast<void*>(static_cast<char*>(data) + element_type->size_of() * pos);
-            Type* ptr = element_type->clone();
+            if (pos >= schema->get_Size()) {
+                DYNAMIC_STRUCT_COUNT(top_name(), Exceptions, 1);
+                throw std::out_of_range(("Index Error: Cannot index over the length of type '" + get_name() + "'").c_str());
+            }
+            const std::shared_ptr<const Schema>& element = schema->get_Element();
+            void* shifted_data = static_cast<void*>(static_cast<char*>(data) + element->size_of() * pos);
+            std::unique_ptr<Type> ptr = instantiate(element);
             ptr->parent_type = this;
             ptr->hold(shifted_data);
-            return std::unique_ptr<Type>(ptr);
+            return ptr;
         }
         virtual size_t get_Size() const {
-            return size;
+            return schema->get_Size();
         }
         virtual Type& get_Element_Type() {
+            if (element_type == nullptr) {
+                element_type = instantiate(schema->get_Element());
+                element_type->parent_type = this;
+            }
             return *element_type;
         }
         virtual std::vector<std::string> get_Keys() const {
-            throw std::invalid_argument(("Compile Error: Cannot get keys of Array Type '" + name + "'").c_str());
+            throw std::invalid_argument(("Compile Error: Cannot get keys of Array Type '" + get_name() + "'").c_str());
         }
         virtual Type& append(Type* type) {
-            throw std::invalid_argument(("Compile Error: Cannot append to Array Type '" + name + "'").c_str());
+            throw std::invalid_argument(("Compile Error: Cannot append to Array Type '" + get_name() + "'").c_str());
+        }
+        virtual size_t get_Offset(std::string key) const {
+            throw std::invalid_argument(("Compile Error: Cannot get offset of key in Array Type '" + get_name() + "'").c_str());
+        }
+        virtual Layout_Policy get_Layout_Policy() const {
+            throw std::invalid_argument(("Compile Error: Cannot get layout policy of Array Type '" + get_name() + "'").c_str());
+        }
+        virtual Type& set_Layout_Policy(Layout_Policy policy) {
+            throw std::invalid_argument(("Compile Error: Cannot set layout policy of Array Type '" + get_name() + "'").c_str());
         }
         virtual void set(void* src) {
-            throw std::invalid_argument(("Compile Error: Cannot set directly to data of Array type '" + name + "'").c_str());
+            throw std::invalid_argument(("Compile Error: Cannot set directly to data of Array type '" + get_name() + "'").c_str());
         }
         virtual void set(int8_t src) {
-            throw std::invalid_argument(("Compile Error: Cannot set directly to data of Array type '" + name + "'").c_str());
+            throw std::invalid_argument(("Compile Error: Cannot set directly to data of Array type '" + get_name() + "'").c_str());
         }
         virtual void set(int16_t src) {
-            throw std::invalid_argument(("Compile Error: Cannot set directly to data of Array type '" + name + "'").c_str());
+            throw std::invalid_argument(("Compile Error: Cannot set directly to data of Array type '" + get_name() + "'").c_str());
         }
         virtual void set(int32_t src) {
-            throw std::invalid_argument(("Compile Error: Cannot set directly to data of Array type '" + name + "'").c_str());
+            throw std::invalid_argument(("Compile Error: Cannot set directly to data of Array type '" + get_name() + "'").c_str());
         }
         virtual void set(int64_t src) {
-            throw std::invalid_argument(("Compile Error: Cannot set directly to data of Array type '" + name + "'").c_str());
+            throw std::invalid_argument(("Compile Error: Cannot set directly to data of Array type '" + get_name() + "'").c_str());
         }
 
         virtual void set(uint8_t src) {
-            throw std::invalid_argument(("Compile Error: Cannot set directly to data of Array type '" + name + "'").c_str());
+            throw std::invalid_argument(("Compile Error: Cannot set directly to data of Array type '" + get_name() + "'").c_str());
         }
         virtual void set(uint16_t src) {
-            throw std::invalid_argument(("Compile Error: Cannot set directly to data of Array type '" + name + "'").c_str());
+            throw std::invalid_argument(("Compile Error: Cannot set directly to data of Array type '" + get_name() + "'").c_str());
         }
         virtual void set(uint32_t src) {
-            throw std::invalid_argument(("Compile Error: Cannot set directly to data of Array type '" + name + "'").c_str());
+            throw std::invalid_argument(("Compile Error: Cannot set directly to data of Array type '" + get_name() + "'").c_str());
         }
         virtual void set(uint64_t src) {
-            throw std::invalid_argument(("Compile Error: Cannot set directly to data of Array type '" + name + "'").c_str());
+            throw std::invalid_argument(("Compile Error: Cannot set directly to data of Array type '" + get_name() + "'").c_str());
         }
 
         virtual void set(char src) {
-            throw std::invalid_argument(("Compile Error: Cannot set directly to data of Array type '" + name + "'").c_str());
+            throw std::invalid_argument(("Compile Error: Cannot set directly to data of Array type '" + get_name() + "'").c_str());
         }
 
         virtual void set(float src) {
-            throw std::invalid_argument(("Compile Error: Cannot set directly to data of Array type '" + name + "'").c_str());
+            throw std::invalid_argument(("Compile Error: Cannot set directly to data of Array type '" + get_name() + "'").c_str());
         }
         virtual void set(double src) {
-            throw std::invalid_argument(("Compile Error: Cannot set directly to data of Array type '" + name + "'").c_str());
+            throw std::invalid_argument(("Compile Error: Cannot set directly to data of Array type '" + get_name() + "'").c_str());
         }
 
         virtual void set(bool src) {
-            throw std::invalid_argument(("Compile Error: Cannot set directly to data of Array type '" + name + "'").c_str());
+            throw std::invalid_argument(("Compile Error: Cannot set directly to data of Array type '" + get_name() + "'").c_str());
         }
 
         virtual void set(std::string src) {
-            throw std::invalid_argument(("Compile Error: Cannot set directly to data of Array type '" + name + "'").c_str());
+            throw std::invalid_argument(("Compile Error: Cannot set directly to data of Array type '" + get_name() + "'").c_str());
         }
         virtual int8_t* get_Int_8() const {
-            throw std::invalid_argument(("Compile Error: Cannot get data directly of Array type '" + name + "'").c_str());
+            throw std::invalid_argument(("Compile Error: Cannot get data directly of Array type '" + get_name() + "'").c_str());
         }
         virtual int16_t* get_Int_16() const {
-            throw std::invalid_argument(("Compile Error: Cannot get data directly of Array type '" + name + "'").c_str());
+            throw std::invalid_argument(("Compile Error: Cannot get data directly of Array type '" + get_name() + "'").c_str());
         }
         virtual int32_t* get_Int_32() const {
-            throw std::invalid_argument(("Compile Error: Cannot get data directly of Array type '" + name + "'").c_str());
+            throw std::invalid_argument(("Compile Error: Cannot get data directly of Array type '" + get_name() + "'").c_str());
         }
         virtual int64_t* get_Int_64() const {
-            throw std::invalid_argument(("Compile Error: Cannot get data directly of Array type '" + name + "'").c_str());
+            throw std::invalid_argument(("Compile Error: Cannot get data directly of Array type '" + get_name() + "'").c_str());
         }
 
         virtual uint8_t* get_Unsigned_Int_8() const {
-            throw std::invalid_argument(("Compile Error: Cannot get data directly of Array type '" + name + "'").c_str());
+            throw std::invalid_argument(("Compile Error: Cannot get data directly of Array type '" + get_name() + "'").c_str());
         }
         virtual uint16_t* get_Unsigned_Int_16() const {
-            throw std::invalid_argument(("Compile Error: Cannot get data directly of Array type '" + name + "'").c_str());
+            throw std::invalid_argument(("Compile Error: Cannot get data directly of Array type '" + get_name() + "'").c_str());
         }
         virtual uint32_t* get_Unsigned_Int_32() const {
-            throw std::invalid_argument(("Compile Error: Cannot get data directly of Array type '" + name + "'").c_str());
+            throw std::invalid_argument(("Compile Error: Cannot get data directly of Array type '" + get_name() + "'").c_str());
         }
         virtual uint64_t* get_Unsigned_Int_64() const {
-            throw std::invalid_argument(("Compile Error: Cannot get data directly of Array type '" + name + "'").c_str());
+            throw std::invalid_argument(("Compile Error: Cannot get data directly of Array type '" + get_name() + "'").c_str());
         }
 
         virtual char* get_Char() const {
-            throw std::invalid_argument(("Compile Error: Cannot get data directly of Array type '" + name + "'").c_str());
+            throw std::invalid_argument(("Compile Error: Cannot get data directly of Array type '" + get_name() + "'").c_str());
         }
 
         virtual float* get_Float_32() const {
-            throw std::invalid_argument(("Compile Error: Cannot get data directly of Array type '" + name + "'").c_str());
+            throw std::invalid_argument(("Compile Error: Cannot get data directly of Array type '" + get_name() + "'").c_str());
         }
         virtual double* get_Float_64() const {
-            throw std::invalid_argument(("Compile Error: Cannot get data directly of Array type '" + name + "'").c_str());
+            throw std::invalid_argument(("Compile Error: Cannot get data directly of Array type '" + get_name() + "'").c_str());
         }
 
         virtual bool* get_Boolean() const {
-            throw std::invalid_argument(("Compile Error: Cannot get data directly of Array type '" + name + "'").c_str());
+            throw std::invalid_argument(("Compile Error: Cannot get data directly of Array type '" + get_name() + "'").c_str());
         }
 
         virtual Primitive_Data_Types get_Type() const {
-            throw std::invalid_argument(("Compile Error: Cannot get raw primitive data type directly of Array type '" + name + "'").c_str());
+            throw std::invalid_argument(("Compile Error: Cannot get raw primitive data type directly of Array type '" + get_name() + "'").c_str());
         }
 
         virtual std::string string() const {
-            throw std::invalid_argument(("Compile Error: Cannot turn data of Array type '" + name + "' into string directly").c_str());
+            throw std::invalid_argument(("Compile Error: Cannot turn data of Array type '" + get_name() + "' into string directly").c_str());
         }
     };
     inline std::unique_ptr<Array_Type> _Array_Type(size_t _size, const Type* type, std::string name) {
@@ -725,381 +1913,5079 @@ namespace dynamic_struct {
 
     class Struct_Type: public Type {
     private:
-        std::vector<Type*> types;
-        std::vector<std::string> keys;
-        std::map<std::string, size_t> type_name_to_pos;
-        std::map<std::string, size_t> type_name_to_offset;
-    protected:
-        virtual std::string _type(std::string prefix, bool with_name) const {
-            std::string str = prefix + (with_name == true? name + " " : "") + "{\n";
-            for (size_t index = 0; index < types.size(); ++index) {
-                str += prefix + types[index]->_type("    ", true);
-                if (index != types.size() - 1) str += ", \n";
-                else str += "\n";
-            }
-            str += prefix + "}";
-            return str;
+        /* Properties are materialized on demand by `child`, so that instantiating Struct only copies `schema` */
+        std::vector<std::unique_ptr<Type>> children;
+
+        Type& child(size_t pos) {
+            if (children.size() < schema->get_Field_Count()) children.resize(schema->get_Field_Count());
+            if (children[pos] == nullptr) {
+                children[pos] = instantiate(schema->get_Field(pos));
+                children[pos]->parent_type = this;
+                if (data != nullptr) children[pos]->hold(static_cast<char*>(data) + schema->get_Field_Offset(pos));
+            }
+            return *children[pos];
+        }
+        /* Schemas of properties, where materialized properties might have been changed */
+        std::vector<std::shared_ptr<const Schema>> current_fields() const {
+            std::vector<std::shared_ptr<const Schema>> fields;
+            fields.reserve(schema->get_Field_Count());
+            for (size_t pos = 0; pos < schema->get_Field_Count(); ++pos) {
+                fields.push_back(pos < children.size() && children[pos] != nullptr ? children[pos]->get_Schema() : schema->get_Field(pos));
+            }
+            return fields;
+        }
+        void rebind() {
+            for (size_t pos = 0; pos < children.size(); ++pos) {
+                if (children[pos] != nullptr) children[pos]->hold(static_cast<char*>(data) + schema->get_Field_Offset(pos));
+            }
         }
+        static std::vector<std::shared_ptr<const Schema>> schemas_of(const std::vector<Type*>& types) {
+            std::vector<std::shared_ptr<const Schema>> fields;
+            fields.reserve(types.size());
+            for (Type* type : types) fields.push_back(type->get_Schema());
+            return fields;
+        }
+    protected:
         virtual void change_key(std::string target, std::string origin) {
-            auto iter = std::find(keys.begin(), keys.end(), origin);
-            if (iter == keys.end()) {
-                throw std::invalid_argument(("Value Error: Cannot find key '" + origin + "' in Struct Type '" + name + "' for replacement").c_str());
+            if (schema->find(origin) == Schema::npos) {
+                throw std::invalid_argument(("Value Error: Cannot find key '" + origin + "' in Struct Type '" + get_name() + "' for replacement").c_str());
             }
-            if (std::find(keys.begin(), keys.end(), target) != keys.end()) {
-                throw std::invalid_argument(("Value Error: Cannot change a name of property into an existing one '" + target + "' in Struct Type '" + name + "'").c_str());
+            if (schema->find(target) != Schema::npos) {
+                throw std::invalid_argument(("Value Error: Cannot change a name of property into an existing one '" + target + "' in Struct Type '" + get_name() + "'").c_str());
             }
-            *iter = target;
-            type_name_to_pos[target] = type_name_to_pos[origin];
-            type_name_to_offset[target] = type_name_to_offset[origin];
-
-            type_name_to_pos.erase(origin);
-            type_name_to_offset.erase(origin);
+        }
+        virtual void relayout() {
+            schema = Schema::make_Struct(current_fields(), get_name(), schema->get_Layout_Policy());
+            Type::relayout();
         }
     public:
         /**
          * Sub-variables is arranged corresponding to its position in `_types`.
          */
-        Struct_Type(const std::initializer_list<Type*> _types, std::string name):Struct_Type(std::vector<Type*>(_types), name) {}
+        Struct_Type(const std::initializer_list<Type*> _types, std::string name, Layout_Policy policy = Layout_Policy::Packed):Struct_Type(std::vector<Type*>(_types), name, policy) {}
         /**
          * Sub-variables is arranged corresponding to its position in `_types`.
          */
-        Struct_Type(const std::vector<Type*> _types, std::string name):Type(Type_Class::Struct, name) {
-            types.resize(_types.size(), nullptr);
-            keys.resize(_types.size(), "");
-            size_t offset = 0;
-            for (size_t index = 0; index < _types.size(); ++index) {
-                // Check for Duplication
-                if (type_name_to_pos.find(_types[index]->name) != type_name_to_pos.end()) {
-                    throw std::invalid_argument(("Value Error: Cannot set duplicate property with name '" + _types[index]->name + "' in type '" + name + "'").c_str());
-                }
-
-                types.at(index) = _types[index]->clone();
-                types.at(index)->parent_type = this;
-                keys.at(index) = types.at(index)->name;
-
-                type_name_to_pos[types.at(index)->name] = index;
-                type_name_to_offset[types.at(index)->name] = offset;
-                offset += types.at(index)->size_of();
-            }
-        }
-        ~Struct_Type() {
-            for (Type* type : types) delete type;
+        Struct_Type(const std::vector<Type*> _types, std::string name, Layout_Policy policy = Layout_Policy::Packed):Type(Schema::make_Struct(schemas_of(_types), name, policy)) {}
+        explicit Struct_Type(const std::shared_ptr<const Schema>& _schema):Type(_schema) {
+            _schema->get_Field_Count();
         }
         virtual Struct_Type* clone() const {
-            return new Struct_Type(types, name);
-        }
-        virtual size_t size_of() const {
-            size_t sum = 0;
-            for (Type* type : types) sum += type->size_of();
-            return sum;
+            DYNAMIC_STRUCT_COUNT(top_name(), Clones, 1);
+            return new Struct_Type(schema);
         }
         virtual void init() {
             Type::init();
-            for (size_t index = 0; index < types.size(); ++index) {
-                size_t offset = type_name_to_offset[types[index]->name];
-                types[index]->hold(static_cast<void*>(static_cast<char*>(data) + offset));
-            }
+            rebind();
         }
         virtual void hold(void* _data) {
             Type::hold(_data);
-            for (size_t index = 0; index < types.size(); ++index) {
-                size_t offset = type_name_to_offset[types[index]->name];
-                types[index]->hold(static_cast<void*>(static_cast<char*>(data) + offset));
-            }
+            rebind();
         }
         virtual void release() {
             Type::release();
-            for (size_t index = 0; index < types.size(); ++index) {
-                types[index]->release();
+            for (std::unique_ptr<Type>& type : children) {
+                if (type != nullptr) type->release();
             }
         }
         virtual Type& operator[](std::string key) {
-            if (type_name_to_pos.find(key) == type_name_to_pos.end()) {
-                throw std::invalid_argument(("Value Error: Cannot find key '" + key + "' in type '" + name + "'").c_str());
+            DYNAMIC_STRUCT_COUNT(top_name(), Key_Lookups, 1);
+            size_t pos = schema->find(key);
+            if (pos == Schema::npos) {
+                DYNAMIC_STRUCT_COUNT(top_name(), Exceptions, 1);
+                throw std::invalid_argument(("Value Error: Cannot find key '" + key + "' in type '" + get_name() + "'").c_str());
             }
-            size_t pos = type_name_to_pos[key];
-            return *types[pos];
+            return child(pos);
         }
         virtual std::unique_ptr<Type> operator[](size_t pos) {
-            throw std::invalid_argument(("Compile Error: Struct_Type '" + name + "' cannot be indexed with `pos`").c_str());
+            throw std::invalid_argument(("Compile Error: Struct_Type '" + get_name() + "' cannot be indexed with `pos`").c_str());
         }
         virtual size_t get_Size() const {
-            throw std::invalid_argument(("Compile Error: Cannot get size of Struct Type '" + name + "'").c_str());
+            throw std::invalid_argument(("Compile Error: Cannot get size of Struct Type '" + get_name() + "'").c_str());
         }
         virtual Type& get_Element_Type() {
-            throw std::invalid_argument(("Compile Error: Cannot get Element Type of Struct Type '" + name + "'").c_str());
+            throw std::invalid_argument(("Compile Error: Cannot get Element Type of Struct Type '" + get_name() + "'").c_str());
         }
         virtual std::vector<std::string> get_Keys() const {
-            return keys;
+            return schema->get_Keys();
         }
         virtual Type& append(Type* type) {
             if (data != nullptr) {
-                throw std::invalid_argument(("Value Error: Cannot append to a Struct Type '" + name + "', which holds or possesses a valid pointer to data").c_str());
+                throw std::invalid_argument(("Value Error: Cannot append to a Struct Type '" + get_name() + "', which holds or possesses a valid pointer to data").c_str());
             }
-            // Check for Duplication
-            if (type_name_to_pos.find(type->name) != type_name_to_pos.end()) {
-                throw std::invalid_argument(("Value Error: Cannot set duplicate property with name '" + type->name + "' in type '" + name + "'").c_str());
+            check_unfrozen("append to properties");
+            std::vector<std::shared_ptr<const Schema>> fields = current_fields();
+            fields.push_back(type->get_Schema());
+            schema = Schema::make_Struct(fields, get_name(), schema->get_Layout_Policy());
+            Type::relayout();
+            return *this;
+        }
+        virtual size_t get_Offset(std::string key) const {
+            return schema->get_Offset(key);
+        }
+        virtual Layout_Policy get_Layout_Policy() const {
+            return schema->get_Layout_Policy();
+        }
+        virtual Type& set_Layout_Policy(Layout_Policy policy) {
+            if (data != nullptr) {
+                throw std::invalid_argument(("Value Error: Cannot change layout of a Struct Type '" + get_name() + "', which holds or possesses a valid pointer to data").c_str());
             }
-            
-            // Must be called first before modifying relevant data fields
-            type_name_to_offset[type->name] = size_of();
-
-            types.push_back(type->clone());
-            types[types.size() - 1]->parent_type = this;
-            keys.push_back(type->name);
-            type_name_to_pos[type->name] = types.size() - 1;
+            check_unfrozen("change layout");
+            schema = Schema::make_Struct(current_fields(), get_name(), policy);
+            Type::relayout();
             return *this;
         }
         virtual void set(void* src) {
-            throw std::invalid_argument(("Compile Error: Cannot set directly to data of Struct type '" + name + "'").c_str());
+            throw std::invalid_argument(("Compile Error: Cannot set directly to data of Struct type '" + get_name() + "'").c_str());
         }
         virtual void set(int8_t src) {
-            throw std::invalid_argument(("Compile Error: Cannot set directly to data of Struct type '" + name + "'").c_str());
+            throw std::invalid_argument(("Compile Error: Cannot set directly to data of Struct type '" + get_name() + "'").c_str());
         }
         virtual void set(int16_t src) {
-            throw std::invalid_argument(("Compile Error: Cannot set directly to data of Struct type '" + name + "'").c_str());
+            throw std::invalid_argument(("Compile Error: Cannot set directly to data of Struct type '" + get_name() + "'").c_str());
         }
         virtual void set(int32_t src) {
-            throw std::invalid_argument(("Compile Error: Cannot set directly to data of Struct type '" + name + "'").c_str());
+            throw std::invalid_argument(("Compile Error: Cannot set directly to data of Struct type '" + get_name() + "'").c_str());
         }
         virtual void set(int64_t src) {
-            throw std::invalid_argument(("Compile Error: Cannot set directly to data of Struct type '" + name + "'").c_str());
+            throw std::invalid_argument(("Compile Error: Cannot set directly to data of Struct type '" + get_name() + "'").c_str());
         }
 
         virtual void set(uint8_t src) {
-            throw std::invalid_argument(("Compile Error: Cannot set directly to data of Struct type '" + name + "'").c_str());
+            throw std::invalid_argument(("Compile Error: Cannot set directly to data of Struct type '" + get_name() + "'").c_str());
         }
         virtual void set(uint16_t src) {
-            throw std::invalid_argument(("Compile Error: Cannot set directly to data of Struct type '" + name + "'").c_str());
+            throw std::invalid_argument(("Compile Error: Cannot set directly to data of Struct type '" + get_name() + "'").c_str());
         }
         virtual void set(uint32_t src) {
-            throw std::invalid_argument(("Compile Error: Cannot set directly to data of Struct type '" + name + "'").c_str());
+            throw std::invalid_argument(("Compile Error: Cannot set directly to data of Struct type '" + get_name() + "'").c_str());
         }
         virtual void set(uint64_t src) {
-            throw std::invalid_argument(("Compile Error: Cannot set directly to data of Struct type '" + name + "'").c_str());
+            throw std::invalid_argument(("Compile Error: Cannot set directly to data of Struct type '" + get_name() + "'").c_str());
         }
 
         virtual void set(char src) {
-            throw std::invalid_argument(("Compile Error: Cannot set directly to data of Struct type '" + name + "'").c_str());
+            throw std::invalid_argument(("Compile Error: Cannot set directly to data of Struct type '" + get_name() + "'").c_str());
         }
 
         virtual void set(float src) {
-            throw std::invalid_argument(("Compile Error: Cannot set directly to data of Struct type '" + name + "'").c_str());
+            throw std::invalid_argument(("Compile Error: Cannot set directly to data of Struct type '" + get_name() + "'").c_str());
         }
         virtual void set(double src) {
-            throw std::invalid_argument(("Compile Error: Cannot set directly to data of Struct type '" + name + "'").c_str());
+            throw std::invalid_argument(("Compile Error: Cannot set directly to data of Struct type '" + get_name() + "'").c_str());
         }
 
         virtual void set(bool src) {
-            throw std::invalid_argument(("Compile Error: Cannot set directly to data of Struct type '" + name + "'").c_str());
+            throw std::invalid_argument(("Compile Error: Cannot set directly to data of Struct type '" + get_name() + "'").c_str());
         }
 
         virtual void set(std::string src) {
-            throw std::invalid_argument(("Compile Error: Cannot set directly to data of Struct type '" + name + "'").c_str());
+            throw std::invalid_argument(("Compile Error: Cannot set directly to data of Struct type '" + get_name() + "'").c_str());
         }
 
         virtual int8_t* get_Int_8() const {
-            throw std::invalid_argument(("Compile Error: Cannot get data directly of Struct type '" + name + "'").c_str());
+            throw std::invalid_argument(("Compile Error: Cannot get data directly of Struct type '" + get_name() + "'").c_str());
         }
         virtual int16_t* get_Int_16() const {
-            throw std::invalid_argument(("Compile Error: Cannot get data directly of Struct type '" + name + "'").c_str());
+            throw std::invalid_argument(("Compile Error: Cannot get data directly of Struct type '" + get_name() + "'").c_str());
         }
         virtual int32_t* get_Int_32() const {
-            throw std::invalid_argument(("Compile Error: Cannot get data directly of Struct type '" + name + "'").c_str());
+            throw std::invalid_argument(("Compile Error: Cannot get data directly of Struct type '" + get_name() + "'").c_str());
         }
         virtual int64_t* get_Int_64() const {
-            throw std::invalid_argument(("Compile Error: Cannot get data directly of Struct type '" + name + "'").c_str());
+            throw std::invalid_argument(("Compile Error: Cannot get data directly of Struct type '" + get_name() + "'").c_str());
         }
 
         virtual uint8_t* get_Unsigned_Int_8() const {
-            throw std::invalid_argument(("Compile Error: Cannot get data directly of Struct type '" + name + "'").c_str());
+            throw std::invalid_argument(("Compile Error: Cannot get data directly of Struct type '" + get_name() + "'").c_str());
         }
         virtual uint16_t* get_Unsigned_Int_16() const {
-            throw std::invalid_argument(("Compile Error: Cannot get data directly of Struct type '" + name + "'").c_str());
+            throw std::invalid_argument(("Compile Error: Cannot get data directly of Struct type '" + get_name() + "'").c_str());
         }
         virtual uint32_t* get_Unsigned_Int_32() const {
-            throw std::invalid_argument(("Compile Error: Cannot get data directly of Struct type '" + name + "'").c_str());
+            throw std::invalid_argument(("Compile Error: Cannot get data directly of Struct type '" + get_name() + "'").c_str());
         }
         virtual uint64_t* get_Unsigned_Int_64() const {
-            throw std::invalid_argument(("Compile Error: Cannot get data directly of Struct type '" + name + "'").c_str());
+            throw std::invalid_argument(("Compile Error: Cannot get data directly of Struct type '" + get_name() + "'").c_str());
         }
 
         virtual char* get_Char() const {
-            throw std::invalid_argument(("Compile Error: Cannot get data directly of Struct type '" + name + "'").c_str());
+            throw std::invalid_argument(("Compile Error: Cannot get data directly of Struct type '" + get_name() + "'").c_str());
         }
 
         virtual float* get_Float_32() const {
-            throw std::invalid_argument(("Compile Error: Cannot get data directly of Struct type '" + name + "'").c_str());
+            throw std::invalid_argument(("Compile Error: Cannot get data directly of Struct type '" + get_name() + "'").c_str());
         }
         virtual double* get_Float_64() const {
-            throw std::invalid_argument(("Compile Error: Cannot get data directly of Struct type '" + name + "'").c_str());
+            throw std::invalid_argument(("Compile Error: Cannot get data directly of Struct type '" + get_name() + "'").c_str());
         }
 
         virtual bool* get_Boolean() const {
-            throw std::invalid_argument(("Compile Error: Cannot get data directly of Struct type '" + name + "'").c_str());
+            throw std::invalid_argument(("Compile Error: Cannot get data directly of Struct type '" + get_name() + "'").c_str());
         }
 
         virtual Primitive_Data_Types get_Type() const {
-            throw std::invalid_argument(("Compile Error: Cannot get raw primitive data type of Struct type '" + name + "'").c_str());
+            throw std::invalid_argument(("Compile Error: Cannot get raw primitive data type of Struct type '" + get_name() + "'").c_str());
         }
 
         virtual std::string string() const {
-            throw std::invalid_argument(("Compile Error: Cannot turn data of Struct type '" + name + "' into string directly").c_str());
+            throw std::invalid_argument(("Compile Error: Cannot turn data of Struct type '" + get_name() + "' into string directly").c_str());
         }
     };
 
     #define Struct_Clone(struct_ptr, new_name) std::unique_ptr<Struct_Type>(struct_ptr.clone())->set_name(new_name)
 
+    inline std::unique_ptr<Type> instantiate(const std::shared_ptr<const Schema>& schema) {
+        if (schema == nullptr) throw std::invalid_argument("Nullpointer Error: Cannot instantiate null schema");
+        Type* type = nullptr;
+        switch (schema->get_Type_Class()) {
+        case Type_Class::Primitive: type = new Primitive_Type(schema); break;
+        case Type_Class::Array: type = new Array_Type(schema); break;
+        case Type_Class::Struct: type = new Struct_Type(schema); break;
+        }
+        return std::unique_ptr<Type>(type);
+    }
+
+    #define VIEW_GET_POINTER_MACRO(pointer_type, type_name) if (data == nullptr) {\
+                throw std::invalid_argument(("Nullpointer Error: Cannot turn null pointer into " + std::string(#type_name) + " pointer of view of type '" + schema->get_name() + "'").c_str());\
+            }\
+            if (schema->type_class != Type_Class::Primitive || schema->primitive_data_type != Primitive_Data_Types::type_name) {\
+                throw std::invalid_argument(("Value Error: Cannot get " + std::string(#type_name) + " pointer from view of type '" + schema->get_name() + "', whose data type is " + schema->type()).c_str());\
+            }\
+            return static_cast<pointer_type*>(data);
+
+    // Fields of a Packed Struct might not be aligned, so values are copied by bytes
+    #define VIEW_SET_MACRO(type_name) memcpy(get_##type_name(), &src, sizeof(src));
+
     /**
-     * Native Support for Serializing Type
-     * Descriptor:
-     *  Primitive: (#name,#type)
-     *  Array: [#name,#array_length,#sub-type descriptor]
-     *  Struct: {#name,...(sub-type descriptors)}
-     * 
-     * For example:
-     *      Type:
-     *          type {
-     *              sub_type {
-     *                  Int_8 x,
-     *                  Int_8 y
-     *              },
-     *              [8]Float_32 var
-     *          }
-     *      is serialized into {type,{sub_type,(x,Int_8),(y,Int_8)},[var,8,(,Float_32)]}
+     * Non-owning view of data, which only carries a pointer to `Schema`, a pointer to data and the arena of long String and Blob values
+     * Unlike `Array_Type::operator[]`, indexing into a view neither instantiates `Type` nor allocates memory,
+     * and the viewed `Schema` must outlive the view.
      */
-    std::string Serialize(Type* type) {
-        if (type->get_Type_Class() == Type_Class::Primitive) {
-            return "(" + type->get_name() + "," + get_string_from_type(type->get_Type()) + ")";
-        } else if (type->get_Type_Class() == Type_Class::Array) {
-            return "[" + type->get_name() + "," + std::to_string(type->get_Size()) + "," + Serialize(&type->get_Element_Type()) + "]";
-        } else if (type->get_Type_Class() == Type_Class::Struct) {
-            std::string str = "{" + type->get_name();
-            for (std::string key : type->get_Keys()) {
-                str += "," + Serialize(&type->get(key));
+    class Type_View {
+    private:
+        const Schema* schema;
+        void* data;
+        String_Arena* arena;
+
+        [[noreturn]] void throw_bytes_error(Status status, const char* operation) const {
+            if (status == Status::Null_Data && data == nullptr) throw std::invalid_argument(("Nullpointer Error: Cannot " + std::string(operation) + " null pointer of view of type '" + schema->get_name() + "'").c_str());
+            if (status == Status::Null_Data) throw std::invalid_argument(("Nullpointer Error: Cannot " + std::string(operation) + " view of type '" + schema->get_name() + "' without an arena for values over " + std::to_string(STRING_INLINE_BYTES) + " bytes").c_str());
+            if (status == Status::Out_Of_Range) throw std::out_of_range(("Value Error: Cannot " + std::string(operation) + " view of type '" + schema->get_name() + "', whose value is out of range or outside its arena").c_str());
+            throw std::invalid_argument(("Value Error: Cannot " + std::string(operation) + " view of type '" + schema->get_name() + "', whose data type is " + schema->type()).c_str());
+        }
+    public:
+        Type_View(const Schema* _schema, void* _data, String_Arena* _arena = nullptr):schema(_schema), data(_data), arena(_arena) {}
+        const Schema& get_Schema() const { return *schema; }
+        void* get_data() const { return data; }
+        String_Arena* get_Arena() const { return arena; }
+        Type_Class get_Type_Class() const { return schema->get_Type_Class(); }
+        size_t size_of() const { return schema->size_of(); }
+        std::string get_name() const { return schema->get_name(); }
+        /**
+         * For Struct Type
+         */
+        Type_View operator[](const std::string& key) const {
+            if (schema->get_Type_Class() != Type_Class::Struct) {
+                throw std::invalid_argument(("Compile Error: View of type '" + schema->get_name() + "' cannot be indexed with `key`").c_str());
             }
-            str += "}";
-            return str;
+            size_t pos = schema->find(key);
+            if (pos == Schema::npos) {
+                throw std::invalid_argument(("Value Error: Cannot find key '" + key + "' in type '" + schema->get_name() + "'").c_str());
+            }
+            return Type_View(schema->get_Field(pos).get(), data == nullptr ? nullptr : static_cast<char*>(data) + schema->get_Field_Offset(pos), arena);
         }
-        throw std::invalid_argument("Value Error: Unrecognized Type pointer");
+        Type_View get(const std::string& key) const {
+            return (*this)[key];
+        }
+        std::vector<std::string> get_Keys() const {
+            return schema->get_Keys();
+        }
+        /**
+         * For Array Type
+         */
+        Type_View operator[](size_t pos) const {
+            if (schema->get_Type_Class() != Type_Class::Array) {
+                throw std::invalid_argument(("Compile Error: View of type '" + schema->get_name() + "' cannot be indexed with `pos`").c_str());
+            }
+            if (data == nullptr) throw std::invalid_argument(("Nullpointer Error: Cannot index into null pointer of type '" + schema->get_name() + "'").c_str());
+            if (pos >= schema->length) throw std::out_of_range(("Index Error: Cannot index over the length of type '" + schema->get_name() + "'").c_str());
+            const Schema* element = schema->element.get();
+            return Type_View(element, static_cast<char*>(data) + element->size * pos, arena);
+        }
+        Type_View at(size_t pos) const {
+            return (*this)[pos];
+        }
+        size_t get_Size() const {
+            if (schema->get_Type_Class() != Type_Class::Array) {
+                throw std::invalid_argument(("Compile Error: Cannot get size of view of type '" + schema->get_name() + "'").c_str());
+            }
+            return schema->get_Size();
+        }
+        /**
+         * For Primitive Type
+         */
+        Primitive_Data_Types get_Type() const {
+            if (schema->get_Type_Class() != Type_Class::Primitive) {
+                throw std::invalid_argument(("Compile Error: Cannot get raw primitive data type of view of type '" + schema->get_name() + "'").c_str());
+            }
+            return schema->get_Type();
+        }
+
+        int8_t* get_Int_8() const { VIEW_GET_POINTER_MACRO(int8_t, Int_8) }
+        int16_t* get_Int_16() const { VIEW_GET_POINTER_MACRO(int16_t, Int_16) }
+        int32_t* get_Int_32() const { VIEW_GET_POINTER_MACRO(int32_t, Int_32) }
+        int64_t* get_Int_64() const { VIEW_GET_POINTER_MACRO(int64_t, Int_64) }
+
+        uint8_t* get_Unsigned_Int_8() const { VIEW_GET_POINTER_MACRO(uint8_t, Unsigned_Int_8) }
+        uint16_t* get_Unsigned_Int_16() const { VIEW_GET_POINTER_MACRO(uint16_t, Unsigned_Int_16) }
+        uint32_t* get_Unsigned_Int_32() const { VIEW_GET_POINTER_MACRO(uint32_t, Unsigned_Int_32) }
+        uint64_t* get_Unsigned_Int_64() const { VIEW_GET_POINTER_MACRO(uint64_t, Unsigned_Int_64) }
+
+        char* get_Char() const { VIEW_GET_POINTER_MACRO(char, Char) }
+
+        float* get_Float_32() const { VIEW_GET_POINTER_MACRO(float, Float_32) }
+        double* get_Float_64() const { VIEW_GET_POINTER_MACRO(double, Float_64) }
+
+        bool* get_Boolean() const { VIEW_GET_POINTER_MACRO(bool, Boolean) }
+
+        void set(int8_t src) const { VIEW_SET_MACRO(Int_8) }
+        void set(int16_t src) const { VIEW_SET_MACRO(Int_16) }
+        void set(int32_t src) const { VIEW_SET_MACRO(Int_32) }
+        void set(int64_t src) const { VIEW_SET_MACRO(Int_64) }
+
+        void set(uint8_t src) const { VIEW_SET_MACRO(Unsigned_Int_8) }
+        void set(uint16_t src) const { VIEW_SET_MACRO(Unsigned_Int_16) }
+        void set(uint32_t src) const { VIEW_SET_MACRO(Unsigned_Int_32) }
+        void set(uint64_t src) const { VIEW_SET_MACRO(Unsigned_Int_64) }
+
+        void set(char src) const { VIEW_SET_MACRO(Char) }
+
+        void set(float src) const { VIEW_SET_MACRO(Float_32) }
+        void set(double src) const { VIEW_SET_MACRO(Float_64) }
+
+        void set(bool src) const { VIEW_SET_MACRO(Boolean) }
+
+        /* Parse [begin, end) as `parse_value` does, where long String and Blob values are appended to the arena */
+        Status try_parse(const char* begin, const char* end) const {
+            if (schema->get_Type_Class() != Type_Class::Primitive) return Status::Type_Mismatch;
+            if (data == nullptr) return Status::Null_Data;
+            static thread_local std::string scratch;
+            return parse_value(schema->get_Type(), begin, end, data, scratch, arena);
+        }
+        /* Useful Function, which will parse `src` automatically into appropriate internal data type */
+        void set(const std::string& src) const {
+            Status status = try_parse(src.data(), src.data() + src.length());
+            if (status != Status::Ok) throw_bytes_error(status, ("set " + src + " into").c_str());
+        }
+        void set(const char* src) const {
+            set(std::string(src));
+        }
+
+        /**
+         * For String and Blob Type, the same as `Type::set_bytes` and `Type::get_bytes`
+         */
+        Status try_set_bytes(const void* src, size_t length) const {
+            if (schema->get_Type_Class() != Type_Class::Primitive || !is_variable_length(schema->get_Type())) return Status::Type_Mismatch;
+            if (data == nullptr) return Status::Null_Data;
+            return store_string(data, src, length, arena);
+        }
+        Status try_get_bytes(String_Ref& dst) const {
+            if (data == nullptr) return Status::Null_Data;
+            if (schema->get_Type_Class() != Type_Class::Primitive || !is_variable_length(schema->get_Type())) return Status::Type_Mismatch;
+            return load_string(data, arena, dst);
+        }
+        void set_bytes(const void* src, size_t length) const {
+            Status status = try_set_bytes(src, length);
+            if (status != Status::Ok) throw_bytes_error(status, "set bytes to");
+        }
+        String_Ref get_bytes() const {
+            String_Ref value;
+            Status status = try_get_bytes(value);
+            if (status != Status::Ok) throw_bytes_error(status, "get bytes from");
+            return value;
+        }
+
+        std::string string() const {
+            if (data == nullptr) return "<void>";
+            switch (get_Type()) {
+            case Primitive_Data_Types::String: return get_bytes().str();
+            case Primitive_Data_Types::Blob: {
+                String_Ref value = get_bytes();
+                std::string text(value.length * 2, '\0');
+                format_hex(&text[0], value.data, value.length);
+                return text;
+            }
+            default:
+                return _primitive_string(get_Type(), data);
+            }
+        }
+
+        friend std::ostream& operator<< (std::ostream& stream, const Type_View& operand) {
+            stream << operand.string();
+            return stream;
+        }
+    };
+
+    inline Type_View Type::view() {
+        return Type_View(schema.get(), data, get_Arena());
     }
+
     /**
-     * Native Support for Deserializing Type
-     * \param src serialized type
-     * 
-     * Descriptor:
-     *  Primitive: (#name,#type)
-     *  Array: [#name,#array_length,#sub-type descriptor]
-     *  Struct: {#name,...(sub-type descriptors)}
-     * 
-     * For example:
-     *      Type:
-     *          {type,{sub_type,(x,Int_8),(y,Int_8)},[var,8,(,Float_32)]}
-     *      is deserialized into
-     *          type {
-     *              sub_type {
-     *                  Int_8 x,
-     *                  Int_8 y
-     *              },
-     *              [8]Float_32 var
-     *          }
+     * Contiguous storage of rows of the same `Type`
+     * Rows are arranged back to back in a single buffer, so the overhead of each row is only its payload,
+     * and rows are accessed through `Type_View` without cloning `Type`.
+     * Long String and Blob values of every row share one arena, which is cleared with rows.
      */
-    std::unique_ptr<Type> Deserialize(std::string src) {
-        std::string parse_error = "Value Error: Unable to parse " + src;
-        // Empty String
-        if (src.length() == 0) throw std::invalid_argument(parse_error.c_str());
-
-        char indicator = src[0];
-        switch(indicator) {
-        case '(': {
-            if (src[src.length() - 1] != ')') throw std::invalid_argument(parse_error.c_str());
-            size_t name_field_start_pos = 1;
-            size_t name_field_end_pos = src.find(',');
-            if (name_field_end_pos == std::string::npos) throw std::invalid_argument(parse_error.c_str());
-            std::string name = src.substr(name_field_start_pos, name_field_end_pos - name_field_start_pos);
-            size_t type_field_start_pos = name_field_end_pos + 1;
-            size_t type_field_end_pos = src.length() - 1;
-            try {
-                std::string type_name = src.substr(type_field_start_pos, type_field_end_pos - type_field_start_pos);
-                Primitive_Data_Types type = get_type_from_string(type_name);
-                return std::unique_ptr<Type>(new Primitive_Type(type, name));
-            } catch(const std::exception& e) {
-                throw std::invalid_argument(parse_error.c_str());
+    class Record_Batch {
+    private:
+        std::shared_ptr<const Schema> schema;
+        size_t stride;
+        size_t size;
+        size_t capacity;
+        void* data;
+        String_Arena arena;
+    public:
+        Record_Batch(const Type* type, size_t _capacity = 0):Record_Batch(type->get_Schema(), _capacity) {}
+        Record_Batch(const std::shared_ptr<const Schema>& _schema, size_t _capacity = 0):schema(_schema), stride(_schema->size_of()), size(0), capacity(0), data(nullptr) {
+            reserve(_capacity);
+        }
+        Record_Batch(const Record_Batch&) = delete;
+        Record_Batch& operator=(const Record_Batch&) = delete;
+        ~Record_Batch() {
+            if (data != nullptr) free(data);
+        }
+        const std::shared_ptr<const Schema>& get_Schema() const { return schema; }
+        /* Get Number of Rows */
+        size_t get_Size() const { return size; }
+        size_t get_Capacity() const { return capacity; }
+        /* Get Bytes of each Row */
+        size_t get_Stride() const { return stride; }
+        void* get_data() { return data; }
+        const void* get_data() const { return data; }
+        String_Arena& get_Arena() { return arena; }
+        const String_Arena& get_Arena() const { return arena; }
+
+        /* `reserve` grows the buffer to hold at least `_capacity` rows without changing existing rows */
+        void reserve(size_t _capacity) {
+            if (_capacity <= capacity) return;
+            if (stride != 0 && _capacity > std::numeric_limits<size_t>::max() / stride) {
+                throw std::overflow_error(("Memory Error: Too many rows of type '" + schema->get_name() + "'").c_str());
             }
-            break;
+            // Zero-sized rows still need a valid base pointer
+            void* new_data = realloc(data, stride * _capacity == 0 ? 1 : stride * _capacity);
+            if (new_data == nullptr) {
+                throw std::overflow_error(("Memory Error: Fail to allocate memory for rows of type '" + schema->get_name() + "'").c_str());
+            }
+            data = new_data;
+            capacity = _capacity;
         }
-        case '[': {
-            if (src[src.length() - 1] != ']') throw std::invalid_argument(parse_error.c_str());
-            size_t name_field_start_pos = 1;
-            size_t name_field_end_pos = src.find(',');
-            if (name_field_end_pos == std::string::npos) throw std::invalid_argument(parse_error.c_str());
-            std::string name = src.substr(name_field_start_pos, name_field_end_pos - name_field_start_pos);
-
-            size_t size_field_start_pos = name_field_end_pos + 1;
-            size_t size_field_end_pos = src.find(',', size_field_start_pos);
-            if (size_field_end_pos == std::string::npos || size_field_end_pos <= size_field_start_pos) throw std::invalid_argument(parse_error.c_str());
-            std::string size_str = src.substr(size_field_start_pos, size_field_end_pos - size_field_start_pos);
-            size_t size = 0;
-            try {
-                size = std::stoull(size_str);
-            } catch(...){
-                throw std::invalid_argument(parse_error.c_str());
+        /* `append` adds a row filled with zero, whose capacity grows geometrically */
+        Type_View append() {
+            if (size == capacity) reserve(capacity < 8 ? 8 : capacity * 2);
+            void* row = static_cast<char*>(data) + stride * size;
+            memset(row, 0, stride);
+            ++size;
+            return Type_View(schema.get(), row, &arena);
+        }
+        /**
+         * Notice that this function copies `stride` bytes from `src` without type checking
+         * Long String and Blob values of `src` should be in the arena of this batch, e.g. when `src` is another row of it.
+         */
+        Type_View append(const void* src) {
+            // A row of this batch moves with the buffer when `append` grows it
+            uintptr_t address = reinterpret_cast<uintptr_t>(src), base = reinterpret_cast<uintptr_t>(data);
+            bool inside = data != nullptr && address >= base && address < base + stride * size;
+            Type_View row = append();
+            memcpy(row.get_data(), inside ? static_cast<const char*>(data) + (address - base) : src, stride);
+            return row;
+        }
+        void clear() {
+            size = 0;
+            arena.clear();
+        }
+        /* `resize` changes the number of rows, where new rows are filled with zero */
+        void resize(size_t _size) {
+            reserve(_size);
+            if (_size > size) memset(static_cast<char*>(data) + stride * size, 0, stride * (_size - size));
+            size = _size;
+        }
+
+        Type_View operator[](size_t row) {
+            if (row >= size) throw std::out_of_range(("Index Error: Cannot index over the number of rows of type '" + schema->get_name() + "'").c_str());
+            return Type_View(schema.get(), static_cast<char*>(data) + stride * row, &arena);
+        }
+        Type_View at(size_t row) {
+            return (*this)[row];
+        }
+        /* Let `type` hold the data of `row`, so that the original API of `Type` could be used on it */
+        void hold(Type& type, size_t row) {
+            type.hold((*this)[row].get_data());
+            type.set_Arena(&arena);
+        }
+    };
+
+    /* Alignment in bytes of each column of `Column_Batch` */
+    const size_t COLUMN_ALIGNMENT = 64;
+    /* Number of rows converted at a time between `Record_Batch` and `Column_Batch` */
+    const size_t CONVERSION_BLOCK_ROWS = 256;
+
+    template <size_t element_size>
+    inline void _copy_strided(char* dst, size_t dst_stride, const char* src, size_t src_stride, size_t count) {
+        for (size_t index = 0; index < count; ++index) memcpy(dst + dst_stride * index, src + src_stride * index, element_size);
+    }
+    /* Copy elements of `element_size` in (half, 2 * half] bytes by two overlapping copies of `half` bytes, which avoids calling `memcpy` per element */
+    template <size_t half>
+    inline void _copy_strided_overlapping(char* dst, size_t dst_stride, const char* src, size_t src_stride, size_t element_size, size_t count) {
+        for (size_t index = 0; index < count; ++index) {
+            memcpy(dst + dst_stride * index, src + src_stride * index, half);
+            memcpy(dst + dst_stride * index + element_size - half, src + src_stride * index + element_size - half, half);
+        }
+    }
+    /* Copy `count` elements between buffers with different strides, which is specialized for common element sizes */
+    inline void copy_strided(void* dst, size_t dst_stride, const void* src, size_t src_stride, size_t element_size, size_t count) {
+        char* _dst = static_cast<char*>(dst);
+        const char* _src = static_cast<const char*>(src);
+        switch (element_size) {
+        case 1: _copy_strided<1>(_dst, dst_stride, _src, src_stride, count); break;
+        case 2: _copy_strided<2>(_dst, dst_stride, _src, src_stride, count); break;
+        case 4: _copy_strided<4>(_dst, dst_stride, _src, src_stride, count); break;
+        case 8: _copy_strided<8>(_dst, dst_stride, _src, src_stride, count); break;
+        default:
+            if (element_size == 3) _copy_strided_overlapping<2>(_dst, dst_stride, _src, src_stride, element_size, count);
+            else if (element_size < 8) _copy_strided_overlapping<4>(_dst, dst_stride, _src, src_stride, element_size, count);
+            else if (element_size <= 16) _copy_strided_overlapping<8>(_dst, dst_stride, _src, src_stride, element_size, count);
+            else if (element_size <= 32) _copy_strided_overlapping<16>(_dst, dst_stride, _src, src_stride, element_size, count);
+            else for (size_t index = 0; index < count; ++index) memcpy(_dst + dst_stride * index, _src + src_stride * index, element_size);
+        }
+    }
+
+    class Column_Batch;
+
+    /**
+     * Non-owning view of a row of `Column_Batch`, which could be indexed in the same way as `Type_View`
+     * It carries the position of the viewed `Type` inside the row, and only resolves the column at a Primitive Type.
+     */
+    class Column_View {
+    private:
+        const Schema* schema;
+        size_t offset;
+        Column_Batch* batch;
+        size_t row;
+        /* View of the element inside the column, only for Primitive Type */
+        Type_View leaf() const;
+    public:
+        Column_View(const Schema* _schema, size_t _offset, Column_Batch* _batch, size_t _row):schema(_schema), offset(_offset), batch(_batch), row(_row) {}
+        const Schema& get_Schema() const { return *schema; }
+        Type_Class get_Type_Class() const { return schema->get_Type_Class(); }
+        std::string get_name() const { return schema->get_name(); }
+        /**
+         * For Struct Type
+         */
+        Column_View operator[](const std::string& key) const {
+            if (schema->get_Type_Class() != Type_Class::Struct) {
+                throw std::invalid_argument(("Compile Error: View of type '" + schema->get_name() + "' cannot be indexed with `key`").c_str());
+            }
+            size_t pos = schema->find(key);
+            if (pos == Schema::npos) {
+                throw std::invalid_argument(("Value Error: Cannot find key '" + key + "' in type '" + schema->get_name() + "'").c_str());
+            }
+            return Column_View(schema->get_Field(pos).get(), offset + schema->get_Field_Offset(pos), batch, row);
+        }
+        Column_View get(const std::string& key) const {
+            return (*this)[key];
+        }
+        std::vector<std::string> get_Keys() const {
+            return schema->get_Keys();
+        }
+        /**
+         * For Array Type
+         */
+        Column_View operator[](size_t pos) const {
+            if (schema->get_Type_Class() != Type_Class::Array) {
+                throw std::invalid_argument(("Compile Error: View of type '" + schema->get_name() + "' cannot be indexed with `pos`").c_str());
+            }
+            if (pos >= schema->get_Size()) throw std::out_of_range(("Index Error: Cannot index over the length of type '" + schema->get_name() + "'").c_str());
+            const Schema* element = schema->get_Element().get();
+            return Column_View(element, offset + element->size_of() * pos, batch, row);
+        }
+        Column_View at(size_t pos) const {
+            return (*this)[pos];
+        }
+        size_t get_Size() const {
+            if (schema->get_Type_Class() != Type_Class::Array) {
+                throw std::invalid_argument(("Compile Error: Cannot get size of view of type '" + schema->get_name() + "'").c_str());
             }
-            
-            size_t type_field_start_pos = size_field_end_pos + 1;
-            size_t type_field_end_pos = src.length() - 1;
-            std::string type_field_str = src.substr(type_field_start_pos, type_field_end_pos - type_field_start_pos);
-            std::unique_ptr<Type> type = Deserialize(type_field_str);
+            return schema->get_Size();
+        }
+        /**
+         * For Primitive Type
+         */
+        Primitive_Data_Types get_Type() const { return leaf().get_Type(); }
 
-            return std::unique_ptr<Type>(new Array_Type(size, type.get(), name));
-            break;
+        int8_t* get_Int_8() const { return leaf().get_Int_8(); }
+        int16_t* get_Int_16() const { return leaf().get_Int_16(); }
+        int32_t* get_Int_32() const { return leaf().get_Int_32(); }
+        int64_t* get_Int_64() const { return leaf().get_Int_64(); }
+
+        uint8_t* get_Unsigned_Int_8() const { return leaf().get_Unsigned_Int_8(); }
+        uint16_t* get_Unsigned_Int_16() const { return leaf().get_Unsigned_Int_16(); }
+        uint32_t* get_Unsigned_Int_32() const { return leaf().get_Unsigned_Int_32(); }
+        uint64_t* get_Unsigned_Int_64() const { return leaf().get_Unsigned_Int_64(); }
+
+        char* get_Char() const { return leaf().get_Char(); }
+
+        float* get_Float_32() const { return leaf().get_Float_32(); }
+        double* get_Float_64() const { return leaf().get_Float_64(); }
+
+        bool* get_Boolean() const { return leaf().get_Boolean(); }
+
+        template <typename T>
+        void set(T src) const { leaf().set(src); }
+
+        std::string string() const { return leaf().string(); }
+
+        friend std::ostream& operator<< (std::ostream& stream, const Column_View& operand) {
+            stream << operand.string();
+            return stream;
         }
-        case '{': {
-            if (src[src.length() - 1] != '}') throw std::invalid_argument(parse_error.c_str());
-            size_t name_field_start_pos = 1;
-            size_t name_field_end_pos = src.find(',');
-            if (name_field_end_pos == std::string::npos) throw std::invalid_argument(parse_error.c_str());
-            std::string name = src.substr(name_field_start_pos, name_field_end_pos - name_field_start_pos);
-
-            Struct_Type* ret = new Struct_Type({}, name);
-
-            size_t type_field_start_pos = name_field_end_pos + 1;
-            size_t type_field_end_pos = src.length() - 1;
-            std::string type_field_str = src.substr(type_field_start_pos, type_field_end_pos - type_field_start_pos);
-            // Check for Validity
-            if (type_field_str[0] != '(' && type_field_str[0] != '[' && type_field_str[0] != '{') throw std::invalid_argument(parse_error.c_str());
-
-            // Use Stack to divide sequence of type
-            struct Indicator {
-                char indicator;
-                size_t pos;
-            };
-            std::stack<Indicator> Stack;
-            std::function<bool(char, char)> is_match = [](char u, char v)->bool{
-                return (u == '(' && v == ')') || (u == '[' && v == ']') || (u == '{' && v == '}');
-            };
+    };
 
-            for (size_t index = 0; index < type_field_str.length(); index++) {
-                bool is_open = type_field_str[index] == '(' || type_field_str[index] == '[' || type_field_str[index] == '{';
-                bool is_close = type_field_str[index] == ')' || type_field_str[index] == ']' || type_field_str[index] == '}';
-                if (is_open) Stack.push({type_field_str[index], index});
-                else if (is_close) {
-                    if (Stack.empty()) throw std::invalid_argument(parse_error.c_str());
-                    Indicator top = Stack.top(); Stack.pop();
-                    if (!is_match(top.indicator, type_field_str[index])) throw std::invalid_argument(parse_error.c_str());
-                    if (Stack.empty()) { // The Most Outside Type (Exclude Nested Ones)
-                        ret->append(Deserialize(type_field_str.substr(top.pos, index - top.pos + 1)).get());
-                    }
+    /**
+     * Columnar storage of rows of the same `Type`
+     * Each Primitive Type inside the row, flattened by its path like "point_a.x" or "tensor[3][0][1]",
+     * is stored in its own contiguous and aligned buffer, so scanning a property only touches its own column.
+     * Columns of String and Blob hold slots, whose long values live in the arena of the batch.
+     */
+    class Column_Batch {
+    private:
+        friend class Column_View;
+        struct Column {
+            std::string path;
+            size_t offset;
+            const Schema* type;
+            size_t element_size;
+            void* allocation;
+            void* data;
+        };
+        std::shared_ptr<const Schema> schema;
+        std::vector<Column> columns;
+        /* Map offset of each Primitive Type inside the row layout into its column */
+        std::vector<size_t> offset_to_column;
+        size_t stride;
+        size_t size;
+        size_t capacity;
+        String_Arena arena;
+
+        void flatten(const Schema* type, std::string path, size_t offset) {
+            switch (type->get_Type_Class()) {
+            case Type_Class::Primitive: {
+                offset_to_column[offset] = columns.size();
+                columns.push_back({ path, offset, type, type->size_of(), nullptr, nullptr });
+                break;
+            }
+            case Type_Class::Array: {
+                const Schema* element_type = type->get_Element().get();
+                for (size_t pos = 0; pos < type->get_Size(); ++pos) {
+                    flatten(element_type, path + "[" + std::to_string(pos) + "]", offset + element_type->size_of() * pos);
+                }
+                break;
+            }
+            case Type_Class::Struct: {
+                for (size_t pos = 0; pos < type->get_Field_Count(); ++pos) {
+                    const Schema* field = type->get_Field(pos).get();
+                    flatten(field, path.empty() ? field->get_name() : path + "." + field->get_name(), offset + type->get_Field_Offset(pos));
                 }
+                break;
+            }
             }
+        }
+        size_t find_column(const std::string& path) const {
+            for (size_t index = 0; index < columns.size(); ++index) {
+                if (columns[index].path == path) return index;
+            }
+            throw std::invalid_argument(("Value Error: Cannot find column '" + path + "' in type '" + schema->get_name() + "'").c_str());
+        }
+        void check_rows(const Record_Batch& rows) const {
+            if (rows.get_Schema() != schema) {
+                throw std::invalid_argument(("Value Error: Cannot convert rows of type '" + rows.get_Schema()->get_name() + "' into columns of type '" + schema->get_name() + "'").c_str());
+            }
+        }
+    public:
+        Column_Batch(const Type* type, size_t _capacity = 0):Column_Batch(type->get_Schema(), _capacity) {}
+        Column_Batch(const std::shared_ptr<const Schema>& _schema, size_t _capacity = 0):schema(_schema), stride(_schema->size_of()), size(0), capacity(0) {
+            offset_to_column.resize(stride, columns.max_size());
+            flatten(schema.get(), schema->get_Type_Class() == Type_Class::Primitive ? schema->get_name() : "", 0);
+            reserve(_capacity);
+        }
+        /* Convert rows into columns */
+        Column_Batch(const Record_Batch& rows):Column_Batch(rows.get_Schema(), rows.get_Size()) {
+            append(rows);
+        }
+        Column_Batch(const Column_Batch&) = delete;
+        Column_Batch& operator=(const Column_Batch&) = delete;
+        ~Column_Batch() {
+            for (Column& column : columns) free(column.allocation);
+        }
+        const std::shared_ptr<const Schema>& get_Schema() const { return schema; }
+        /* Get Number of Rows */
+        size_t get_Size() const { return size; }
+        size_t get_Capacity() const { return capacity; }
 
-            return std::unique_ptr<Type>(ret);
-            break;
+        size_t get_Column_Count() const { return columns.size(); }
+        std::string get_Column_Name(size_t column) const { return columns.at(column).path; }
+        Primitive_Data_Types get_Column_Type(size_t column) const { return columns.at(column).type->get_Type(); }
+        String_Arena& get_Arena() { return arena; }
+        /* Get the contiguous buffer of a column, which is aligned to `COLUMN_ALIGNMENT` bytes */
+        void* get_Column(size_t column) { return columns.at(column).data; }
+        void* get_Column(const std::string& path) { return columns[find_column(path)].data; }
+        void* get_Column(const Field_Path& path) {
+            if (path.get_Offset() >= stride || offset_to_column[path.get_Offset()] == columns.max_size()) {
+                throw std::invalid_argument(("Value Error: Cannot find column at offset " + std::to_string(path.get_Offset()) + " in type '" + schema->get_name() + "'").c_str());
+            }
+            return columns[offset_to_column[path.get_Offset()]].data;
         }
-        default:
-            throw std::invalid_argument(parse_error.c_str());
+
+        /* `reserve` grows every column to hold at least `_capacity` rows without changing existing rows */
+        void reserve(size_t _capacity) {
+            if (_capacity <= capacity) return;
+            for (Column& column : columns) {
+                void* allocation = malloc(column.element_size * _capacity + COLUMN_ALIGNMENT);
+                if (allocation == nullptr) {
+                    throw std::overflow_error(("Memory Error: Fail to allocate memory for column '" + column.path + "' of type '" + schema->get_name() + "'").c_str());
+                }
+                uintptr_t address = reinterpret_cast<uintptr_t>(allocation);
+                void* data = reinterpret_cast<void*>((address + COLUMN_ALIGNMENT - 1) / COLUMN_ALIGNMENT * COLUMN_ALIGNMENT);
+                if (column.data != nullptr) memcpy(data, column.data, column.element_size * size);
+                free(column.allocation);
+                column.allocation = allocation;
+                column.data = data;
+            }
+            capacity = _capacity;
         }
-    }
+        /* `append` adds a row filled with zero, whose capacity grows geometrically */
+        Column_View append() {
+            if (size == capacity) reserve(capacity < 8 ? 8 : capacity * 2);
+            for (Column& column : columns) {
+                memset(static_cast<char*>(column.data) + column.element_size * size, 0, column.element_size);
+            }
+            ++size;
+            return Column_View(schema.get(), 0, this, size - 1);
+        }
+        /* Scatter a row in the layout of `Record_Batch` into columns, without type checking */
+        Column_View append(const void* src) {
+            Column_View row = append();
+            store(size - 1, src);
+            return row;
+        }
+        /* Convert all rows of `rows` into columns */
+        void append(const Record_Batch& rows) {
+            check_rows(rows);
+            reserve(size + rows.get_Size());
+            const char* src = static_cast<const char*>(rows.get_data());
+            // Convert in blocks of rows, so that every column reads the block from cache
+            for (size_t first = 0; first < rows.get_Size(); first += CONVERSION_BLOCK_ROWS) {
+                size_t count = std::min(CONVERSION_BLOCK_ROWS, rows.get_Size() - first);
+                for (Column& column : columns) {
+                    char* dst = static_cast<char*>(column.data) + column.element_size * (size + first);
+                    copy_strided(dst, column.element_size, src + stride * first + column.offset, stride, column.element_size, count);
+                    if (column.type->has_Variable_Length()) _rehome_strings(dst, column.element_size, count, &rows.get_Arena(), arena);
+                }
+            }
+            size += rows.get_Size();
+        }
+        /* Convert all rows of columns back into `rows` */
+        void export_rows(Record_Batch& rows) const {
+            check_rows(rows);
+            size_t first = rows.get_Size();
+            rows.reserve(first + size);
+            for (size_t row = 0; row < size; ++row) rows.append();
+            char* dst = static_cast<char*>(rows.get_data()) + stride * first;
+            for (size_t block = 0; block < size; block += CONVERSION_BLOCK_ROWS) {
+                size_t count = std::min(CONVERSION_BLOCK_ROWS, size - block);
+                for (const Column& column : columns) {
+                    const char* src = static_cast<const char*>(column.data) + column.element_size * block;
+                    copy_strided(dst + stride * block + column.offset, stride, src, column.element_size, column.element_size, count);
+                    if (column.type->has_Variable_Length()) _rehome_strings(dst + stride * block + column.offset, stride, count, &arena, rows.get_Arena());
+                }
+            }
+        }
+        /* Scatter `src` in the layout of `Record_Batch` into `row`, whose long String and Blob values should be in the arena of columns */
+        void store(size_t row, const void* src) {
+            for (Column& column : columns) {
+                memcpy(static_cast<char*>(column.data) + column.element_size * row, static_cast<const char*>(src) + column.offset, column.element_size);
+            }
+        }
+        /* Gather `row` into `dst` in the layout of `Record_Batch` */
+        void load(size_t row, void* dst) const {
+            for (const Column& column : columns) {
+                memcpy(static_cast<char*>(dst) + column.offset, static_cast<const char*>(column.data) + column.element_size * row, column.element_size);
+            }
+        }
+        void clear() {
+            size = 0;
+            arena.clear();
+        }
+
+        Column_View operator[](size_t row) {
+            if (row >= size) throw std::out_of_range(("Index Error: Cannot index over the number of rows of type '" + schema->get_name() + "'").c_str());
+            return Column_View(schema.get(), 0, this, row);
+        }
+        Column_View at(size_t row) {
+            return (*this)[row];
+        }
+    };
+
+    inline Type_View Column_View::leaf() const {
+        if (schema->get_Type_Class() != Type_Class::Primitive) {
+            throw std::invalid_argument(("Compile Error: Cannot get data directly of view of type '" + schema->get_name() + "' in columns").c_str());
+        }
+        const Column_Batch::Column& column = batch->columns[batch->offset_to_column[offset]];
+        return Type_View(schema, static_cast<char*>(column.data) + column.element_size * row, &batch->arena);
+    }
+
+    /**
+     * Reductions over contiguous Primitive Types
+     */
+    enum class Reduction {
+        Sum,
+        Min,
+        Max,
+        Mean,
+        Count_Nonzero,
+        /* Number of elements, or of rows in a group of `Group_By` */
+        Count
+    };
+
+    /**
+     * Instruction set used by `reduce`, which is detected at run-time by default
+     */
+    enum class Instruction_Set {
+        Scalar,
+        SSE2,
+        AVX2
+    };
+
+    inline Instruction_Set detect_instruction_set() {
+#if defined(DYNAMIC_STRUCT_X86) && defined(_MSC_VER)
+        static const Instruction_Set instruction_set = []() {
+            int info[4];
+            __cpuid(info, 1);
+            bool os_avx = (info[2] & (1 << 27)) != 0 && (info[2] & (1 << 28)) != 0 && (_xgetbv(0) & 6) == 6;
+            bool popcnt = (info[2] & (1 << 23)) != 0;
+            bool sse2 = (info[3] & (1 << 26)) != 0;
+            __cpuidex(info, 7, 0);
+            bool avx2 = (info[1] & (1 << 5)) != 0;
+            return os_avx && avx2 && popcnt ? Instruction_Set::AVX2 : sse2 ? Instruction_Set::SSE2 : Instruction_Set::Scalar;
+        }();
+        return instruction_set;
+#elif defined(DYNAMIC_STRUCT_X86)
+        static const Instruction_Set instruction_set = []() {
+            __builtin_cpu_init();
+            if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("popcnt")) return Instruction_Set::AVX2;
+            if (__builtin_cpu_supports("sse2")) return Instruction_Set::SSE2;
+            return Instruction_Set::Scalar;
+        }();
+        return instruction_set;
+#else
+        return Instruction_Set::Scalar;
+#endif
+    }
+
+    /**
+     * Result of `reduce`, whose value is stored in the field corresponding to `type`:
+     *  `int_value` for signed integers and Char, `unsigned_value` for unsigned integers and Boolean, `float_value` for floats
+     * Sum is of Int_64, Unsigned_Int_64 or Float_64, Min and Max keep the data type of elements,
+     * Mean is of Float_64, and Count_Nonzero and Count are of Unsigned_Int_64.
+     */
+    struct Reduction_Result {
+        Primitive_Data_Types type;
+        int64_t int_value;
+        uint64_t unsigned_value;
+        double float_value;
+
+        double as_Float_64() const {
+            switch (type) {
+            case Primitive_Data_Types::Float_32:
+            case Primitive_Data_Types::Float_64: return float_value;
+            case Primitive_Data_Types::Unsigned_Int_8:
+            case Primitive_Data_Types::Unsigned_Int_16:
+            case Primitive_Data_Types::Unsigned_Int_32:
+            case Primitive_Data_Types::Unsigned_Int_64:
+            case Primitive_Data_Types::Boolean: return static_cast<double>(unsigned_value);
+            default: return static_cast<double>(int_value);
+            }
+        }
+    };
+
+    template <typename T> struct _Reduction_Traits {
+        typedef int64_t Accumulator;
+        static T lowest() { return std::numeric_limits<T>::lowest(); }
+        static T highest() { return std::numeric_limits<T>::max(); }
+        static void store(Reduction_Result& result, Accumulator value) { result.int_value = value; }
+    };
+    template <> struct _Reduction_Traits<uint8_t> {
+        typedef uint64_t Accumulator;
+        static uint8_t lowest() { return 0; }
+        static uint8_t highest() { return UINT8_MAX; }
+        static void store(Reduction_Result& result, Accumulator value) { result.unsigned_value = value; }
+    };
+    template <> struct _Reduction_Traits<uint16_t>: _Reduction_Traits<uint8_t> {
+        static uint16_t highest() { return UINT16_MAX; }
+    };
+    template <> struct _Reduction_Traits<uint32_t>: _Reduction_Traits<uint8_t> {
+        static uint32_t highest() { return UINT32_MAX; }
+    };
+    template <> struct _Reduction_Traits<uint64_t>: _Reduction_Traits<uint8_t> {
+        static uint64_t highest() { return UINT64_MAX; }
+    };
+    template <> struct _Reduction_Traits<bool>: _Reduction_Traits<uint8_t> {
+        static bool lowest() { return false; }
+        static bool highest() { return true; }
+    };
+    template <> struct _Reduction_Traits<float> {
+        typedef double Accumulator;
+        static float lowest() { return -std::numeric_limits<float>::infinity(); }
+        static float highest() { return std::numeric_limits<float>::infinity(); }
+        static void store(Reduction_Result& result, Accumulator value) { result.float_value = value; }
+    };
+    template <> struct _Reduction_Traits<double>: _Reduction_Traits<float> {
+        static double lowest() { return -std::numeric_limits<double>::infinity(); }
+        static double highest() { return std::numeric_limits<double>::infinity(); }
+    };
+
+    /**
+     * Scalar kernels, unrolled into independent accumulators
+     * NaN is skipped by Min and Max, which is consistent with SIMD kernels.
+     */
+    template <typename T>
+    inline typename _Reduction_Traits<T>::Accumulator _scalar_sum(const T* data, size_t count) {
+        typedef typename _Reduction_Traits<T>::Accumulator Accumulator;
+        Accumulator sum_0 = 0, sum_1 = 0, sum_2 = 0, sum_3 = 0;
+        size_t index = 0;
+        for (; index + 4 <= count; index += 4) {
+            sum_0 += data[index];
+            sum_1 += data[index + 1];
+            sum_2 += data[index + 2];
+            sum_3 += data[index + 3];
+        }
+        for (; index < count; ++index) sum_0 += data[index];
+        return (sum_0 + sum_1) + (sum_2 + sum_3);
+    }
+    template <typename T>
+    inline T _scalar_min(const T* data, size_t count) {
+        T minimum = _Reduction_Traits<T>::highest();
+        for (size_t index = 0; index < count; ++index) minimum = data[index] < minimum ? data[index] : minimum;
+        return minimum;
+    }
+    template <typename T>
+    inline T _scalar_max(const T* data, size_t count) {
+        T maximum = _Reduction_Traits<T>::lowest();
+        for (size_t index = 0; index < count; ++index) maximum = data[index] > maximum ? data[index] : maximum;
+        return maximum;
+    }
+    template <typename T>
+    inline uint64_t _scalar_count_nonzero(const T* data, size_t count) {
+        uint64_t nonzero = 0;
+        for (size_t index = 0; index < count; ++index) nonzero += data[index] != 0;
+        return nonzero;
+    }
+
+#ifdef DYNAMIC_STRUCT_X86
+    /**
+     * SSE2 kernels, which fall back to scalar kernels for instructions missing in SSE2
+     */
+    template <typename T>
+    inline typename _Reduction_Traits<T>::Accumulator _sse2_sum(const T* data, size_t count) { return _scalar_sum(data, count); }
+    template <typename T>
+    inline T _sse2_min(const T* data, size_t count) { return _scalar_min(data, count); }
+    template <typename T>
+    inline T _sse2_max(const T* data, size_t count) { return _scalar_max(data, count); }
+
+    inline unsigned _popcount(unsigned value) {
+        value = value - ((value >> 1) & 0x55555555u);
+        value = (value & 0x33333333u) + ((value >> 2) & 0x33333333u);
+        return (((value + (value >> 4)) & 0x0F0F0F0Fu) * 0x01010101u) >> 24;
+    }
+    DYNAMIC_STRUCT_TARGET("sse2") inline int64_t _sse2_horizontal_sum_64(__m128i value) {
+        int64_t lanes[2];
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes), value);
+        return lanes[0] + lanes[1];
+    }
+    /* Sign-extend 4 x Int_32 into 2 x 2 x Int_64 and accumulate */
+    DYNAMIC_STRUCT_TARGET("sse2") inline __m128i _sse2_add_widened_32(__m128i sum, __m128i value) {
+        __m128i sign = _mm_srai_epi32(value, 31);
+        return _mm_add_epi64(_mm_add_epi64(sum, _mm_unpacklo_epi32(value, sign)), _mm_unpackhi_epi32(value, sign));
+    }
+
+    DYNAMIC_STRUCT_TARGET("sse2") inline double _sse2_sum(const float* data, size_t count) {
+        __m128d sum_0 = _mm_setzero_pd(), sum_1 = _mm_setzero_pd();
+        size_t index = 0;
+        for (; index + 4 <= count; index += 4) {
+            __m128 value = _mm_loadu_ps(data + index);
+            sum_0 = _mm_add_pd(sum_0, _mm_cvtps_pd(value));
+            sum_1 = _mm_add_pd(sum_1, _mm_cvtps_pd(_mm_movehl_ps(value, value)));
+        }
+        double lanes[2];
+        _mm_storeu_pd(lanes, _mm_add_pd(sum_0, sum_1));
+        return lanes[0] + lanes[1] + _scalar_sum(data + index, count - index);
+    }
+    DYNAMIC_STRUCT_TARGET("sse2") inline float _sse2_min(const float* data, size_t count) {
+        __m128 minimum = _mm_set1_ps(_Reduction_Traits<float>::highest());
+        size_t index = 0;
+        for (; index + 4 <= count; index += 4) minimum = _mm_min_ps(_mm_loadu_ps(data + index), minimum);
+        float lanes[4];
+        _mm_storeu_ps(lanes, minimum);
+        float tail = _scalar_min(data + index, count - index);
+        return std::min(std::min(std::min(lanes[0], lanes[1]), std::min(lanes[2], lanes[3])), tail);
+    }
+    DYNAMIC_STRUCT_TARGET("sse2") inline float _sse2_max(const float* data, size_t count) {
+        __m128 maximum = _mm_set1_ps(_Reduction_Traits<float>::lowest());
+        size_t index = 0;
+        for (; index + 4 <= count; index += 4) maximum = _mm_max_ps(_mm_loadu_ps(data + index), maximum);
+        float lanes[4];
+        _mm_storeu_ps(lanes, maximum);
+        float tail = _scalar_max(data + index, count - index);
+        return std::max(std::max(std::max(lanes[0], lanes[1]), std::max(lanes[2], lanes[3])), tail);
+    }
+    DYNAMIC_STRUCT_TARGET("sse2") inline uint64_t _sse2_count_nonzero(const float* data, size_t count) {
+        uint64_t nonzero = 0;
+        size_t index = 0;
+        for (; index + 4 <= count; index += 4) {
+            nonzero += _popcount(_mm_movemask_ps(_mm_cmpneq_ps(_mm_loadu_ps(data + index), _mm_setzero_ps())));
+        }
+        return nonzero + _scalar_count_nonzero(data + index, count - index);
+    }
+
+    DYNAMIC_STRUCT_TARGET("sse2") inline double _sse2_sum(const double* data, size_t count) {
+        __m128d sum_0 = _mm_setzero_pd(), sum_1 = _mm_setzero_pd();
+        size_t index = 0;
+        for (; index + 4 <= count; index += 4) {
+            sum_0 = _mm_add_pd(sum_0, _mm_loadu_pd(data + index));
+            sum_1 = _mm_add_pd(sum_1, _mm_loadu_pd(data + index + 2));
+        }
+        double lanes[2];
+        _mm_storeu_pd(lanes, _mm_add_pd(sum_0, sum_1));
+        return lanes[0] + lanes[1] + _scalar_sum(data + index, count - index);
+    }
+    DYNAMIC_STRUCT_TARGET("sse2") inline double _sse2_min(const double* data, size_t count) {
+        __m128d minimum = _mm_set1_pd(_Reduction_Traits<double>::highest());
+        size_t index = 0;
+        for (; index + 2 <= count; index += 2) minimum = _mm_min_pd(_mm_loadu_pd(data + index), minimum);
+        double lanes[2];
+        _mm_storeu_pd(lanes, minimum);
+        return std::min(std::min(lanes[0], lanes[1]), _scalar_min(data + index, count - index));
+    }
+    DYNAMIC_STRUCT_TARGET("sse2") inline double _sse2_max(const double* data, size_t count) {
+        __m128d maximum = _mm_set1_pd(_Reduction_Traits<double>::lowest());
+        size_t index = 0;
+        for (; index + 2 <= count; index += 2) maximum = _mm_max_pd(_mm_loadu_pd(data + index), maximum);
+        double lanes[2];
+        _mm_storeu_pd(lanes, maximum);
+        return std::max(std::max(lanes[0], lanes[1]), _scalar_max(data + index, count - index));
+    }
+    DYNAMIC_STRUCT_TARGET("sse2") inline uint64_t _sse2_count_nonzero(const double* data, size_t count) {
+        uint64_t nonzero = 0;
+        size_t index = 0;
+        for (; index + 2 <= count; index += 2) {
+            nonzero += _popcount(_mm_movemask_pd(_mm_cmpneq_pd(_mm_loadu_pd(data + index), _mm_setzero_pd())));
+        }
+        return nonzero + _scalar_count_nonzero(data + index, count - index);
+    }
+
+
+    DYNAMIC_STRUCT_TARGET("sse2") inline int64_t _sse2_sum(const int32_t* data, size_t count) {
+        __m128i sum = _mm_setzero_si128();
+        size_t index = 0;
+        for (; index + 4 <= count; index += 4) {
+            sum = _sse2_add_widened_32(sum, _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + index)));
+        }
+        return _sse2_horizontal_sum_64(sum) + _scalar_sum(data + index, count - index);
+    }
+    DYNAMIC_STRUCT_TARGET("sse2") inline uint64_t _sse2_sum(const uint32_t* data, size_t count) {
+        const __m128i zero = _mm_setzero_si128();
+        __m128i sum = _mm_setzero_si128();
+        size_t index = 0;
+        for (; index + 4 <= count; index += 4) {
+            __m128i value = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + index));
+            sum = _mm_add_epi64(_mm_add_epi64(sum, _mm_unpacklo_epi32(value, zero)), _mm_unpackhi_epi32(value, zero));
+        }
+        return static_cast<uint64_t>(_sse2_horizontal_sum_64(sum)) + _scalar_sum(data + index, count - index);
+    }
+    DYNAMIC_STRUCT_TARGET("sse2") inline uint64_t _sse2_count_nonzero_32(const void* data, size_t count) {
+        const __m128i* vectors = static_cast<const __m128i*>(data);
+        // Each lane counts zeros by subtracting the mask of comparison, which is -1 for equality
+        __m128i zero = _mm_setzero_si128();
+        size_t index = 0;
+        for (; index + 4 <= count; index += 4) {
+            zero = _mm_sub_epi32(zero, _mm_cmpeq_epi32(_mm_loadu_si128(vectors + index / 4), _mm_setzero_si128()));
+        }
+        uint32_t lanes[4];
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes), zero);
+        uint64_t zeros = static_cast<uint64_t>(lanes[0]) + lanes[1] + lanes[2] + lanes[3];
+        return index - zeros + _scalar_count_nonzero(static_cast<const uint32_t*>(data) + index, count - index);
+    }
+    inline uint64_t _sse2_count_nonzero(const int32_t* data, size_t count) { return _sse2_count_nonzero_32(data, count); }
+    inline uint64_t _sse2_count_nonzero(const uint32_t* data, size_t count) { return _sse2_count_nonzero_32(data, count); }
+
+    DYNAMIC_STRUCT_TARGET("sse2") inline uint64_t _sse2_sum_64(const void* data, size_t count) {
+        const __m128i* vectors = static_cast<const __m128i*>(data);
+        __m128i sum_0 = _mm_setzero_si128(), sum_1 = _mm_setzero_si128();
+        size_t index = 0;
+        for (; index + 4 <= count; index += 4) {
+            sum_0 = _mm_add_epi64(sum_0, _mm_loadu_si128(vectors + index / 2));
+            sum_1 = _mm_add_epi64(sum_1, _mm_loadu_si128(vectors + index / 2 + 1));
+        }
+        return static_cast<uint64_t>(_sse2_horizontal_sum_64(_mm_add_epi64(sum_0, sum_1))) + _scalar_sum(static_cast<const uint64_t*>(data) + index, count - index);
+    }
+    inline int64_t _sse2_sum(const int64_t* data, size_t count) { return static_cast<int64_t>(_sse2_sum_64(data, count)); }
+    inline uint64_t _sse2_sum(const uint64_t* data, size_t count) { return _sse2_sum_64(data, count); }
+
+    /* Sum bytes with `_mm_sad_epu8`, where `bias` turns Int_8 into unsigned order */
+    DYNAMIC_STRUCT_TARGET("sse2") inline uint64_t _sse2_sum_8(const void* data, size_t count, char bias) {
+        const __m128i* vectors = static_cast<const __m128i*>(data);
+        const __m128i biasing = _mm_set1_epi8(bias);
+        __m128i sum = _mm_setzero_si128();
+        size_t index = 0;
+        for (; index + 16 <= count; index += 16) {
+            sum = _mm_add_epi64(sum, _mm_sad_epu8(_mm_xor_si128(_mm_loadu_si128(vectors + index / 16), biasing), _mm_setzero_si128()));
+        }
+        return static_cast<uint64_t>(_sse2_horizontal_sum_64(sum)) - static_cast<uint8_t>(bias) * static_cast<uint64_t>(index);
+    }
+    inline int64_t _sse2_sum(const int8_t* data, size_t count) {
+        size_t index = count / 16 * 16;
+        return static_cast<int64_t>(_sse2_sum_8(data, count, static_cast<char>(0x80))) + _scalar_sum(data + index, count - index);
+    }
+    inline uint64_t _sse2_sum(const uint8_t* data, size_t count) {
+        size_t index = count / 16 * 16;
+        return _sse2_sum_8(data, count, 0) + _scalar_sum(data + index, count - index);
+    }
+    inline uint64_t _sse2_sum(const bool* data, size_t count) {
+        size_t index = count / 16 * 16;
+        return _sse2_sum_8(data, count, 0) + _scalar_sum(data + index, count - index);
+    }
+    DYNAMIC_STRUCT_TARGET("sse2") inline uint8_t _sse2_min(const uint8_t* data, size_t count) {
+        const __m128i* vectors = reinterpret_cast<const __m128i*>(data);
+        __m128i minimum = _mm_set1_epi8(static_cast<char>(UINT8_MAX));
+        size_t index = 0;
+        for (; index + 16 <= count; index += 16) minimum = _mm_min_epu8(minimum, _mm_loadu_si128(vectors + index / 16));
+        uint8_t lanes[16];
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes), minimum);
+        return std::min(_scalar_min(lanes, 16), _scalar_min(data + index, count - index));
+    }
+    DYNAMIC_STRUCT_TARGET("sse2") inline uint8_t _sse2_max(const uint8_t* data, size_t count) {
+        const __m128i* vectors = reinterpret_cast<const __m128i*>(data);
+        __m128i maximum = _mm_setzero_si128();
+        size_t index = 0;
+        for (; index + 16 <= count; index += 16) maximum = _mm_max_epu8(maximum, _mm_loadu_si128(vectors + index / 16));
+        uint8_t lanes[16];
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes), maximum);
+        return std::max(_scalar_max(lanes, 16), _scalar_max(data + index, count - index));
+    }
+    DYNAMIC_STRUCT_TARGET("sse2") inline uint64_t _sse2_count_nonzero_8(const void* data, size_t count) {
+        const __m128i* vectors = static_cast<const __m128i*>(data);
+        uint64_t zero = 0;
+        size_t index = 0;
+        for (; index + 16 <= count; index += 16) {
+            zero += _popcount(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128(vectors + index / 16), _mm_setzero_si128())));
+        }
+        return index - zero + _scalar_count_nonzero(static_cast<const uint8_t*>(data) + index, count - index);
+    }
+    inline uint64_t _sse2_count_nonzero(const int8_t* data, size_t count) { return _sse2_count_nonzero_8(data, count); }
+    inline uint64_t _sse2_count_nonzero(const uint8_t* data, size_t count) { return _sse2_count_nonzero_8(data, count); }
+    inline uint64_t _sse2_count_nonzero(const bool* data, size_t count) { return _sse2_count_nonzero_8(data, count); }
+
+    template <typename T>
+    inline uint64_t _sse2_count_nonzero(const T* data, size_t count) { return _scalar_count_nonzero(data, count); }
+
+    /**
+     * AVX2 kernels, which fall back to SSE2 kernels for unsupported data types
+     */
+    template <typename T>
+    inline typename _Reduction_Traits<T>::Accumulator _avx2_sum(const T* data, size_t count) { return _sse2_sum(data, count); }
+    template <typename T>
+    inline T _avx2_min(const T* data, size_t count) { return _sse2_min(data, count); }
+    template <typename T>
+    inline T _avx2_max(const T* data, size_t count) { return _sse2_max(data, count); }
+    template <typename T>
+    inline uint64_t _avx2_count_nonzero(const T* data, size_t count) { return _sse2_count_nonzero(data, count); }
+
+    DYNAMIC_STRUCT_TARGET("avx2") inline int64_t _avx2_horizontal_sum_64(__m256i value) {
+        int64_t lanes[4];
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes), value);
+        return (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+    }
+
+    DYNAMIC_STRUCT_TARGET("avx2") inline double _avx2_sum(const float* data, size_t count) {
+        __m256d sum_0 = _mm256_setzero_pd(), sum_1 = _mm256_setzero_pd();
+        size_t index = 0;
+        for (; index + 8 <= count; index += 8) {
+            __m256 value = _mm256_loadu_ps(data + index);
+            sum_0 = _mm256_add_pd(sum_0, _mm256_cvtps_pd(_mm256_castps256_ps128(value)));
+            sum_1 = _mm256_add_pd(sum_1, _mm256_cvtps_pd(_mm256_extractf128_ps(value, 1)));
+        }
+        double lanes[4];
+        _mm256_storeu_pd(lanes, _mm256_add_pd(sum_0, sum_1));
+        return (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]) + _scalar_sum(data + index, count - index);
+    }
+    DYNAMIC_STRUCT_TARGET("avx2") inline float _avx2_min(const float* data, size_t count) {
+        __m256 minimum = _mm256_set1_ps(_Reduction_Traits<float>::highest());
+        size_t index = 0;
+        for (; index + 8 <= count; index += 8) minimum = _mm256_min_ps(_mm256_loadu_ps(data + index), minimum);
+        float lanes[8];
+        _mm256_storeu_ps(lanes, minimum);
+        return std::min(_scalar_min(lanes, 8), _scalar_min(data + index, count - index));
+    }
+    DYNAMIC_STRUCT_TARGET("avx2") inline float _avx2_max(const float* data, size_t count) {
+        __m256 maximum = _mm256_set1_ps(_Reduction_Traits<float>::lowest());
+        size_t index = 0;
+        for (; index + 8 <= count; index += 8) maximum = _mm256_max_ps(_mm256_loadu_ps(data + index), maximum);
+        float lanes[8];
+        _mm256_storeu_ps(lanes, maximum);
+        return std::max(_scalar_max(lanes, 8), _scalar_max(data + index, count - index));
+    }
+    DYNAMIC_STRUCT_TARGET("avx2,popcnt") inline uint64_t _avx2_count_nonzero(const float* data, size_t count) {
+        uint64_t nonzero = 0;
+        size_t index = 0;
+        for (; index + 8 <= count; index += 8) {
+            nonzero += _mm_popcnt_u32(_mm256_movemask_ps(_mm256_cmp_ps(_mm256_loadu_ps(data + index), _mm256_setzero_ps(), _CMP_NEQ_UQ)));
+        }
+        return nonzero + _scalar_count_nonzero(data + index, count - index);
+    }
+
+    DYNAMIC_STRUCT_TARGET("avx2") inline double _avx2_sum(const double* data, size_t count) {
+        __m256d sum_0 = _mm256_setzero_pd(), sum_1 = _mm256_setzero_pd();
+        size_t index = 0;
+        for (; index + 8 <= count; index += 8) {
+            sum_0 = _mm256_add_pd(sum_0, _mm256_loadu_pd(data + index));
+            sum_1 = _mm256_add_pd(sum_1, _mm256_loadu_pd(data + index + 4));
+        }
+        double lanes[4];
+        _mm256_storeu_pd(lanes, _mm256_add_pd(sum_0, sum_1));
+        return (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]) + _scalar_sum(data + index, count - index);
+    }
+    DYNAMIC_STRUCT_TARGET("avx2") inline double _avx2_min(const double* data, size_t count) {
+        __m256d minimum = _mm256_set1_pd(_Reduction_Traits<double>::highest());
+        size_t index = 0;
+        for (; index + 4 <= count; index += 4) minimum = _mm256_min_pd(_mm256_loadu_pd(data + index), minimum);
+        double lanes[4];
+        _mm256_storeu_pd(lanes, minimum);
+        return std::min(_scalar_min(lanes, 4), _scalar_min(data + index, count - index));
+    }
+    DYNAMIC_STRUCT_TARGET("avx2") inline double _avx2_max(const double* data, size_t count) {
+        __m256d maximum = _mm256_set1_pd(_Reduction_Traits<double>::lowest());
+        size_t index = 0;
+        for (; index + 4 <= count; index += 4) maximum = _mm256_max_pd(_mm256_loadu_pd(data + index), maximum);
+        double lanes[4];
+        _mm256_storeu_pd(lanes, maximum);
+        return std::max(_scalar_max(lanes, 4), _scalar_max(data + index, count - index));
+    }
+    DYNAMIC_STRUCT_TARGET("avx2,popcnt") inline uint64_t _avx2_count_nonzero(const double* data, size_t count) {
+        uint64_t nonzero = 0;
+        size_t index = 0;
+        for (; index + 4 <= count; index += 4) {
+            nonzero += _mm_popcnt_u32(_mm256_movemask_pd(_mm256_cmp_pd(_mm256_loadu_pd(data + index), _mm256_setzero_pd(), _CMP_NEQ_UQ)));
+        }
+        return nonzero + _scalar_count_nonzero(data + index, count - index);
+    }
+
+    DYNAMIC_STRUCT_TARGET("avx2") inline int64_t _avx2_sum(const int32_t* data, size_t count) {
+        __m256i sum_0 = _mm256_setzero_si256(), sum_1 = _mm256_setzero_si256();
+        size_t index = 0;
+        for (; index + 8 <= count; index += 8) {
+            __m256i value = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + index));
+            sum_0 = _mm256_add_epi64(sum_0, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(value)));
+            sum_1 = _mm256_add_epi64(sum_1, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(value, 1)));
+        }
+        return _avx2_horizontal_sum_64(_mm256_add_epi64(sum_0, sum_1)) + _scalar_sum(data + index, count - index);
+    }
+    DYNAMIC_STRUCT_TARGET("avx2") inline uint64_t _avx2_sum(const uint32_t* data, size_t count) {
+        __m256i sum_0 = _mm256_setzero_si256(), sum_1 = _mm256_setzero_si256();
+        size_t index = 0;
+        for (; index + 8 <= count; index += 8) {
+            __m256i value = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + index));
+            sum_0 = _mm256_add_epi64(sum_0, _mm256_cvtepu32_epi64(_mm256_castsi256_si128(value)));
+            sum_1 = _mm256_add_epi64(sum_1, _mm256_cvtepu32_epi64(_mm256_extracti128_si256(value, 1)));
+        }
+        return static_cast<uint64_t>(_avx2_horizontal_sum_64(_mm256_add_epi64(sum_0, sum_1))) + _scalar_sum(data + index, count - index);
+    }
+    DYNAMIC_STRUCT_TARGET("avx2") inline int32_t _avx2_min(const int32_t* data, size_t count) {
+        __m256i minimum = _mm256_set1_epi32(INT32_MAX);
+        size_t index = 0;
+        for (; index + 8 <= count; index += 8) minimum = _mm256_min_epi32(minimum, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + index)));
+        int32_t lanes[8];
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes), minimum);
+        return std::min(_scalar_min(lanes, 8), _scalar_min(data + index, count - index));
+    }
+    DYNAMIC_STRUCT_TARGET("avx2") inline int32_t _avx2_max(const int32_t* data, size_t count) {
+        __m256i maximum = _mm256_set1_epi32(INT32_MIN);
+        size_t index = 0;
+        for (; index + 8 <= count; index += 8) maximum = _mm256_max_epi32(maximum, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + index)));
+        int32_t lanes[8];
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes), maximum);
+        return std::max(_scalar_max(lanes, 8), _scalar_max(data + index, count - index));
+    }
+    DYNAMIC_STRUCT_TARGET("avx2") inline uint32_t _avx2_min(const uint32_t* data, size_t count) {
+        __m256i minimum = _mm256_set1_epi32(-1);
+        size_t index = 0;
+        for (; index + 8 <= count; index += 8) minimum = _mm256_min_epu32(minimum, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + index)));
+        uint32_t lanes[8];
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes), minimum);
+        return std::min(_scalar_min(lanes, 8), _scalar_min(data + index, count - index));
+    }
+    DYNAMIC_STRUCT_TARGET("avx2") inline uint32_t _avx2_max(const uint32_t* data, size_t count) {
+        __m256i maximum = _mm256_setzero_si256();
+        size_t index = 0;
+        for (; index + 8 <= count; index += 8) maximum = _mm256_max_epu32(maximum, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + index)));
+        uint32_t lanes[8];
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes), maximum);
+        return std::max(_scalar_max(lanes, 8), _scalar_max(data + index, count - index));
+    }
+    DYNAMIC_STRUCT_TARGET("avx2,popcnt") inline uint64_t _avx2_count_nonzero_32(const void* data, size_t count) {
+        const __m256i* vectors = static_cast<const __m256i*>(data);
+        uint64_t zero = 0;
+        size_t index = 0;
+        for (; index + 8 <= count; index += 8) {
+            zero += _mm_popcnt_u32(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_loadu_si256(vectors + index / 8), _mm256_setzero_si256()))));
+        }
+        return index - zero + _scalar_count_nonzero(static_cast<const uint32_t*>(data) + index, count - index);
+    }
+    inline uint64_t _avx2_count_nonzero(const int32_t* data, size_t count) { return _avx2_count_nonzero_32(data, count); }
+    inline uint64_t _avx2_count_nonzero(const uint32_t* data, size_t count) { return _avx2_count_nonzero_32(data, count); }
+
+    DYNAMIC_STRUCT_TARGET("avx2") inline uint64_t _avx2_sum_64(const void* data, size_t count) {
+        const __m256i* vectors = static_cast<const __m256i*>(data);
+        __m256i sum_0 = _mm256_setzero_si256(), sum_1 = _mm256_setzero_si256();
+        size_t index = 0;
+        for (; index + 8 <= count; index += 8) {
+            sum_0 = _mm256_add_epi64(sum_0, _mm256_loadu_si256(vectors + index / 4));
+            sum_1 = _mm256_add_epi64(sum_1, _mm256_loadu_si256(vectors + index / 4 + 1));
+        }
+        return static_cast<uint64_t>(_avx2_horizontal_sum_64(_mm256_add_epi64(sum_0, sum_1))) + _scalar_sum(static_cast<const uint64_t*>(data) + index, count - index);
+    }
+    inline int64_t _avx2_sum(const int64_t* data, size_t count) { return static_cast<int64_t>(_avx2_sum_64(data, count)); }
+    inline uint64_t _avx2_sum(const uint64_t* data, size_t count) { return _avx2_sum_64(data, count); }
+    /* Min and Max of Int_64 by comparison and blending, where `bias` turns Unsigned_Int_64 into signed order */
+    template <bool is_min>
+    DYNAMIC_STRUCT_TARGET("avx2") inline int64_t _avx2_extreme_64(const int64_t* data, size_t count, int64_t initial, int64_t bias) {
+        const __m256i biasing = _mm256_set1_epi64x(bias);
+        __m256i extreme = _mm256_set1_epi64x(initial ^ bias);
+        size_t index = 0;
+        for (; index + 4 <= count; index += 4) {
+            __m256i value = _mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + index)), biasing);
+            __m256i mask = is_min ? _mm256_cmpgt_epi64(extreme, value) : _mm256_cmpgt_epi64(value, extreme);
+            extreme = _mm256_blendv_epi8(extreme, value, mask);
+        }
+        int64_t lanes[4];
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes), extreme);
+        int64_t result = is_min ? std::min(std::min(lanes[0], lanes[1]), std::min(lanes[2], lanes[3])) : std::max(std::max(lanes[0], lanes[1]), std::max(lanes[2], lanes[3]));
+        return result ^ bias;
+    }
+    inline int64_t _avx2_min(const int64_t* data, size_t count) {
+        size_t index = count / 4 * 4;
+        return std::min(_avx2_extreme_64<true>(data, count, INT64_MAX, 0), _scalar_min(data + index, count - index));
+    }
+    inline int64_t _avx2_max(const int64_t* data, size_t count) {
+        size_t index = count / 4 * 4;
+        return std::max(_avx2_extreme_64<false>(data, count, INT64_MIN, 0), _scalar_max(data + index, count - index));
+    }
+    inline uint64_t _avx2_min(const uint64_t* data, size_t count) {
+        size_t index = count / 4 * 4;
+        uint64_t minimum = static_cast<uint64_t>(_avx2_extreme_64<true>(reinterpret_cast<const int64_t*>(data), count, -1, INT64_MIN));
+        return std::min(minimum, _scalar_min(data + index, count - index));
+    }
+    inline uint64_t _avx2_max(const uint64_t* data, size_t count) {
+        size_t index = count / 4 * 4;
+        uint64_t maximum = static_cast<uint64_t>(_avx2_extreme_64<false>(reinterpret_cast<const int64_t*>(data), count, 0, INT64_MIN));
+        return std::max(maximum, _scalar_max(data + index, count - index));
+    }
+    DYNAMIC_STRUCT_TARGET("avx2,popcnt") inline uint64_t _avx2_count_nonzero_64(const void* data, size_t count) {
+        const __m256i* vectors = static_cast<const __m256i*>(data);
+        uint64_t zero = 0;
+        size_t index = 0;
+        for (; index + 4 <= count; index += 4) {
+            zero += _mm_popcnt_u32(_mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(_mm256_loadu_si256(vectors + index / 4), _mm256_setzero_si256()))));
+        }
+        return index - zero + _scalar_count_nonzero(static_cast<const uint64_t*>(data) + index, count - index);
+    }
+    inline uint64_t _avx2_count_nonzero(const int64_t* data, size_t count) { return _avx2_count_nonzero_64(data, count); }
+    inline uint64_t _avx2_count_nonzero(const uint64_t* data, size_t count) { return _avx2_count_nonzero_64(data, count); }
+
+    /* Sum bytes with `_mm256_sad_epu8`, where `bias` turns Int_8 into unsigned order */
+    DYNAMIC_STRUCT_TARGET("avx2") inline uint64_t _avx2_sum_8(const void* data, size_t count, char bias) {
+        const __m256i* vectors = static_cast<const __m256i*>(data);
+        const __m256i biasing = _mm256_set1_epi8(bias);
+        __m256i sum = _mm256_setzero_si256();
+        size_t index = 0;
+        for (; index + 32 <= count; index += 32) {
+            sum = _mm256_add_epi64(sum, _mm256_sad_epu8(_mm256_xor_si256(_mm256_loadu_si256(vectors + index / 32), biasing), _mm256_setzero_si256()));
+        }
+        return static_cast<uint64_t>(_avx2_horizontal_sum_64(sum)) - static_cast<uint8_t>(bias) * static_cast<uint64_t>(index);
+    }
+    inline int64_t _avx2_sum(const int8_t* data, size_t count) {
+        size_t index = count / 32 * 32;
+        return static_cast<int64_t>(_avx2_sum_8(data, count, static_cast<char>(0x80))) + _scalar_sum(data + index, count - index);
+    }
+    inline uint64_t _avx2_sum(const uint8_t* data, size_t count) {
+        size_t index = count / 32 * 32;
+        return _avx2_sum_8(data, count, 0) + _scalar_sum(data + index, count - index);
+    }
+    inline uint64_t _avx2_sum(const bool* data, size_t count) {
+        size_t index = count / 32 * 32;
+        return _avx2_sum_8(data, count, 0) + _scalar_sum(data + index, count - index);
+    }
+    DYNAMIC_STRUCT_TARGET("avx2") inline int8_t _avx2_min(const int8_t* data, size_t count) {
+        __m256i minimum = _mm256_set1_epi8(INT8_MAX);
+        size_t index = 0;
+        for (; index + 32 <= count; index += 32) minimum = _mm256_min_epi8(minimum, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + index)));
+        int8_t lanes[32];
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes), minimum);
+        return std::min(_scalar_min(lanes, 32), _scalar_min(data + index, count - index));
+    }
+    DYNAMIC_STRUCT_TARGET("avx2") inline int8_t _avx2_max(const int8_t* data, size_t count) {
+        __m256i maximum = _mm256_set1_epi8(INT8_MIN);
+        size_t index = 0;
+        for (; index + 32 <= count; index += 32) maximum = _mm256_max_epi8(maximum, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + index)));
+        int8_t lanes[32];
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes), maximum);
+        return std::max(_scalar_max(lanes, 32), _scalar_max(data + index, count - index));
+    }
+    DYNAMIC_STRUCT_TARGET("avx2") inline uint8_t _avx2_min(const uint8_t* data, size_t count) {
+        __m256i minimum = _mm256_set1_epi8(static_cast<char>(UINT8_MAX));
+        size_t index = 0;
+        for (; index + 32 <= count; index += 32) minimum = _mm256_min_epu8(minimum, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + index)));
+        uint8_t lanes[32];
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes), minimum);
+        return std::min(_scalar_min(lanes, 32), _scalar_min(data + index, count - index));
+    }
+    DYNAMIC_STRUCT_TARGET("avx2") inline uint8_t _avx2_max(const uint8_t* data, size_t count) {
+        __m256i maximum = _mm256_setzero_si256();
+        size_t index = 0;
+        for (; index + 32 <= count; index += 32) maximum = _mm256_max_epu8(maximum, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + index)));
+        uint8_t lanes[32];
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes), maximum);
+        return std::max(_scalar_max(lanes, 32), _scalar_max(data + index, count - index));
+    }
+    DYNAMIC_STRUCT_TARGET("avx2,popcnt") inline uint64_t _avx2_count_nonzero_8(const void* data, size_t count) {
+        const __m256i* vectors = static_cast<const __m256i*>(data);
+        uint64_t zero = 0;
+        size_t index = 0;
+        for (; index + 32 <= count; index += 32) {
+            zero += _mm_popcnt_u32(_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_loadu_si256(vectors + index / 32), _mm256_setzero_si256())));
+        }
+        return index - zero + _scalar_count_nonzero(static_cast<const uint8_t*>(data) + index, count - index);
+    }
+    inline uint64_t _avx2_count_nonzero(const int8_t* data, size_t count) { return _avx2_count_nonzero_8(data, count); }
+    inline uint64_t _avx2_count_nonzero(const uint8_t* data, size_t count) { return _avx2_count_nonzero_8(data, count); }
+    inline uint64_t _avx2_count_nonzero(const bool* data, size_t count) { return _avx2_count_nonzero_8(data, count); }
+
+    DYNAMIC_STRUCT_TARGET("avx2") inline int16_t _avx2_min(const int16_t* data, size_t count) {
+        __m256i minimum = _mm256_set1_epi16(INT16_MAX);
+        size_t index = 0;
+        for (; index + 16 <= count; index += 16) minimum = _mm256_min_epi16(minimum, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + index)));
+        int16_t lanes[16];
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes), minimum);
+        return std::min(_scalar_min(lanes, 16), _scalar_min(data + index, count - index));
+    }
+    DYNAMIC_STRUCT_TARGET("avx2") inline int16_t _avx2_max(const int16_t* data, size_t count) {
+        __m256i maximum = _mm256_set1_epi16(INT16_MIN);
+        size_t index = 0;
+        for (; index + 16 <= count; index += 16) maximum = _mm256_max_epi16(maximum, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + index)));
+        int16_t lanes[16];
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes), maximum);
+        return std::max(_scalar_max(lanes, 16), _scalar_max(data + index, count - index));
+    }
+    DYNAMIC_STRUCT_TARGET("avx2") inline uint16_t _avx2_min(const uint16_t* data, size_t count) {
+        __m256i minimum = _mm256_set1_epi16(-1);
+        size_t index = 0;
+        for (; index + 16 <= count; index += 16) minimum = _mm256_min_epu16(minimum, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + index)));
+        uint16_t lanes[16];
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes), minimum);
+        return std::min(_scalar_min(lanes, 16), _scalar_min(data + index, count - index));
+    }
+    DYNAMIC_STRUCT_TARGET("avx2") inline uint16_t _avx2_max(const uint16_t* data, size_t count) {
+        __m256i maximum = _mm256_setzero_si256();
+        size_t index = 0;
+        for (; index + 16 <= count; index += 16) maximum = _mm256_max_epu16(maximum, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + index)));
+        uint16_t lanes[16];
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes), maximum);
+        return std::max(_scalar_max(lanes, 16), _scalar_max(data + index, count - index));
+    }
+    DYNAMIC_STRUCT_TARGET("avx2,popcnt") inline uint64_t _avx2_count_nonzero_16(const void* data, size_t count) {
+        const __m256i* vectors = static_cast<const __m256i*>(data);
+        uint64_t zero = 0;
+        size_t index = 0;
+        for (; index + 16 <= count; index += 16) {
+            zero += _mm_popcnt_u32(_mm256_movemask_epi8(_mm256_cmpeq_epi16(_mm256_loadu_si256(vectors + index / 16), _mm256_setzero_si256()))) / 2;
+        }
+        return index - zero + _scalar_count_nonzero(static_cast<const uint16_t*>(data) + index, count - index);
+    }
+    inline uint64_t _avx2_count_nonzero(const int16_t* data, size_t count) { return _avx2_count_nonzero_16(data, count); }
+    inline uint64_t _avx2_count_nonzero(const uint16_t* data, size_t count) { return _avx2_count_nonzero_16(data, count); }
+#endif
+
+    template <typename T>
+    inline Reduction_Result _reduce(Reduction operation, const T* data, size_t count, Primitive_Data_Types type, Instruction_Set instruction_set) {
+        Reduction_Result result = { type, 0, 0, 0.0 };
+#ifndef DYNAMIC_STRUCT_X86
+        instruction_set = Instruction_Set::Scalar;
+#endif
+        switch (operation) {
+        case Reduction::Sum:
+        case Reduction::Mean: {
+            typename _Reduction_Traits<T>::Accumulator sum = 0;
+            switch (instruction_set) {
+#ifdef DYNAMIC_STRUCT_X86
+            case Instruction_Set::AVX2: sum = _avx2_sum(data, count); break;
+            case Instruction_Set::SSE2: sum = _sse2_sum(data, count); break;
+#endif
+            default: sum = _scalar_sum(data, count);
+            }
+            if (operation == Reduction::Mean) {
+                result.type = Primitive_Data_Types::Float_64;
+                result.float_value = static_cast<double>(sum) / count;
+            } else {
+                result.type = std::is_floating_point<T>::value ? Primitive_Data_Types::Float_64 :
+                              std::is_same<typename _Reduction_Traits<T>::Accumulator, int64_t>::value ? Primitive_Data_Types::Int_64 : Primitive_Data_Types::Unsigned_Int_64;
+                _Reduction_Traits<T>::store(result, sum);
+            }
+            break;
+        }
+        case Reduction::Min:
+        case Reduction::Max: {
+            bool is_min = operation == Reduction::Min;
+            T extreme = T();
+            switch (instruction_set) {
+#ifdef DYNAMIC_STRUCT_X86
+            case Instruction_Set::AVX2: extreme = is_min ? _avx2_min(data, count) : _avx2_max(data, count); break;
+            case Instruction_Set::SSE2: extreme = is_min ? _sse2_min(data, count) : _sse2_max(data, count); break;
+#endif
+            default: extreme = is_min ? _scalar_min(data, count) : _scalar_max(data, count);
+            }
+            _Reduction_Traits<T>::store(result, extreme);
+            break;
+        }
+        case Reduction::Count_Nonzero: {
+            switch (instruction_set) {
+#ifdef DYNAMIC_STRUCT_X86
+            case Instruction_Set::AVX2: result.unsigned_value = _avx2_count_nonzero(data, count); break;
+            case Instruction_Set::SSE2: result.unsigned_value = _sse2_count_nonzero(data, count); break;
+#endif
+            default: result.unsigned_value = _scalar_count_nonzero(data, count);
+            }
+            result.type = Primitive_Data_Types::Unsigned_Int_64;
+            break;
+        }
+        case Reduction::Count:
+            result.unsigned_value = count;
+            result.type = Primitive_Data_Types::Unsigned_Int_64;
+            break;
+        }
+        return result;
+    }
+
+    /**
+     * Reduce `count` contiguous elements of `type` starting from `data`
+     * It dispatches once on `type` and `instruction_set`, and then runs through the buffer directly.
+     * Min, Max and Mean of no element are rejected, and NaN is skipped by Min and Max.
+     */
+    inline Reduction_Result reduce(Reduction operation, Primitive_Data_Types type, const void* data, size_t count, Instruction_Set instruction_set = detect_instruction_set()) {
+        if (count == 0 && operation != Reduction::Sum && operation != Reduction::Count_Nonzero && operation != Reduction::Count) {
+            throw std::invalid_argument("Value Error: Cannot reduce Min, Max or Mean of no element");
+        }
+        if (data == nullptr && count != 0) {
+            throw std::invalid_argument("Nullpointer Error: Cannot reduce null pointer");
+        }
+        switch (type) {
+        case Primitive_Data_Types::Int_8: return _reduce(operation, static_cast<const int8_t*>(data), count, type, instruction_set);
+        case Primitive_Data_Types::Int_16: return _reduce(operation, static_cast<const int16_t*>(data), count, type, instruction_set);
+        case Primitive_Data_Types::Int_32: return _reduce(operation, static_cast<const int32_t*>(data), count, type, instruction_set);
+        case Primitive_Data_Types::Int_64: return _reduce(operation, static_cast<const int64_t*>(data), count, type, instruction_set);
+
+        case Primitive_Data_Types::Unsigned_Int_8: return _reduce(operation, static_cast<const uint8_t*>(data), count, type, instruction_set);
+        case Primitive_Data_Types::Unsigned_Int_16: return _reduce(operation, static_cast<const uint16_t*>(data), count, type, instruction_set);
+        case Primitive_Data_Types::Unsigned_Int_32: return _reduce(operation, static_cast<const uint32_t*>(data), count, type, instruction_set);
+        case Primitive_Data_Types::Unsigned_Int_64: return _reduce(operation, static_cast<const uint64_t*>(data), count, type, instruction_set);
+
+        case Primitive_Data_Types::Char: {
+            // Char is reduced as Int_8 or Unsigned_Int_8 according to its signedness, but its result is always in `int_value`
+            Reduction_Result result = std::is_signed<char>::value ?
+                _reduce(operation, static_cast<const int8_t*>(data), count, type, instruction_set) :
+                _reduce(operation, static_cast<const uint8_t*>(data), count, type, instruction_set);
+            if (!std::is_signed<char>::value && result.type != Primitive_Data_Types::Unsigned_Int_64) result.int_value = static_cast<int64_t>(result.unsigned_value);
+            if (result.type == Primitive_Data_Types::Unsigned_Int_64 && operation == Reduction::Sum) {
+                result.type = Primitive_Data_Types::Int_64;
+                result.int_value = static_cast<int64_t>(result.unsigned_value);
+            }
+            return result;
+        }
+
+        case Primitive_Data_Types::Boolean: return _reduce(operation, static_cast<const bool*>(data), count, type, instruction_set);
+
+        case Primitive_Data_Types::Float_32: return _reduce(operation, static_cast<const float*>(data), count, type, instruction_set);
+        case Primitive_Data_Types::Float_64: return _reduce(operation, static_cast<const double*>(data), count, type, instruction_set);
+
+        case Primitive_Data_Types::String:
+        case Primitive_Data_Types::Blob:
+            throw std::invalid_argument(("Value Error: Cannot reduce " + get_string_from_type(type)).c_str());
+        }
+        throw std::invalid_argument("Value Error: Unrecognized primitive data type for reduction");
+    }
+    /* Reduce all Primitive Types of a (multi-dimensional) Array, which are contiguous in memory */
+    inline Reduction_Result reduce(Reduction operation, const Type_View& array, Instruction_Set instruction_set = detect_instruction_set()) {
+        size_t count = 1;
+        Type_View element = array;
+        while (element.get_Type_Class() == Type_Class::Array) {
+            count *= element.get_Size();
+            if (element.get_Size() == 0) return reduce(operation, Primitive_Data_Types::Int_8, nullptr, 0, instruction_set);
+            element = element[0];
+        }
+        return reduce(operation, element.get_Type(), array.get_data(), count, instruction_set);
+    }
+    inline Reduction_Result reduce(Reduction operation, Type& array, Instruction_Set instruction_set = detect_instruction_set()) {
+        return reduce(operation, array.view(), instruction_set);
+    }
+    inline Reduction_Result reduce(Reduction operation, Column_Batch& columns, size_t column, Instruction_Set instruction_set = detect_instruction_set()) {
+        return reduce(operation, columns.get_Column_Type(column), columns.get_Column(column), columns.get_Size(), instruction_set);
+    }
+
+    /**
+     * Native Support for Serializing Type
+     * Descriptor:
+     *  Primitive: (#name,#type)
+     *  Array: [#name,#array_length,#sub-type descriptor]
+     *  Struct: {#name,...(sub-type descriptors)}, or {#name:#layout_policy,...} unless the policy is packed
+     * 
+     * For example:
+     *      Type:
+     *          type {
+     *              sub_type {
+     *                  Int_8 x,
+     *                  Int_8 y
+     *              },
+     *              [8]Float_32 var
+     *          }
+     *      is serialized into {type,{sub_type,(x,Int_8),(y,Int_8)},[var,8,(,Float_32)]}
+     */
+    inline std::string Serialize(const Schema& type) {
+        if (type.get_Type_Class() == Type_Class::Primitive) {
+            return "(" + type.get_name() + "," + get_string_from_type(type.get_Type()) + ")";
+        } else if (type.get_Type_Class() == Type_Class::Array) {
+            return "[" + type.get_name() + "," + std::to_string(type.get_Size()) + "," + Serialize(*type.get_Element()) + "]";
+        } else if (type.get_Type_Class() == Type_Class::Struct) {
+            std::string str = "{" + type.get_name();
+            if (type.get_Layout_Policy() != Layout_Policy::Packed) str += ":" + get_string_from_layout_policy(type.get_Layout_Policy());
+            for (size_t pos = 0; pos < type.get_Field_Count(); ++pos) {
+                str += "," + Serialize(*type.get_Field(pos));
+            }
+            str += "}";
+            return str;
+        }
+        throw std::invalid_argument("Value Error: Unrecognized Type pointer");
+    }
+    inline std::string Serialize(Type* type) {
+        return Serialize(*type->get_Schema());
+    }
+    /* Deepest nesting accepted by `Deserialize`, which bounds its recursion */
+    const size_t MAX_DESCRIPTOR_DEPTH = 1024;
+
+    /**
+     * Single pass recursive-descent parser of descriptors, which reads the input in place
+     * Only the resulting nodes are allocated, and errors are reported with their byte position.
+     */
+    class _Descriptor_Parser {
+    private:
+        const char* begin;
+        const char* current;
+        const char* end;
+
+        [[noreturn]] void fail(const char* expectation) const {
+            throw std::invalid_argument(("Value Error: Unable to parse descriptor at position " + std::to_string(current - begin) + ", expect " + expectation).c_str());
+        }
+        void expect(char c) {
+            if (current == end || *current != c) {
+                const char expectation[] = { '\'', c, '\'', '\0' };
+                fail(expectation);
+            }
+            ++current;
+        }
+        /* Names end at the first character forbidden in names */
+        std::string parse_name() {
+            const char* first = current;
+            while (current != end && !strchr("()[]{},:", *current)) ++current;
+            return std::string(first, current);
+        }
+        Primitive_Data_Types parse_primitive_type() {
+            static const Primitive_Data_Types types[] = {
+                Primitive_Data_Types::Int_8, Primitive_Data_Types::Int_16, Primitive_Data_Types::Int_32, Primitive_Data_Types::Int_64,
+                Primitive_Data_Types::Unsigned_Int_8, Primitive_Data_Types::Unsigned_Int_16, Primitive_Data_Types::Unsigned_Int_32, Primitive_Data_Types::Unsigned_Int_64,
+                Primitive_Data_Types::Char, Primitive_Data_Types::Boolean, Primitive_Data_Types::Float_32, Primitive_Data_Types::Float_64,
+                Primitive_Data_Types::String, Primitive_Data_Types::Blob
+            };
+            static const char* names[] = {
+                "Int_8", "Int_16", "Int_32", "Int_64",
+                "Unsigned_Int_8", "Unsigned_Int_16", "Unsigned_Int_32", "Unsigned_Int_64",
+                "Char", "Boolean", "Float_32", "Float_64",
+                "String", "Blob"
+            };
+            const char* first = current;
+            while (current != end && *current != ')') ++current;
+            size_t length = current - first;
+            for (size_t index = 0; index < sizeof(names) / sizeof(names[0]); ++index) {
+                if (strlen(names[index]) == length && memcmp(names[index], first, length) == 0) return types[index];
+            }
+            current = first;
+            fail("name of Primitive Data Type");
+        }
+        Layout_Policy parse_layout_policy() {
+            static const Layout_Policy policies[] = { Layout_Policy::Packed, Layout_Policy::Aligned, Layout_Policy::Compact };
+            static const char* names[] = { "packed", "aligned", "compact" };
+            const char* first = current;
+            while (current != end && *current != ',' && *current != '}') ++current;
+            size_t length = current - first;
+            for (size_t index = 0; index < 3; ++index) {
+                if (strlen(names[index]) == length && memcmp(names[index], first, length) == 0) return policies[index];
+            }
+            current = first;
+            fail("layout policy");
+        }
+        size_t parse_length() {
+            const char* first = current;
+            size_t length = 0;
+            while (current != end && *current >= '0' && *current <= '9') {
+                size_t digit = *current - '0';
+                if (length > (std::numeric_limits<size_t>::max() - digit) / 10) {
+                    current = first;
+                    fail("length of Array within size_t");
+                }
+                length = length * 10 + digit;
+                ++current;
+            }
+            if (current == first) fail("length of Array");
+            return length;
+        }
+        std::shared_ptr<const Schema> parse_type(size_t depth) {
+            if (depth > MAX_DESCRIPTOR_DEPTH) fail(("at most " + std::to_string(MAX_DESCRIPTOR_DEPTH) + " levels of nesting").c_str());
+            if (current == end) fail("'(', '[' or '{'");
+            const char* first = current;
+            switch (*current++) {
+            case '(': {
+                std::string name = parse_name();
+                expect(',');
+                Primitive_Data_Types type = parse_primitive_type();
+                expect(')');
+                return Schema::make_Primitive(type, name);
+            }
+            case '[': {
+                std::string name = parse_name();
+                expect(',');
+                size_t length = parse_length();
+                expect(',');
+                std::shared_ptr<const Schema> element = parse_type(depth + 1);
+                expect(']');
+                try {
+                    return Schema::make_Array(length, element, name);
+                } catch (const std::overflow_error&) {
+                    current = first;
+                    fail("Array within size_t bytes");
+                }
+            }
+            case '{': {
+                std::string name = parse_name();
+                Layout_Policy policy = Layout_Policy::Packed;
+                if (current != end && *current == ':') {
+                    ++current;
+                    policy = parse_layout_policy();
+                }
+                std::vector<std::shared_ptr<const Schema>> fields;
+                while (current != end && *current == ',') {
+                    ++current;
+                    fields.push_back(parse_type(depth + 1));
+                }
+                expect('}');
+                try {
+                    return Schema::make_Struct(std::move(fields), name, policy);
+                } catch (const std::invalid_argument&) {
+                    current = first;
+                    fail("Struct without duplicate properties");
+                }
+            }
+            default:
+                --current;
+                fail("'(', '[' or '{'");
+            }
+        }
+    public:
+        _Descriptor_Parser(const char* src, size_t length):begin(src), current(src), end(src + length) {}
+        std::shared_ptr<const Schema> parse() {
+            std::shared_ptr<const Schema> schema = parse_type(0);
+            if (current != end) fail("end of descriptor");
+            return schema;
+        }
+    };
+
+    /**
+     * Native Support for Deserializing Type
+     * \param src serialized type
+     * 
+     * Descriptor:
+     *  Primitive: (#name,#type)
+     *  Array: [#name,#array_length,#sub-type descriptor]
+     *  Struct: {#name,...(sub-type descriptors)}, or {#name:#layout_policy,...} unless the policy is packed
+     * 
+     * For example:
+     *      Type:
+     *          {type,{sub_type,(x,Int_8),(y,Int_8)},[var,8,(,Float_32)]}
+     *      is deserialized into
+     *          type {
+     *              sub_type {
+     *                  Int_8 x,
+     *                  Int_8 y
+     *              },
+     *              [8]Float_32 var
+     *          }
+     * The descriptor is parsed in a single pass, and errors carry the byte position where parsing stopped.
+     */
+    inline std::shared_ptr<const Schema> Deserialize_Schema(const char* src, size_t length) {
+        return _Descriptor_Parser(src, length).parse();
+    }
+    inline std::shared_ptr<const Schema> Deserialize_Schema(const std::string& src) {
+        return Deserialize_Schema(src.data(), src.length());
+    }
+    inline std::unique_ptr<Type> Deserialize(const std::string& src) {
+        return instantiate(Deserialize_Schema(src));
+    }
+
+    /**
+     * Binary Descriptor
+     *  Version: one byte of `BINARY_DESCRIPTOR_VERSION`
+     *  Name Table: varint count, then each name as varint length followed by its bytes, without duplication
+     *  Nodes: in pre-order, each starting with a tag byte followed by the varint index of its name
+     *      Primitive: tag `0` to `11` in the order of `Primitive_Data_Types` up to Float_64, or `BINARY_TAG_STRING` plus 0 for String and 1 for Blob
+     *      Array: tag `BINARY_TAG_ARRAY`, varint length, then the node of element
+     *      Struct: tag `BINARY_TAG_STRUCT` plus `Layout_Policy`, varint number of properties, then their nodes
+     * Varints are unsigned LEB128, so the descriptor does not depend on the byte order of the machine.
+     */
+    const uint8_t BINARY_DESCRIPTOR_VERSION = 1;
+    const uint8_t BINARY_TAG_ARRAY = 12;
+    const uint8_t BINARY_TAG_STRUCT = 13;
+    /* Tags of String and Blob follow those of Struct, so that descriptors written before keep their tags */
+    const uint8_t BINARY_TAG_STRING = 16;
+
+    inline void _write_varint(std::string& dst, uint64_t value) {
+        while (value >= 0x80) {
+            dst.push_back(static_cast<char>((value & 0x7F) | 0x80));
+            value >>= 7;
+        }
+        dst.push_back(static_cast<char>(value));
+    }
+
+    inline void _serialize_binary_node(const Schema& type, std::string& nodes, std::unordered_map<std::string, size_t>& name_to_index, std::vector<const std::string*>& names) {
+        auto inserted = name_to_index.insert(std::make_pair(type.get_name(), names.size()));
+        if (inserted.second) names.push_back(&inserted.first->first);
+        switch (type.get_Type_Class()) {
+        case Type_Class::Primitive:
+            if (is_variable_length(type.get_Type())) {
+                nodes.push_back(static_cast<char>(BINARY_TAG_STRING + (type.get_Type() == Primitive_Data_Types::Blob ? 1 : 0)));
+            } else {
+                nodes.push_back(static_cast<char>(type.get_Type()));
+            }
+            _write_varint(nodes, inserted.first->second);
+            break;
+        case Type_Class::Array:
+            nodes.push_back(static_cast<char>(BINARY_TAG_ARRAY));
+            _write_varint(nodes, inserted.first->second);
+            _write_varint(nodes, type.get_Size());
+            _serialize_binary_node(*type.get_Element(), nodes, name_to_index, names);
+            break;
+        case Type_Class::Struct:
+            nodes.push_back(static_cast<char>(BINARY_TAG_STRUCT + static_cast<uint8_t>(type.get_Layout_Policy())));
+            _write_varint(nodes, inserted.first->second);
+            _write_varint(nodes, type.get_Field_Count());
+            for (size_t pos = 0; pos < type.get_Field_Count(); ++pos) _serialize_binary_node(*type.get_Field(pos), nodes, name_to_index, names);
+            break;
+        }
+    }
+    /**
+     * Encode `type` into the binary descriptor, which is lossless and much smaller than the text of `Serialize`
+     */
+    inline std::string Serialize_Binary(const Schema& type) {
+        std::string nodes;
+        std::unordered_map<std::string, size_t> name_to_index;
+        std::vector<const std::string*> names;
+        _serialize_binary_node(type, nodes, name_to_index, names);
+
+        std::string descriptor(1, static_cast<char>(BINARY_DESCRIPTOR_VERSION));
+        _write_varint(descriptor, names.size());
+        for (const std::string* name : names) {
+            _write_varint(descriptor, name->length());
+            descriptor += *name;
+        }
+        descriptor += nodes;
+        return descriptor;
+    }
+    inline std::string Serialize_Binary(Type* type) {
+        return Serialize_Binary(*type->get_Schema());
+    }
+
+    /**
+     * Decoder of binary descriptors, which walks nodes in a loop with an explicit stack instead of recursion
+     */
+    class _Binary_Descriptor_Decoder {
+    private:
+        struct Frame {
+            uint8_t tag;
+            size_t name;
+            size_t length;
+            std::vector<std::shared_ptr<const Schema>> fields;
+        };
+        const unsigned char* begin;
+        const unsigned char* current;
+        const unsigned char* end;
+        /* Names point into the input, and are only copied into nodes */
+        std::vector<std::pair<const char*, size_t>> names;
+
+        [[noreturn]] void fail(const char* expectation) const {
+            throw std::invalid_argument(("Value Error: Unable to decode binary descriptor at position " + std::to_string(current - begin) + ", expect " + expectation).c_str());
+        }
+        uint64_t read_varint() {
+            uint64_t value = 0;
+            for (unsigned shift = 0; shift < 64; shift += 7) {
+                if (current == end) fail("varint");
+                uint64_t byte = *current++;
+                if (shift == 63 && byte > 1) break;
+                value |= (byte & 0x7F) << shift;
+                if ((byte & 0x80) == 0) return value;
+            }
+            fail("varint within 64 bits");
+        }
+        size_t read_name_index() {
+            uint64_t index = read_varint();
+            if (index >= names.size()) fail("index into name table");
+            return static_cast<size_t>(index);
+        }
+        std::string name_of(size_t index) const {
+            return std::string(names[index].first, names[index].second);
+        }
+    public:
+        _Binary_Descriptor_Decoder(const void* src, size_t length):begin(static_cast<const unsigned char*>(src)), current(begin), end(begin + length) {}
+        std::shared_ptr<const Schema> decode() {
+            if (current == end || *current != BINARY_DESCRIPTOR_VERSION) fail("version of binary descriptor");
+            ++current;
+            uint64_t name_count = read_varint();
+            // Every name takes at least one byte, which bounds the table by the input
+            if (name_count > static_cast<uint64_t>(end - current)) fail("name table within descriptor");
+            names.reserve(name_count);
+            for (uint64_t index = 0; index < name_count; ++index) {
+                uint64_t length = read_varint();
+                if (length > static_cast<uint64_t>(end - current)) fail("name within descriptor");
+                names.push_back(std::make_pair(reinterpret_cast<const char*>(current), static_cast<size_t>(length)));
+                current += length;
+            }
+
+            std::vector<Frame> stack;
+            std::shared_ptr<const Schema> node;
+            while (true) {
+                if (current == end) fail("tag of node");
+                const unsigned char* first = current;
+                uint8_t tag = *current++;
+                if (tag > BINARY_TAG_STRING + 1) {
+                    current = first;
+                    fail("tag of node");
+                }
+                size_t name = read_name_index();
+                if (tag < BINARY_TAG_ARRAY) {
+                    node = Schema::make_Primitive(static_cast<Primitive_Data_Types>(tag), name_of(name));
+                } else if (tag >= BINARY_TAG_STRING) {
+                    node = Schema::make_Primitive(tag == BINARY_TAG_STRING ? Primitive_Data_Types::String : Primitive_Data_Types::Blob, name_of(name));
+                } else {
+                    uint64_t length = read_varint();
+                    if (length > std::numeric_limits<size_t>::max()) fail("length within size_t");
+                    if (tag >= BINARY_TAG_STRUCT && length == 0) {
+                        node = Schema::make_Struct({}, name_of(name), static_cast<Layout_Policy>(tag - BINARY_TAG_STRUCT));
+                    } else {
+                        if (stack.size() >= MAX_DESCRIPTOR_DEPTH) fail(("at most " + std::to_string(MAX_DESCRIPTOR_DEPTH) + " levels of nesting").c_str());
+                        stack.push_back({ tag, name, static_cast<size_t>(length), {} });
+                        // Every property takes at least two bytes, which bounds the reservation by the input
+                        if (tag >= BINARY_TAG_STRUCT) stack.back().fields.reserve(std::min<size_t>(length, (end - current) / 2));
+                        continue;
+                    }
+                }
+                // Complete every frame whose children are all decoded
+                while (!stack.empty()) {
+                    Frame& top = stack.back();
+                    if (top.tag == BINARY_TAG_ARRAY) {
+                        try {
+                            node = Schema::make_Array(top.length, node, name_of(top.name));
+                        } catch (const std::overflow_error&) {
+                            fail("Array within size_t bytes");
+                        }
+                    } else {
+                        top.fields.push_back(std::move(node));
+                        if (top.fields.size() < top.length) break;
+                        try {
+                            node = Schema::make_Struct(std::move(top.fields), name_of(top.name), static_cast<Layout_Policy>(top.tag - BINARY_TAG_STRUCT));
+                        } catch (const std::invalid_argument&) {
+                            fail("Struct without duplicate properties");
+                        }
+                    }
+                    stack.pop_back();
+                }
+                if (stack.empty()) break;
+            }
+            if (current != end) fail("end of descriptor");
+            return node;
+        }
+    };
+
+    /* Decode a binary descriptor written by `Serialize_Binary` */
+    inline std::shared_ptr<const Schema> Deserialize_Binary(const void* src, size_t length) {
+        return _Binary_Descriptor_Decoder(src, length).decode();
+    }
+    inline std::shared_ptr<const Schema> Deserialize_Binary(const std::string& src) {
+        return Deserialize_Binary(src.data(), src.length());
+    }
+    /* Convert the text of `Serialize` into the binary descriptor */
+    inline std::string text_to_binary_descriptor(const std::string& text) {
+        return Serialize_Binary(*Deserialize_Schema(text));
+    }
+    /* Convert the binary descriptor back into the text of `Serialize` */
+    inline std::string binary_to_text_descriptor(const std::string& binary) {
+        return Serialize(*Deserialize_Binary(binary));
+    }
+
+    /**
+     * Binary Format of Values
+     *  Header: `Binary_Header`
+     *  Descriptor: the descriptor of `Serialize`
+     *  Payload: rows back to back, starting at a multiple of `BINARY_PAYLOAD_ALIGNMENT` bytes so that it could be mapped directly
+     *  Arena: only for types with String or Blob, the `uint64_t` Bytes of the arena followed by the arena as is
+     * 
+     * Values are stored in the byte order of the machine, which is recorded by the byte-order mark.
+     */
+    const char BINARY_MAGIC[4] = { 'D', 'S', 'T', 'B' };
+    /* Version of the layout of rows, which increases whenever the bytes of the same descriptor change */
+    const uint32_t BINARY_LAYOUT_VERSION = 1;
+    const uint32_t BINARY_BYTE_ORDER_MARK = 0x01020304;
+    const size_t BINARY_PAYLOAD_ALIGNMENT = 64;
+
+    struct Binary_Header {
+        char magic[4];
+        uint32_t layout_version;
+        uint32_t byte_order_mark;
+        /* Bytes of the descriptor following the header */
+        uint32_t descriptor_length;
+        /* Bytes of each row */
+        uint64_t stride;
+        uint64_t rows;
+        /* Bytes between the beginning of file and the payload */
+        uint64_t payload_offset;
+    };
+    static_assert(sizeof(Binary_Header) == 40, "Binary_Header must not contain padding");
+
+    inline Binary_Header make_binary_header(const std::string& descriptor, size_t stride, size_t rows) {
+        if (descriptor.length() > std::numeric_limits<uint32_t>::max()) {
+            throw std::overflow_error("Memory Error: Descriptor is too long to be saved");
+        }
+        Binary_Header header;
+        memcpy(header.magic, BINARY_MAGIC, sizeof(BINARY_MAGIC));
+        header.layout_version = BINARY_LAYOUT_VERSION;
+        header.byte_order_mark = BINARY_BYTE_ORDER_MARK;
+        header.descriptor_length = static_cast<uint32_t>(descriptor.length());
+        header.stride = stride;
+        header.rows = rows;
+        size_t end_of_descriptor = sizeof(Binary_Header) + descriptor.length();
+        header.payload_offset = (end_of_descriptor + BINARY_PAYLOAD_ALIGNMENT - 1) / BINARY_PAYLOAD_ALIGNMENT * BINARY_PAYLOAD_ALIGNMENT;
+        return header;
+    }
+    /* Check the fields of `header` which do not depend on the descriptor */
+    inline void check_binary_header(const Binary_Header& header) {
+        if (memcmp(header.magic, BINARY_MAGIC, sizeof(BINARY_MAGIC)) != 0) {
+            throw std::invalid_argument("Value Error: Not a binary file of dynamic struct");
+        }
+        if (header.layout_version != BINARY_LAYOUT_VERSION) {
+            throw std::invalid_argument(("Value Error: Unsupported layout version " + std::to_string(header.layout_version)).c_str());
+        }
+        if (header.byte_order_mark != BINARY_BYTE_ORDER_MARK) {
+            throw std::invalid_argument("Value Error: Byte order of binary file does not match this machine");
+        }
+        if (header.payload_offset < sizeof(Binary_Header) + header.descriptor_length || header.payload_offset % BINARY_PAYLOAD_ALIGNMENT != 0) {
+            throw std::invalid_argument("Value Error: Corrupted offset of payload in binary file");
+        }
+    }
+    /* Check the header against the type deserialized from its descriptor */
+    inline void check_binary_schema(const Binary_Header& header, const Schema& type) {
+        if (header.stride != type.size_of()) {
+            throw std::invalid_argument(("Value Error: Bytes of rows in binary file do not match type '" + type.get_name() + "'").c_str());
+        }
+        if (header.stride != 0 && header.rows > std::numeric_limits<size_t>::max() / header.stride) {
+            throw std::overflow_error(("Memory Error: Too many rows of type '" + type.get_name() + "' in binary file").c_str());
+        }
+    }
+    inline void check_binary_schema(const Binary_Header& header, const Type* type) {
+        check_binary_schema(header, *type->get_Schema());
+    }
+
+    /* Collect offsets of Primitive Types inside `type` whose data type satisfies `match` */
+    inline void _collect_offsets(const Schema& type, size_t offset, bool (*match)(Primitive_Data_Types), std::vector<size_t>& offsets) {
+        switch (type.get_Type_Class()) {
+        case Type_Class::Primitive:
+            if (match(type.get_Type())) offsets.push_back(offset);
+            break;
+        case Type_Class::Array: {
+            // Collect the element once, then repeat it for each position
+            std::vector<size_t> element_offsets;
+            const Schema& element_type = *type.get_Element();
+            _collect_offsets(element_type, 0, match, element_offsets);
+            if (element_offsets.empty()) break;
+            for (size_t pos = 0; pos < type.get_Size(); ++pos) {
+                for (size_t element_offset : element_offsets) offsets.push_back(offset + element_type.size_of() * pos + element_offset);
+            }
+            break;
+        }
+        case Type_Class::Struct:
+            for (size_t pos = 0; pos < type.get_Field_Count(); ++pos) _collect_offsets(*type.get_Field(pos), offset + type.get_Field_Offset(pos), match, offsets);
+            break;
+        }
+    }
+    inline bool _is_boolean(Primitive_Data_Types type) {
+        return type == Primitive_Data_Types::Boolean;
+    }
+    /**
+     * Validate raw rows of `type`, since not every byte pattern is a legal value
+     * Currently, each Boolean must be either 0 or 1, and each long String or Blob must lie inside `arena`.
+     */
+    inline void validate_binary(const Schema& type, const void* data, size_t rows, const String_Arena* arena = nullptr) {
+        std::vector<size_t> offsets;
+        _collect_offsets(type, 0, _is_boolean, offsets);
+        const unsigned char* bytes = static_cast<const unsigned char*>(data);
+        size_t stride = type.size_of();
+        if (!offsets.empty()) {
+            for (size_t row = 0; row < rows; ++row) {
+                for (size_t offset : offsets) {
+                    if (bytes[stride * row + offset] > 1) {
+                        throw std::invalid_argument(("Value Error: Illegal Boolean at row " + std::to_string(row) + " of type '" + type.get_name() + "'").c_str());
+                    }
+                }
+            }
+        }
+        if (!type.has_Variable_Length()) return;
+        offsets.clear();
+        _collect_offsets(type, 0, is_variable_length, offsets);
+        for (size_t row = 0; row < rows; ++row) {
+            for (size_t offset : offsets) {
+                String_Ref value;
+                if (load_string(bytes + stride * row + offset, arena, value) != Status::Ok) {
+                    throw std::invalid_argument(("Value Error: Illegal String or Blob at row " + std::to_string(row) + " of type '" + type.get_name() + "', which is outside its arena").c_str());
+                }
+            }
+        }
+    }
+    inline void validate_binary(const Type* type, const void* data, size_t rows, const String_Arena* arena = nullptr) {
+        validate_binary(*type->get_Schema(), data, rows, arena);
+    }
+
+    inline void _save_binary(std::ostream& stream, const std::string& descriptor, size_t stride, size_t rows, const void* payload) {
+        Binary_Header header = make_binary_header(descriptor, stride, rows);
+        char padding[BINARY_PAYLOAD_ALIGNMENT] = { 0 };
+        stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        stream.write(descriptor.data(), descriptor.length());
+        stream.write(padding, header.payload_offset - sizeof(header) - descriptor.length());
+        stream.write(static_cast<const char*>(payload), stride * rows);
+        if (!stream) throw std::runtime_error("IO Error: Fail to write binary data");
+    }
+    /* Write the arena following the payload of a type with String or Blob, where no arena is empty */
+    inline void _save_arena(std::ostream& stream, const String_Arena* arena) {
+        uint64_t length = arena == nullptr ? 0 : arena->get_Size();
+        stream.write(reinterpret_cast<const char*>(&length), sizeof(length));
+        if (length != 0) stream.write(arena->get_data(), length);
+        if (!stream) throw std::runtime_error("IO Error: Fail to write arena of binary data");
+    }
+    /* Read the header and the descriptor, leaving `stream` at the beginning of payload */
+    inline std::shared_ptr<const Schema> _load_binary_schema(std::istream& stream, Binary_Header& header) {
+        if (!stream.read(reinterpret_cast<char*>(&header), sizeof(header))) {
+            throw std::runtime_error("IO Error: Fail to read header of binary data");
+        }
+        check_binary_header(header);
+        std::string descriptor(header.descriptor_length, '\0');
+        if (!stream.read(&descriptor[0], header.descriptor_length)) {
+            throw std::runtime_error("IO Error: Fail to read descriptor of binary data");
+        }
+        std::shared_ptr<const Schema> type = Deserialize_Schema(descriptor);
+        check_binary_schema(header, *type);
+        if (!stream.ignore(header.payload_offset - sizeof(header) - header.descriptor_length)) {
+            throw std::runtime_error("IO Error: Fail to read binary data");
+        }
+        return type;
+    }
+    /**
+     * Read rows into `data`, and the arena of a type with String or Blob into `arena`
+     * Values are read into `arena` directly if it is empty, or are copied into it after validation otherwise, e.g. for a row of `Record_Batch`.
+     */
+    inline void _load_binary_payload(std::istream& stream, const Binary_Header& header, const Schema& type, void* data, String_Arena* arena) {
+        if (!stream.read(static_cast<char*>(data), header.stride * header.rows)) {
+            throw std::runtime_error(("IO Error: Fail to read rows of type '" + type.get_name() + "'").c_str());
+        }
+        if (!type.has_Variable_Length()) {
+            validate_binary(type, data, header.rows);
+            return;
+        }
+        if (arena == nullptr) throw std::invalid_argument(("Nullpointer Error: Cannot load String or Blob of type '" + type.get_name() + "' without an arena").c_str());
+        String_Arena loaded;
+        String_Arena& target = arena->get_Size() == 0 ? *arena : loaded;
+        uint64_t length;
+        if (!stream.read(reinterpret_cast<char*>(&length), sizeof(length))) {
+            throw std::runtime_error(("IO Error: Fail to read arena of type '" + type.get_name() + "'").c_str());
+        }
+        if (length > std::numeric_limits<size_t>::max()) throw std::overflow_error(("Memory Error: Arena of type '" + type.get_name() + "' is too large").c_str());
+        target.resize(static_cast<size_t>(length));
+        if (length != 0 && !stream.read(target.get_data(), length)) {
+            throw std::runtime_error(("IO Error: Fail to read arena of type '" + type.get_name() + "'").c_str());
+        }
+        validate_binary(type, data, header.rows, &target);
+        if (&target == arena) return;
+        std::vector<size_t> offsets;
+        _collect_offsets(type, 0, is_variable_length, offsets);
+        for (size_t offset : offsets) _rehome_strings(static_cast<char*>(data) + offset, header.stride, header.rows, &loaded, *arena);
+    }
+
+    /**
+     * Save the descriptor and the raw data of an instance of `type`, which could be restored by `Load`
+     * \param type initialized or holding data
+     */
+    inline void Save(std::ostream& stream, Type* type) {
+        if (type->get_data() == nullptr) {
+            throw std::invalid_argument(("Nullpointer Error: Type '" + type->get_name() + "' has not been initialized").c_str());
+        }
+        _save_binary(stream, Serialize(type), type->size_of(), 1, type->get_data());
+        if (type->get_Schema()->has_Variable_Length()) _save_arena(stream, type->get_Arena());
+    }
+    /* Save the descriptor and all rows of `batch`, which could be restored by `Load_Batch` */
+    inline void Save(std::ostream& stream, const Record_Batch& batch) {
+        _save_binary(stream, Serialize(*batch.get_Schema()), batch.get_Stride(), batch.get_Size(), batch.get_data());
+        if (batch.get_Schema()->has_Variable_Length()) _save_arena(stream, &batch.get_Arena());
+    }
+    /* Restore an instance saved by `Save`, reading its data into the buffer of `init()` at once */
+    inline std::unique_ptr<Type> Load(std::istream& stream) {
+        Binary_Header header;
+        std::unique_ptr<Type> type = instantiate(_load_binary_schema(stream, header));
+        if (header.rows != 1) {
+            throw std::invalid_argument(("Value Error: Expect 1 row of type '" + type->get_name() + "' but found " + std::to_string(header.rows)).c_str());
+        }
+        type->init();
+        _load_binary_payload(stream, header, *type->get_Schema(), type->get_data(), type->get_Arena());
+        return type;
+    }
+    /**
+     * Restore an instance saved by `Save` into `type`, whose descriptor must be the same as the saved one
+     * `type` is initialized if it does not have any data.
+     */
+    inline void Load(std::istream& stream, Type* type) {
+        Binary_Header header;
+        std::shared_ptr<const Schema> saved_type = _load_binary_schema(stream, header);
+        if (header.rows != 1 || saved_type != type->get_Schema()) {
+            throw std::invalid_argument(("Value Error: Saved data does not match type '" + type->get_name() + "'").c_str());
+        }
+        if (type->get_data() == nullptr) type->init();
+        _load_binary_payload(stream, header, *saved_type, type->get_data(), type->get_Arena());
+    }
+    /* Restore rows saved by `Save`, reading all of them into the buffer of `Record_Batch` at once */
+    inline std::unique_ptr<Record_Batch> Load_Batch(std::istream& stream) {
+        Binary_Header header;
+        std::shared_ptr<const Schema> type = _load_binary_schema(stream, header);
+        std::unique_ptr<Record_Batch> batch(new Record_Batch(type));
+        batch->resize(header.rows);
+        _load_binary_payload(stream, header, *type, batch->get_data(), &batch->get_Arena());
+        return batch;
+    }
+
+    enum class Map_Mode {
+        Read_Only,
+        Read_Write
+    };
+
+    /**
+     * Rows of a binary file written by `Save` or by this class, mapped into memory
+     * Rows are never copied or parsed: each row is a `Type_View` into the mapping, so that opening a file costs
+     * the same regardless of its size and the page cache is shared among processes mapping the same file.
+     * 
+     * Notice that rows of a `Read_Only` file must not be modified, and that growing a writable file remaps it,
+     * which invalidates every view or pointer into the previous mapping.
+     * Values are not validated when mapped, so `validate_binary` should be called on files which are not trusted.
+     */
+    class Mapped_Record_File {
+    private:
+        std::string path;
+        Map_Mode mode;
+        std::shared_ptr<const Schema> schema;
+        size_t stride;
+        size_t size;
+        size_t capacity;
+        size_t payload_offset;
+        char* mapping;
+        size_t mapping_length;
+#if defined(_WIN32)
+        HANDLE file;
+        HANDLE file_mapping;
+#else
+        int file;
+#endif
+        Binary_Header* header() { return reinterpret_cast<Binary_Header*>(mapping); }
+
+        void open_file(bool create) {
+#if defined(_WIN32)
+            DWORD access = mode == Map_Mode::Read_Only ? GENERIC_READ : GENERIC_READ | GENERIC_WRITE;
+            file = CreateFileA(path.c_str(), access, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, create ? CREATE_ALWAYS : OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+            if (file == INVALID_HANDLE_VALUE) throw std::runtime_error(("IO Error: Fail to open file '" + path + "'").c_str());
+            file_mapping = nullptr;
+#else
+            int flags = mode == Map_Mode::Read_Only ? O_RDONLY : O_RDWR;
+            if (create) flags |= O_CREAT | O_TRUNC;
+            file = ::open(path.c_str(), flags, 0644);
+            if (file < 0) throw std::runtime_error(("IO Error: Fail to open file '" + path + "'").c_str());
+#endif
+        }
+        size_t file_length() {
+#if defined(_WIN32)
+            LARGE_INTEGER length;
+            if (!GetFileSizeEx(file, &length)) throw std::runtime_error(("IO Error: Fail to get size of file '" + path + "'").c_str());
+            return static_cast<size_t>(length.QuadPart);
+#else
+            struct stat status;
+            if (fstat(file, &status) != 0) throw std::runtime_error(("IO Error: Fail to get size of file '" + path + "'").c_str());
+            return static_cast<size_t>(status.st_size);
+#endif
+        }
+        void resize_file(size_t length) {
+#if defined(_WIN32)
+            LARGE_INTEGER position;
+            position.QuadPart = static_cast<LONGLONG>(length);
+            if (!SetFilePointerEx(file, position, nullptr, FILE_BEGIN) || !SetEndOfFile(file)) {
+                throw std::runtime_error(("IO Error: Fail to resize file '" + path + "'").c_str());
+            }
+#else
+            if (ftruncate(file, static_cast<off_t>(length)) != 0) throw std::runtime_error(("IO Error: Fail to resize file '" + path + "'").c_str());
+#endif
+        }
+        void map(size_t length) {
+#if defined(_WIN32)
+            DWORD protection = mode == Map_Mode::Read_Only ? PAGE_READONLY : PAGE_READWRITE;
+            file_mapping = CreateFileMappingA(file, nullptr, protection, static_cast<DWORD>(static_cast<uint64_t>(length) >> 32), static_cast<DWORD>(length & 0xFFFFFFFF), nullptr);
+            if (file_mapping == nullptr) throw std::runtime_error(("IO Error: Fail to map file '" + path + "'").c_str());
+            void* address = MapViewOfFile(file_mapping, mode == Map_Mode::Read_Only ? FILE_MAP_READ : FILE_MAP_WRITE, 0, 0, length);
+            if (address == nullptr) throw std::runtime_error(("IO Error: Fail to map file '" + path + "'").c_str());
+#else
+            int protection = mode == Map_Mode::Read_Only ? PROT_READ : PROT_READ | PROT_WRITE;
+            void* address = mmap(nullptr, length, protection, MAP_SHARED, file, 0);
+            if (address == MAP_FAILED) throw std::runtime_error(("IO Error: Fail to map file '" + path + "'").c_str());
+#endif
+            mapping = static_cast<char*>(address);
+            mapping_length = length;
+        }
+        void unmap() {
+#if defined(_WIN32)
+            if (mapping != nullptr) UnmapViewOfFile(mapping);
+            if (file_mapping != nullptr) CloseHandle(file_mapping);
+            file_mapping = nullptr;
+#else
+            if (mapping != nullptr) munmap(mapping, mapping_length);
+#endif
+            mapping = nullptr;
+            mapping_length = 0;
+        }
+        void close_file() {
+            unmap();
+#if defined(_WIN32)
+            if (file != INVALID_HANDLE_VALUE) CloseHandle(file);
+            file = INVALID_HANDLE_VALUE;
+#else
+            if (file >= 0) ::close(file);
+            file = -1;
+#endif
+        }
+        void check_writable() const {
+            if (mode == Map_Mode::Read_Only) {
+                throw std::invalid_argument(("Value Error: File '" + path + "' is mapped as read-only").c_str());
+            }
+        }
+        /* Rows of String or Blob cannot be mapped, since long values live in an arena outside of the rows */
+        static void check_fixed_length(const Schema& type) {
+            if (type.has_Variable_Length()) {
+                throw std::invalid_argument(("Compile Error: Cannot map type '" + type.get_name() + "', whose String or Blob values live in an arena").c_str());
+            }
+        }
+        /* Read the header through the mapping, which must hold the descriptor and every row */
+        void open_mapping() {
+            size_t length = file_length();
+            if (length < sizeof(Binary_Header)) throw std::invalid_argument(("Value Error: File '" + path + "' is too short to be a binary file").c_str());
+            map(length);
+            Binary_Header current = *header();
+            check_binary_header(current);
+            if (current.payload_offset > length) throw std::invalid_argument(("Value Error: File '" + path + "' is truncated").c_str());
+            schema = Deserialize_Schema(mapping + sizeof(Binary_Header), current.descriptor_length);
+            check_binary_schema(current, *schema);
+            check_fixed_length(*schema);
+            stride = schema->size_of();
+            payload_offset = current.payload_offset;
+            capacity = stride == 0 ? current.rows : (length - payload_offset) / stride;
+            if (current.rows > capacity) throw std::invalid_argument(("Value Error: File '" + path + "' is truncated").c_str());
+            size = current.rows;
+        }
+    public:
+        /* Map an existing file */
+        Mapped_Record_File(const std::string& _path, Map_Mode _mode = Map_Mode::Read_Only):path(_path), mode(_mode), stride(0), size(0), capacity(0), payload_offset(0), mapping(nullptr), mapping_length(0) {
+            open_file(false);
+            try {
+                open_mapping();
+            } catch (...) {
+                close_file();
+                throw;
+            }
+        }
+        /* Create a writable file of rows of `type`, replacing any existing file */
+        Mapped_Record_File(const std::string& _path, const Type* type, size_t _capacity = 0):path(_path), mode(Map_Mode::Read_Write), schema(type->get_Schema()), stride(type->size_of()), size(0), capacity(0), payload_offset(0), mapping(nullptr), mapping_length(0) {
+            check_fixed_length(*schema);
+            open_file(true);
+            try {
+                std::string descriptor = Serialize(*schema);
+                Binary_Header initial = make_binary_header(descriptor, stride, 0);
+                payload_offset = initial.payload_offset;
+                resize_file(payload_offset);
+                map(payload_offset);
+                *header() = initial;
+                memcpy(mapping + sizeof(Binary_Header), descriptor.data(), descriptor.length());
+                reserve(_capacity);
+            } catch (...) {
+                close_file();
+                throw;
+            }
+        }
+        Mapped_Record_File(const Mapped_Record_File&) = delete;
+        Mapped_Record_File& operator=(const Mapped_Record_File&) = delete;
+        /* A writable file is flushed and truncated to its rows when closed */
+        ~Mapped_Record_File() {
+            if (mode == Map_Mode::Read_Write && mapping != nullptr) {
+                header()->rows = size;
+                unmap();
+                try {
+                    resize_file(payload_offset + stride * size);
+                } catch (...) {}
+            }
+            close_file();
+        }
+        const std::shared_ptr<const Schema>& get_Schema() const { return schema; }
+        /* Throw if the schema of file is not the same as `type` */
+        void check_Schema(const Type* type) const {
+            if (type->get_Schema() != schema) {
+                throw std::invalid_argument(("Value Error: Schema of file '" + path + "' does not match type '" + type->get_name() + "'").c_str());
+            }
+        }
+        Map_Mode get_Mode() const { return mode; }
+        /* Get Number of Rows */
+        size_t get_Size() const { return size; }
+        size_t get_Capacity() const { return capacity; }
+        /* Get Bytes of each Row */
+        size_t get_Stride() const { return stride; }
+        void* get_data() { return mapping + payload_offset; }
+        const void* get_data() const { return mapping + payload_offset; }
+
+        /* `reserve` grows the file and remaps it to hold at least `_capacity` rows */
+        void reserve(size_t _capacity) {
+            check_writable();
+            if (_capacity <= capacity) return;
+            if (stride != 0 && _capacity > (std::numeric_limits<size_t>::max() - payload_offset) / stride) {
+                throw std::overflow_error(("Memory Error: Too many rows of type '" + schema->get_name() + "'").c_str());
+            }
+            header()->rows = size;
+            unmap();
+            resize_file(payload_offset + stride * _capacity);
+            map(payload_offset + stride * _capacity);
+            capacity = _capacity;
+        }
+        /* `append` adds a row filled with zero, whose capacity grows geometrically */
+        Type_View append() {
+            check_writable();
+            if (size == capacity) reserve(capacity < 8 ? 8 : capacity * 2);
+            char* row = mapping + payload_offset + stride * size;
+            memset(row, 0, stride);
+            ++size;
+            return Type_View(schema.get(), row);
+        }
+        /* Notice that this function copies `stride` bytes from `src` without type checking */
+        Type_View append(const void* src) {
+            // A row of this file moves with the mapping when `append` remaps it
+            uintptr_t address = reinterpret_cast<uintptr_t>(src), base = reinterpret_cast<uintptr_t>(mapping + payload_offset);
+            bool inside = address >= base && address < base + stride * size;
+            Type_View row = append();
+            memcpy(row.get_data(), inside ? mapping + payload_offset + (address - base) : src, stride);
+            return row;
+        }
+        /* Write the number of rows into the header and the modified pages into the file */
+        void flush() {
+            check_writable();
+            header()->rows = size;
+#if defined(_WIN32)
+            if (!FlushViewOfFile(mapping, mapping_length) || !FlushFileBuffers(file)) {
+                throw std::runtime_error(("IO Error: Fail to flush file '" + path + "'").c_str());
+            }
+#else
+            if (msync(mapping, mapping_length, MS_SYNC) != 0) throw std::runtime_error(("IO Error: Fail to flush file '" + path + "'").c_str());
+#endif
+        }
+
+        Type_View operator[](size_t row) {
+            if (row >= size) throw std::out_of_range(("Index Error: Cannot index over the number of rows of type '" + schema->get_name() + "'").c_str());
+            return Type_View(schema.get(), mapping + payload_offset + stride * row);
+        }
+        Type_View at(size_t row) {
+            return (*this)[row];
+        }
+        /* Let `type` hold the data of `row` inside the mapping, so that the original API of `Type` could be used on it */
+        void hold(Type& type, size_t row) {
+            type.hold((*this)[row].get_data());
+        }
+    };
+
+    /**
+     * Position of one thread over rows of the same immutable `Schema`
+     * `Type::hold` rebinds properties which every user of the `Type` shares, so a `Type` could only view one row at a time.
+     * A cursor owns nothing but its position, so any number of threads could read or write disjoint rows through their own cursors
+     * without locks, and read the same rows as long as no thread writes them.
+     * 
+     * Notice that rows must outlive cursors and must not be reallocated, e.g. by `append`, while cursors are in use.
+     * Writing a long String or Blob appends to the arena shared by all cursors, so it needs a lock like any other shared write.
+     */
+    class Cursor {
+    private:
+        std::shared_ptr<const Schema> schema;
+        String_Arena* arena;
+        char* data;
+        size_t stride;
+        size_t begin;
+        size_t end;
+        size_t row;
+    public:
+        /* Cursor over `rows` rows starting at `_data`, whose stride is the size of `_schema` unless given, with String or Blob in `_arena` */
+        Cursor(const std::shared_ptr<const Schema>& _schema, void* _data, size_t rows, size_t _stride = 0, String_Arena* _arena = nullptr):schema(_schema), arena(_arena), data(static_cast<char*>(_data)), stride(_stride == 0 ? _schema->size_of() : _stride), begin(0), end(rows), row(0) {
+            if (data == nullptr && rows != 0) throw std::invalid_argument(("Nullpointer Error: Cannot move cursor over null pointer of type '" + schema->get_name() + "'").c_str());
+        }
+        Cursor(const Type* type, void* _data, size_t rows):Cursor(type->get_Schema(), _data, rows, 0, type->get_Arena()) {}
+        explicit Cursor(Record_Batch& batch):Cursor(batch.get_Schema(), batch.get_data(), batch.get_Size(), batch.get_Stride(), &batch.get_Arena()) {}
+        explicit Cursor(Mapped_Record_File& file):Cursor(file.get_Schema(), file.get_data(), file.get_Size(), file.get_Stride()) {}
+
+        const std::shared_ptr<const Schema>& get_Schema() const { return schema; }
+        /* Rows [begin, end) which this cursor could move over */
+        size_t get_Begin() const { return begin; }
+        size_t get_End() const { return end; }
+        size_t get_Row() const { return row; }
+        String_Arena* get_Arena() const { return arena; }
+        bool valid() const { return row < end; }
+        void next() { ++row; }
+        void seek(size_t _row) {
+            if (_row < begin || _row > end) throw std::out_of_range(("Index Error: Cannot move cursor out of its rows of type '" + schema->get_name() + "'").c_str());
+            row = _row;
+        }
+        /* Cursor restricted to rows [_begin, _end), which starts at `_begin` */
+        Cursor slice(size_t _begin, size_t _end) const {
+            if (_begin > _end || _begin < begin || _end > end) throw std::out_of_range(("Index Error: Cannot slice cursor out of its rows of type '" + schema->get_name() + "'").c_str());
+            Cursor sliced(*this);
+            sliced.begin = sliced.row = _begin;
+            sliced.end = _end;
+            return sliced;
+        }
+        /* The `part`-th of `parts` contiguous slices of nearly equal size, e.g. the share of one thread */
+        Cursor partition(size_t part, size_t parts) const {
+            if (part >= parts) throw std::out_of_range(("Index Error: Cannot partition cursor of type '" + schema->get_name() + "' with part over parts").c_str());
+            size_t rows = end - begin;
+            return slice(begin + rows / parts * part + std::min(part, rows % parts), begin + rows / parts * (part + 1) + std::min(part + 1, rows % parts));
+        }
+
+        /* Data of current row without checking, for `Field_Path` or `Native_Binding` */
+        void* get_data() const { return data + stride * row; }
+        Type_View view() const {
+            if (!valid()) throw std::out_of_range(("Index Error: Cannot view cursor past its rows of type '" + schema->get_name() + "'").c_str());
+            return Type_View(schema.get(), get_data(), arena);
+        }
+        Type_View operator[](const std::string& key) const {
+            return view()[key];
+        }
+    };
+
+    /* Primitive Type inside a row, flattened by its path like "point_a.x" or "tensor[3][0][1]" */
+    struct Primitive_Field {
+        std::string path;
+        size_t offset;
+        Primitive_Data_Types type;
+    };
+
+    /* Flatten every Primitive Type inside `type` in the order of `get_Keys` and positions */
+    inline void flatten_primitives(const Schema& type, std::string path, size_t offset, std::vector<Primitive_Field>& fields) {
+        switch (type.get_Type_Class()) {
+        case Type_Class::Primitive:
+            fields.push_back({ path, offset, type.get_Type() });
+            break;
+        case Type_Class::Array: {
+            const Schema& element_type = *type.get_Element();
+            for (size_t pos = 0; pos < type.get_Size(); ++pos) {
+                flatten_primitives(element_type, path + "[" + std::to_string(pos) + "]", offset + element_type.size_of() * pos, fields);
+            }
+            break;
+        }
+        case Type_Class::Struct:
+            for (size_t pos = 0; pos < type.get_Field_Count(); ++pos) {
+                const Schema& field = *type.get_Field(pos);
+                flatten_primitives(field, path.empty() ? field.get_name() : path + "." + field.get_name(), offset + type.get_Field_Offset(pos), fields);
+            }
+            break;
+        }
+    }
+    inline std::vector<Primitive_Field> flatten_primitives(const Schema& type) {
+        std::vector<Primitive_Field> fields;
+        flatten_primitives(type, type.get_Type_Class() == Type_Class::Primitive ? type.get_name() : "", 0, fields);
+        return fields;
+    }
+    inline std::vector<Primitive_Field> flatten_primitives(const Type* type) {
+        return flatten_primitives(*type->get_Schema());
+    }
+
+    /* Error of one value in text, where `line` counts from 0 and `column` is the index of Primitive Type in the row */
+    struct Parse_Error {
+        size_t line;
+        size_t column;
+        Status status;
+    };
+
+    /**
+     * Schema-driven loader of delimited text, where each line is a row and each value is a Primitive Type of the row
+     * The delimiter ' ' separates values by any run of spaces or tabs, like `operator>>`.
+     * Other delimiters separate values by exactly one delimiter, where values could be quoted by `"` as CSV.
+     * 
+     * Rows with any error are not appended, and their errors are collected instead of thrown.
+     */
+    class Text_Loader {
+    private:
+        std::shared_ptr<const Schema> schema;
+        std::vector<Primitive_Field> fields;
+        char delimiter;
+        bool header;
+        std::vector<Parse_Error> errors;
+        /* Unescaped quoted value */
+        std::string quoted;
+        /* Slow path of floats */
+        std::string scratch;
+
+        /* Spaces and tabs around values are ignored, unless they are the delimiter */
+        bool is_padding(char c) const { return (c == ' ' || c == '\t') && (delimiter == ' ' || c != delimiter); }
+        static const char* find_last_line_end(const char* buffer, size_t length) {
+            for (size_t index = length; index > 0; --index) {
+                if (buffer[index - 1] == '\n') return buffer + index - 1;
+            }
+            return nullptr;
+        }
+        /**
+         * Find the next value of line [pos, end) separated by the delimiter
+         * \param more set to whether a delimiter follows the value
+         */
+        Status next_delimited_value(const char*& pos, const char* end, const char*& value_begin, const char*& value_end, bool& more) {
+            while (pos != end && is_padding(*pos)) ++pos;
+            if (pos != end && *pos == '"') {
+                quoted.clear();
+                for (++pos; ; ++pos) {
+                    if (pos == end) return Status::Invalid_Value;
+                    if (*pos == '"') {
+                        if (pos + 1 == end || pos[1] != '"') break;
+                        ++pos;
+                    }
+                    quoted.push_back(*pos);
+                }
+                for (++pos; pos != end && is_padding(*pos); ++pos);
+                if (pos != end && *pos != delimiter) return Status::Invalid_Value;
+                more = pos != end;
+                if (more) ++pos;
+                value_begin = quoted.data();
+                value_end = quoted.data() + quoted.length();
+                return Status::Ok;
+            }
+            value_begin = pos;
+            while (pos != end && *pos != delimiter) ++pos;
+            value_end = pos;
+            while (value_end != value_begin && is_padding(value_end[-1])) --value_end;
+            more = pos != end;
+            if (more) ++pos;
+            return value_begin == value_end ? Status::Missing_Value : Status::Ok;
+        }
+        /* Parse one line into `row`, with long String or Blob in `arena`, returning false if any value is wrong */
+        bool parse_line(const char* pos, const char* end, char* row, String_Arena* arena, size_t line) {
+            bool ok = true, more = true;
+            for (size_t column = 0; column < fields.size(); ++column) {
+                const char* value_begin = nullptr;
+                const char* value_end = nullptr;
+                Status status;
+                if (delimiter == ' ') {
+                    while (pos != end && is_padding(*pos)) ++pos;
+                    value_begin = pos;
+                    while (pos != end && !is_padding(*pos)) ++pos;
+                    value_end = pos;
+                    status = value_begin == value_end ? Status::Missing_Value : Status::Ok;
+                } else if (!more) {
+                    status = Status::Missing_Value;
+                } else {
+                    status = next_delimited_value(pos, end, value_begin, value_end, more);
+                }
+                if (status == Status::Ok) status = parse_value(fields[column].type, value_begin, value_end, row + fields[column].offset, scratch, arena);
+                if (status != Status::Ok) {
+                    errors.push_back({ line, column, status });
+                    ok = false;
+                    // Values after a missing or malformed one cannot be located
+                    if (status == Status::Missing_Value ? (delimiter == ' ' || !more) : value_begin == nullptr) return false;
+                }
+            }
+            if (delimiter == ' ') {
+                while (pos != end && is_padding(*pos)) ++pos;
+                more = pos != end;
+            }
+            if (more && !fields.empty()) {
+                errors.push_back({ line, fields.size(), Status::Extra_Value });
+                return false;
+            }
+            return ok;
+        }
+        bool is_blank_line(const char* pos, const char* end) const {
+            while (pos != end && (*pos == ' ' || *pos == '\t')) ++pos;
+            return pos == end;
+        }
+        /* Parse lines in [begin, end), where `line` is the number of lines before `begin` */
+        size_t load_lines(const char* begin, const char* end, Record_Batch& batch, size_t& line) {
+            size_t appended = 0;
+            while (begin != end) {
+                const char* line_end = static_cast<const char*>(memchr(begin, '\n', end - begin));
+                const char* next = line_end == nullptr ? end : line_end + 1;
+                if (line_end == nullptr) line_end = end;
+                if (line_end != begin && line_end[-1] == '\r') --line_end;
+                if (!(header && line == 0) && !is_blank_line(begin, line_end)) {
+                    DYNAMIC_STRUCT_COUNT(schema->get_name(), Parses, fields.size());
+                    char* row = static_cast<char*>(batch.append().get_data());
+                    if (parse_line(begin, line_end, row, &batch.get_Arena(), line)) ++appended;
+                    else batch.resize(batch.get_Size() - 1);
+                }
+                ++line;
+                begin = next;
+            }
+            return appended;
+        }
+        void check_batch(const Record_Batch& batch) const {
+            if (batch.get_Schema() != schema) {
+                throw std::invalid_argument(("Value Error: Cannot load text of type '" + schema->get_name() + "' into rows of type '" + batch.get_Schema()->get_name() + "'").c_str());
+            }
+        }
+    public:
+        /**
+         * \param type type of each row
+         * \param _delimiter ' ' for whitespace, or any other character like ',' or '\t'
+         * \param _header whether the first line is skipped
+         */
+        Text_Loader(const Type* type, char _delimiter = ',', bool _header = false):schema(type->get_Schema()), fields(flatten_primitives(type)), delimiter(_delimiter), header(_header) {
+            if (delimiter == '"' || delimiter == '\n' || delimiter == '\r') {
+                throw std::invalid_argument(("Value Error: Cannot use delimiter '" + std::string(1, delimiter) + "' for type '" + schema->get_name() + "'").c_str());
+            }
+        }
+        const std::shared_ptr<const Schema>& get_Schema() const { return schema; }
+        /* Get Number of Values in each Row */
+        size_t get_Column_Count() const { return fields.size(); }
+        std::string get_Column_Name(size_t column) const {
+            if (column >= fields.size()) throw std::out_of_range(("Index Error: Cannot index over the number of columns of type '" + schema->get_name() + "'").c_str());
+            return fields[column].path;
+        }
+        /* Errors of the last `load` */
+        const std::vector<Parse_Error>& get_Errors() const { return errors; }
+        std::string get_Error_Message(const Parse_Error& error) const {
+            std::string column = error.column < fields.size() ? "'" + fields[error.column].path + "'" : "after the last column";
+            return get_string_from_status(error.status) + " at line " + std::to_string(error.line) + ", column " + column + " of type '" + schema->get_name() + "'";
+        }
+
+        /* Append rows parsed from text [buffer, buffer + length) to `batch`, returning the number of appended rows */
+        size_t load(const char* buffer, size_t length, Record_Batch& batch) {
+            check_batch(batch);
+            errors.clear();
+            size_t line = 0;
+            return load_lines(buffer, buffer + length, batch, line);
+        }
+        size_t load(const std::string& text, Record_Batch& batch) {
+            return load(text.data(), text.length(), batch);
+        }
+        /* Append rows parsed from `stream` to `batch`, reading `chunk_size` bytes at a time */
+        size_t load(std::istream& stream, Record_Batch& batch, size_t chunk_size = 1 << 20) {
+            check_batch(batch);
+            errors.clear();
+            size_t line = 0, appended = 0, pending = 0;
+            std::vector<char> buffer(chunk_size == 0 ? 1 : chunk_size);
+            while (stream) {
+                // The incomplete last line of previous chunk is kept at the beginning
+                if (pending == buffer.size()) buffer.resize(buffer.size() * 2);
+                stream.read(buffer.data() + pending, buffer.size() - pending);
+                size_t length = pending + static_cast<size_t>(stream.gcount());
+                const char* last_line_end = find_last_line_end(buffer.data(), length);
+                size_t complete = !stream ? length : (last_line_end == nullptr ? 0 : last_line_end - buffer.data() + 1);
+                appended += load_lines(buffer.data(), buffer.data() + complete, batch, line);
+                pending = length - complete;
+                memmove(buffer.data(), buffer.data() + complete, pending);
+            }
+            return appended;
+        }
+    };
+
+    /* Longest text of a value of `type` written by `Text_Writer`, e.g. "-9223372036854775808" or a quoted Char */
+    inline size_t max_text_length(Primitive_Data_Types type) {
+        switch (type) {
+        case Primitive_Data_Types::Int_8: return 4;
+        case Primitive_Data_Types::Int_16: return 6;
+        case Primitive_Data_Types::Int_32: return 11;
+        case Primitive_Data_Types::Int_64: return 20;
+        case Primitive_Data_Types::Unsigned_Int_8: return 3;
+        case Primitive_Data_Types::Unsigned_Int_16: return 5;
+        case Primitive_Data_Types::Unsigned_Int_32: return 10;
+        case Primitive_Data_Types::Unsigned_Int_64: return 20;
+        case Primitive_Data_Types::Char: return 4;
+        case Primitive_Data_Types::Boolean: return 5;
+        // Sign, 39 or 309 digits, and ".000000"
+        case Primitive_Data_Types::Float_32: return 47;
+        case Primitive_Data_Types::Float_64: return 317;
+        // Besides the value itself, whose length is known only when written
+        case Primitive_Data_Types::String: return 2;
+        case Primitive_Data_Types::Blob: return 0;
+        }
+        return 0;
+    }
+
+    /* Write `value` in decimal at `dst`, returning the end of text */
+    inline char* format_unsigned(char* dst, uint64_t value) {
+        static const char digit_pairs[] =
+            "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+            "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+            "8081828384858687888990919293949596979899";
+        char reversed[20];
+        char* pos = reversed + 20;
+        while (value >= 100) {
+            size_t pair = static_cast<size_t>(value % 100) * 2;
+            value /= 100;
+            *--pos = digit_pairs[pair + 1];
+            *--pos = digit_pairs[pair];
+        }
+        if (value >= 10) {
+            *--pos = digit_pairs[value * 2 + 1];
+            *--pos = digit_pairs[value * 2];
+        } else {
+            *--pos = static_cast<char>('0' + value);
+        }
+        size_t length = reversed + 20 - pos;
+        memcpy(dst, pos, length);
+        return dst + length;
+    }
+    inline char* format_signed(char* dst, int64_t value) {
+        if (value < 0) {
+            *dst++ = '-';
+            // Avoid overflow when negating the minimum
+            return format_unsigned(dst, static_cast<uint64_t>(-(value + 1)) + 1);
+        }
+        return format_unsigned(dst, static_cast<uint64_t>(value));
+    }
+    /**
+     * Write `value` at `dst` with 6 decimals, the same as `std::to_string`, returning the end of text
+     * `value * 10^6` is rounded to an integer directly, unless it is too large or too close to a tie for its rounding error.
+     */
+    inline char* format_float(char* dst, double value) {
+        double magnitude = std::fabs(value);
+        if (magnitude < 1e9) {
+            double scaled = magnitude * 1e6;
+            double integer = std::floor(scaled);
+            double fraction = scaled - integer;
+            // Rounding error of `scaled` is at most half of its ulp
+            if (std::fabs(fraction - 0.5) > scaled * std::numeric_limits<double>::epsilon()) {
+                uint64_t rounded = static_cast<uint64_t>(integer) + (fraction > 0.5 ? 1 : 0);
+                if (std::signbit(value)) *dst++ = '-';
+                dst = format_unsigned(dst, rounded / 1000000);
+                *dst++ = '.';
+                char decimals[20];
+                char* end = format_unsigned(decimals, rounded % 1000000);
+                size_t length = end - decimals;
+                memset(dst, '0', 6 - length);
+                memcpy(dst + 6 - length, decimals, length);
+                return dst + 6;
+            }
+        }
+        int length = snprintf(dst, 320, "%f", value);
+        return dst + length;
+    }
+
+    /**
+     * Streaming formatter of rows as delimited text, which walks the schema once at construction
+     * Values are written the same as `string()` into a buffer, which is either
+     *      growable, and read by `get_Text`,
+     *      flushed into a stream in chunks,
+     *      or provided by the caller, which throws when it is full.
+     * Unless the delimiter is ' ', Char, String and names are quoted by `"` as CSV when needed.
+     */
+    class Text_Writer {
+    private:
+        std::shared_ptr<const Schema> schema;
+        std::vector<Primitive_Field> fields;
+        /* Columns of String or Blob, whose text is longer than `max_text_length` */
+        std::vector<size_t> variable_columns;
+        char delimiter;
+        /* Longest text of a row, including delimiters and the newline */
+        size_t max_row_length;
+        std::vector<char> storage;
+        char* buffer;
+        size_t capacity;
+        size_t length;
+        std::ostream* stream;
+
+        bool needs_quote(char c) const {
+            return delimiter != ' ' && (c == delimiter || c == '"' || c == '\n' || c == '\r');
+        }
+        /* Make room for `count` more bytes */
+        void ensure(size_t count) {
+            if (length + count <= capacity) return;
+            if (stream != nullptr) {
+                flush();
+                if (count <= capacity) return;
+            }
+            if (buffer != nullptr && buffer != storage.data()) {
+                throw std::overflow_error(("Memory Error: Buffer is too small for text of type '" + schema->get_name() + "'").c_str());
+            }
+            storage.resize(std::max(length + count, storage.size() * 2));
+            buffer = storage.data();
+            capacity = storage.size();
+        }
+        void write_header() {
+            std::string line;
+            for (size_t column = 0; column < fields.size(); ++column) {
+                if (column > 0) line += delimiter;
+                const std::string& path = fields[column].path;
+                if (std::find_if(path.begin(), path.end(), [this](char c) { return needs_quote(c); }) == path.end()) {
+                    line += path;
+                    continue;
+                }
+                line += '"';
+                for (char c : path) line += c == '"' ? std::string("\"\"") : std::string(1, c);
+                line += '"';
+            }
+            line += '\n';
+            ensure(line.length());
+            memcpy(buffer + length, line.data(), line.length());
+            length += line.length();
+        }
+        /* Whether a String is quoted, so that it is loaded back with its padding, or at all when it is empty */
+        bool needs_quote(const String_Ref& value) const {
+            if (delimiter == ' ') return false;
+            if (value.length == 0 || value.data[0] == ' ' || value.data[0] == '\t' || value.data[value.length - 1] == ' ' || value.data[value.length - 1] == '\t') return true;
+            for (size_t index = 0; index < value.length; ++index) {
+                if (needs_quote(value.data[index])) return true;
+            }
+            return false;
+        }
+        char* write_value(char* dst, Primitive_Data_Types type, const char* src, const String_Arena* arena) {
+            switch (type) {
+            case Primitive_Data_Types::Int_8: { int8_t value; memcpy(&value, src, sizeof(value)); return format_signed(dst, value); }
+            case Primitive_Data_Types::Int_16: { int16_t value; memcpy(&value, src, sizeof(value)); return format_signed(dst, value); }
+            case Primitive_Data_Types::Int_32: { int32_t value; memcpy(&value, src, sizeof(value)); return format_signed(dst, value); }
+            case Primitive_Data_Types::Int_64: { int64_t value; memcpy(&value, src, sizeof(value)); return format_signed(dst, value); }
+
+            case Primitive_Data_Types::Unsigned_Int_8: { uint8_t value; memcpy(&value, src, sizeof(value)); return format_unsigned(dst, value); }
+            case Primitive_Data_Types::Unsigned_Int_16: { uint16_t value; memcpy(&value, src, sizeof(value)); return format_unsigned(dst, value); }
+            case Primitive_Data_Types::Unsigned_Int_32: { uint32_t value; memcpy(&value, src, sizeof(value)); return format_unsigned(dst, value); }
+            case Primitive_Data_Types::Unsigned_Int_64: { uint64_t value; memcpy(&value, src, sizeof(value)); return format_unsigned(dst, value); }
+
+            case Primitive_Data_Types::Char:
+                if (!needs_quote(*src)) {
+                    *dst++ = *src;
+                    return dst;
+                }
+                *dst++ = '"';
+                if (*src == '"') *dst++ = '"';
+                *dst++ = *src;
+                *dst++ = '"';
+                return dst;
+
+            case Primitive_Data_Types::Boolean: {
+                bool value;
+                memcpy(&value, src, sizeof(value));
+                memcpy(dst, value ? "true" : "false", value ? 4 : 5);
+                return dst + (value ? 4 : 5);
+            }
+
+            case Primitive_Data_Types::Float_32: { float value; memcpy(&value, src, sizeof(value)); return format_float(dst, value); }
+            case Primitive_Data_Types::Float_64: { double value; memcpy(&value, src, sizeof(value)); return format_float(dst, value); }
+
+            case Primitive_Data_Types::String: {
+                String_Ref value = { "", 0 };
+                load_string(src, arena, value);
+                if (!needs_quote(value)) {
+                    if (value.length != 0) memcpy(dst, value.data, value.length);
+                    return dst + value.length;
+                }
+                *dst++ = '"';
+                for (size_t index = 0; index < value.length; ++index) {
+                    if (value.data[index] == '"') *dst++ = '"';
+                    *dst++ = value.data[index];
+                }
+                *dst++ = '"';
+                return dst;
+            }
+            case Primitive_Data_Types::Blob: {
+                String_Ref value = { "", 0 };
+                load_string(src, arena, value);
+                return format_hex(dst, value.data, value.length);
+            }
+            }
+            return dst;
+        }
+        void check_schema(const std::shared_ptr<const Schema>& type) const {
+            if (type != schema) {
+                throw std::invalid_argument(("Value Error: Cannot write type '" + type->get_name() + "' as text of type '" + schema->get_name() + "'").c_str());
+            }
+        }
+        void init(bool header) {
+            max_row_length = fields.size() + 1;
+            for (size_t column = 0; column < fields.size(); ++column) {
+                max_row_length += max_text_length(fields[column].type);
+                if (is_variable_length(fields[column].type)) variable_columns.push_back(column);
+            }
+            if (header) write_header();
+        }
+    public:
+        /**
+         * Write into a growable buffer
+         * \param _delimiter ' ', ',' or any other character except '"' and newlines
+         * \param header whether the paths of Primitive Types are written as the first line
+         */
+        Text_Writer(const Type* type, char _delimiter = ',', bool header = false):schema(type->get_Schema()), fields(flatten_primitives(type)), delimiter(_delimiter), buffer(nullptr), capacity(0), length(0), stream(nullptr) {
+            init(header);
+        }
+        /* Write into `_stream`, flushing every `chunk_size` bytes */
+        Text_Writer(const Type* type, std::ostream& _stream, char _delimiter = ',', bool header = false, size_t chunk_size = 1 << 20):schema(type->get_Schema()), fields(flatten_primitives(type)), delimiter(_delimiter), storage(chunk_size == 0 ? 1 : chunk_size), buffer(storage.data()), capacity(storage.size()), length(0), stream(&_stream) {
+            init(header);
+        }
+        /* Write into `_buffer` of `_capacity` bytes provided by the caller */
+        Text_Writer(const Type* type, char* _buffer, size_t _capacity, char _delimiter = ',', bool header = false):schema(type->get_Schema()), fields(flatten_primitives(type)), delimiter(_delimiter), buffer(_buffer), capacity(_capacity), length(0), stream(nullptr) {
+            if (buffer == nullptr) throw std::invalid_argument(("Nullpointer Error: Cannot write text of type '" + schema->get_name() + "' into null buffer").c_str());
+            init(header);
+        }
+        Text_Writer(const Text_Writer&) = delete;
+        Text_Writer& operator=(const Text_Writer&) = delete;
+        ~Text_Writer() {
+            try {
+                flush();
+            } catch (...) {}
+        }
+        const std::shared_ptr<const Schema>& get_Schema() const { return schema; }
+        /* Text which has not been flushed */
+        const char* get_data() const { return buffer; }
+        size_t get_Length() const { return length; }
+        std::string get_Text() const { return std::string(buffer == nullptr ? "" : buffer, length); }
+        void clear() { length = 0; }
+        /* Write buffered text into the stream if any */
+        void flush() {
+            if (stream == nullptr || length == 0) return;
+            stream->write(buffer, length);
+            length = 0;
+            if (!*stream) throw std::runtime_error(("IO Error: Fail to write text of type '" + schema->get_name() + "'").c_str());
+        }
+
+        /* Notice that this function writes the row at `src`, whose long String or Blob are in `arena`, without type checking */
+        void write(const void* src, const String_Arena* arena = nullptr) {
+            const char* row = static_cast<const char*>(src);
+            size_t row_length = max_row_length;
+            for (size_t column : variable_columns) {
+                String_Ref value;
+                Status status = load_string(row + fields[column].offset, arena, value);
+                if (status != Status::Ok) {
+                    throw std::invalid_argument(("Value Error: Cannot write column '" + fields[column].path + "' of type '" + schema->get_name() + "', " + get_string_from_status(status)).c_str());
+                }
+                // Each '"' of a String is doubled, and each byte of a Blob is 2 hex digits
+                row_length += value.length * 2;
+            }
+            ensure(row_length);
+            char* dst = buffer + length;
+            for (size_t column = 0; column < fields.size(); ++column) {
+                if (column > 0) *dst++ = delimiter;
+                dst = write_value(dst, fields[column].type, row + fields[column].offset, arena);
+            }
+            *dst++ = '\n';
+            length = dst - buffer;
+        }
+        /* Write the data of `type` as a row */
+        void write(Type* type) {
+            check_schema(type->get_Schema());
+            if (type->get_data() == nullptr) {
+                throw std::invalid_argument(("Nullpointer Error: Type '" + type->get_name() + "' has not been initialized").c_str());
+            }
+            write(static_cast<const void*>(type->get_data()), type->get_Arena());
+        }
+        /* Write each row of `batch` */
+        void write(const Record_Batch& batch) {
+            check_schema(batch.get_Schema());
+            const char* rows = static_cast<const char*>(batch.get_data());
+            for (size_t row = 0; row < batch.get_Size(); ++row) write(static_cast<const void*>(rows + batch.get_Stride() * row), &batch.get_Arena());
+        }
+        /* Write each element of Array `array` as a row */
+        void write_elements(Type* array) {
+            if (array->get_Type_Class() != Type_Class::Array) {
+                throw std::invalid_argument(("Compile Error: Type '" + array->get_name() + "' is not an Array").c_str());
+            }
+            check_schema(array->get_Schema()->get_Element());
+            if (array->get_data() == nullptr) {
+                throw std::invalid_argument(("Nullpointer Error: Type '" + array->get_name() + "' has not been initialized").c_str());
+            }
+            const char* elements = static_cast<const char*>(array->get_data());
+            for (size_t pos = 0; pos < array->get_Size(); ++pos) write(static_cast<const void*>(elements + schema->size_of() * pos), array->get_Arena());
+        }
+    };
+
+    /* Primitive Data Type of a native C++ type, which is only defined for the fixed-width types of `Primitive_Data_Types` */
+    template <typename M> struct _Native_Primitive {
+        static_assert(sizeof(M) == 0, "Native member must be a Primitive Data Type or an array of them");
+    };
+    template <> struct _Native_Primitive<int8_t> { static const Primitive_Data_Types type = Primitive_Data_Types::Int_8; };
+    template <> struct _Native_Primitive<int16_t> { static const Primitive_Data_Types type = Primitive_Data_Types::Int_16; };
+    template <> struct _Native_Primitive<int32_t> { static const Primitive_Data_Types type = Primitive_Data_Types::Int_32; };
+    template <> struct _Native_Primitive<int64_t> { static const Primitive_Data_Types type = Primitive_Data_Types::Int_64; };
+    template <> struct _Native_Primitive<uint8_t> { static const Primitive_Data_Types type = Primitive_Data_Types::Unsigned_Int_8; };
+    template <> struct _Native_Primitive<uint16_t> { static const Primitive_Data_Types type = Primitive_Data_Types::Unsigned_Int_16; };
+    template <> struct _Native_Primitive<uint32_t> { static const Primitive_Data_Types type = Primitive_Data_Types::Unsigned_Int_32; };
+    template <> struct _Native_Primitive<uint64_t> { static const Primitive_Data_Types type = Primitive_Data_Types::Unsigned_Int_64; };
+    template <> struct _Native_Primitive<char> { static const Primitive_Data_Types type = Primitive_Data_Types::Char; };
+    template <> struct _Native_Primitive<bool> { static const Primitive_Data_Types type = Primitive_Data_Types::Boolean; };
+    template <> struct _Native_Primitive<float> { static const Primitive_Data_Types type = Primitive_Data_Types::Float_32; };
+    template <> struct _Native_Primitive<double> { static const Primitive_Data_Types type = Primitive_Data_Types::Float_64; };
+
+    /* Flatten a native member in the same way as `flatten_primitives`, where arrays of any dimension are expanded */
+    template <typename M> struct _Native_Member {
+        static void flatten(const std::string& path, size_t offset, std::vector<Primitive_Field>& fields) {
+            fields.push_back({ path, offset, _Native_Primitive<M>::type });
+        }
+    };
+    template <typename M, size_t N> struct _Native_Member<M[N]> {
+        static void flatten(const std::string& path, size_t offset, std::vector<Primitive_Field>& fields) {
+            for (size_t pos = 0; pos < N; ++pos) _Native_Member<M>::flatten(path + "[" + std::to_string(pos) + "]", offset + sizeof(M) * pos, fields);
+        }
+    };
+
+    /* Descriptor of a member of a native struct, created by `NATIVE_FIELD` */
+    struct Native_Field {
+        const char* path;
+        size_t offset;
+        void (*flatten)(const std::string& path, size_t offset, std::vector<Primitive_Field>& fields);
+    };
+    /**
+     * Describe `member` of `native_type`, whose path is the same as the key of the Struct, e.g. `price` or `center.x` for nested structs
+     */
+    #define NATIVE_FIELD(native_type, member) dynamic_struct::Native_Field{ #member, offsetof(native_type, member), &dynamic_struct::_Native_Member<decltype(std::declval<native_type&>().member)>::flatten }
+
+    /**
+     * Binding of a native C++ struct `T` to a Struct, whose layout is verified once at construction
+     * Every Primitive Type of the Struct must be described by exactly one member, with the same path, data type and offset,
+     * and `T` must have the same size, so that data of any instance or row of the Struct could be accessed as `T&`.
+     * Native loops then run at the speed of plain structs, while the Struct remains the source of truth.
+     * 
+     * For example:
+     *      struct Point { int32_t x; int32_t y; };
+     *      Native_Binding<Point> binding(&point, { NATIVE_FIELD(Point, x), NATIVE_FIELD(Point, y) });
+     *      Point* points = binding.rows(batch);
+     */
+    template <typename T>
+    class Native_Binding {
+        static_assert(std::is_standard_layout<T>::value, "Native type must be standard layout");
+        static_assert(std::is_trivially_copyable<T>::value, "Native type must be trivially copyable");
+    private:
+        std::shared_ptr<const Schema> schema;
+
+        static bool by_path(const Primitive_Field& u, const Primitive_Field& v) { return u.path < v.path; }
+        [[noreturn]] void mismatch(const std::string& reason) const {
+            throw std::invalid_argument(("Value Error: Native type does not match type '" + schema->get_name() + "', " + reason).c_str());
+        }
+        void check_schema(const Schema& type) const {
+            if (&type != schema.get()) {
+                throw std::invalid_argument(("Value Error: Cannot access type '" + type.get_name() + "' as native type bound to type '" + schema->get_name() + "'").c_str());
+            }
+        }
+        /* Rows start at the beginning of buffer and repeat every `sizeof(T)` bytes, so only the beginning is checked */
+        T* check_data(void* data) const {
+            if (data == nullptr) throw std::invalid_argument(("Nullpointer Error: Cannot access null pointer of type '" + schema->get_name() + "' as native type").c_str());
+            if (reinterpret_cast<uintptr_t>(data) % alignof(T) != 0) {
+                throw std::invalid_argument(("Value Error: Data of type '" + schema->get_name() + "' is not aligned for native type").c_str());
+            }
+            return static_cast<T*>(data);
+        }
+    public:
+        Native_Binding(const std::shared_ptr<const Schema>& _schema, std::initializer_list<Native_Field> native_fields):schema(_schema) {
+            schema->get_Field_Count();
+            if (schema->size_of() != sizeof(T)) {
+                mismatch("whose size is " + std::to_string(schema->size_of()) + " bytes instead of " + std::to_string(sizeof(T)));
+            }
+            std::vector<Primitive_Field> expected = flatten_primitives(*schema);
+            std::vector<Primitive_Field> actual;
+            for (const Native_Field& field : native_fields) field.flatten(field.path, field.offset, actual);
+            std::sort(expected.begin(), expected.end(), by_path);
+            std::sort(actual.begin(), actual.end(), by_path);
+            for (size_t index = 0; index < actual.size(); ++index) {
+                if (index > 0 && actual[index].path == actual[index - 1].path) mismatch("whose member '" + actual[index].path + "' is described twice");
+            }
+            auto native = actual.begin();
+            for (const Primitive_Field& field : expected) {
+                if (native != actual.end() && native->path < field.path) mismatch("which has no property '" + native->path + "'");
+                if (native == actual.end() || native->path != field.path) mismatch("whose property '" + field.path + "' is not described");
+                if (native->type != field.type) {
+                    mismatch("whose property '" + field.path + "' is " + get_string_from_type(field.type) + " instead of " + get_string_from_type(native->type));
+                }
+                if (native->offset != field.offset) {
+                    mismatch("whose property '" + field.path + "' is at offset " + std::to_string(field.offset) + " instead of " + std::to_string(native->offset));
+                }
+                ++native;
+            }
+            if (native != actual.end()) mismatch("which has no property '" + native->path + "'");
+        }
+        Native_Binding(const Type* type, std::initializer_list<Native_Field> native_fields):Native_Binding(type->get_Schema(), native_fields) {}
+        const std::shared_ptr<const Schema>& get_Schema() const { return schema; }
+
+        /* Notice that this function does not check `data` */
+        T& get(void* data) const { return *static_cast<T*>(data); }
+        const T& get(const void* data) const { return *static_cast<const T*>(data); }
+        /* Access data of an instance of the bound Struct */
+        T& get(Type& type) const {
+            check_schema(*type.get_Schema());
+            return *check_data(type.get_data());
+        }
+        T& get(const Type_View& view) const {
+            check_schema(view.get_Schema());
+            return *check_data(view.get_data());
+        }
+        /* Get the first of contiguous rows, which could be iterated as a native array */
+        T* rows(Record_Batch& batch) const {
+            check_schema(*batch.get_Schema());
+            return batch.get_Size() == 0 ? static_cast<T*>(batch.get_data()) : check_data(batch.get_data());
+        }
+        T* rows(Mapped_Record_File& file) const {
+            check_schema(*file.get_Schema());
+            return file.get_Size() == 0 ? static_cast<T*>(file.get_data()) : check_data(file.get_data());
+        }
+        /* Get the first element of an Array of the bound Struct */
+        T* elements(Type& array) const {
+            if (array.get_Type_Class() != Type_Class::Array) {
+                throw std::invalid_argument(("Compile Error: Type '" + array.get_name() + "' is not an Array").c_str());
+            }
+            check_schema(*array.get_Schema()->get_Element());
+            return check_data(array.get_data());
+        }
+        T& operator()(Record_Batch& batch, size_t row) const {
+            if (row >= batch.get_Size()) throw std::out_of_range(("Index Error: Cannot index over the number of rows of type '" + schema->get_name() + "'").c_str());
+            return rows(batch)[row];
+        }
+    };
+
+    /* Comparison of a field with a constant in `Predicate` */
+    enum class Comparison {
+        Equal,
+        Not_Equal,
+        Less,
+        Less_Equal,
+        Greater,
+        Greater_Equal
+    };
+
+    /* Number of rows evaluated at a time by `Predicate`, which is a multiple of 64 for bitmaps */
+    const size_t FILTER_BLOCK_ROWS = 1024;
+    /* Fewest rows worth a thread of its own when `Predicate` scans in parallel */
+    const size_t FILTER_PARALLEL_ROWS = 1 << 16;
+
+    template <typename T, Comparison comparison>
+    inline uint8_t _compare(T value, T constant) {
+        switch (comparison) {
+        case Comparison::Equal: return value == constant;
+        case Comparison::Not_Equal: return value != constant;
+        case Comparison::Less: return value < constant;
+        case Comparison::Less_Equal: return value <= constant;
+        case Comparison::Greater: return value > constant;
+        case Comparison::Greater_Equal: return value >= constant;
+        }
+        return 0;
+    }
+    /* Write whether each of `count` values at `data` with `stride` satisfies the comparison into `mask` as 0 or 1 */
+    template <typename T, Comparison comparison>
+    inline void _compare_strided(const char* data, size_t stride, size_t count, const void* constant, uint8_t* mask) {
+        T _constant;
+        memcpy(&_constant, constant, sizeof(T));
+        // Full blocks of contiguous columns are vectorized, where a local mask rules out aliasing with `data`
+        if (stride == sizeof(T) && count == FILTER_BLOCK_ROWS) {
+            uint8_t local[FILTER_BLOCK_ROWS];
+            for (size_t index = 0; index < FILTER_BLOCK_ROWS; ++index) {
+                T value;
+                memcpy(&value, data + sizeof(T) * index, sizeof(T));
+                local[index] = _compare<T, comparison>(value, _constant);
+            }
+            memcpy(mask, local, FILTER_BLOCK_ROWS);
+        } else if (stride == sizeof(T)) {
+            for (size_t index = 0; index < count; ++index) {
+                T value;
+                memcpy(&value, data + sizeof(T) * index, sizeof(T));
+                mask[index] = _compare<T, comparison>(value, _constant);
+            }
+        } else {
+            for (size_t index = 0; index < count; ++index) {
+                T value;
+                memcpy(&value, data + stride * index, sizeof(T));
+                mask[index] = _compare<T, comparison>(value, _constant);
+            }
+        }
+    }
+    inline size_t _size_of_primitive(Primitive_Data_Types type) {
+        switch (type) {
+        case Primitive_Data_Types::Int_8: return sizeof(int8_t);
+        case Primitive_Data_Types::Int_16: return sizeof(int16_t);
+        case Primitive_Data_Types::Int_32: return sizeof(int32_t);
+        case Primitive_Data_Types::Int_64: return sizeof(int64_t);
+
+        case Primitive_Data_Types::Unsigned_Int_8: return sizeof(uint8_t);
+        case Primitive_Data_Types::Unsigned_Int_16: return sizeof(uint16_t);
+        case Primitive_Data_Types::Unsigned_Int_32: return sizeof(uint32_t);
+        case Primitive_Data_Types::Unsigned_Int_64: return sizeof(uint64_t);
+
+        case Primitive_Data_Types::Char: return sizeof(char);
+
+        case Primitive_Data_Types::Boolean: return sizeof(bool);
+
+        case Primitive_Data_Types::Float_32: return sizeof(float);
+        case Primitive_Data_Types::Float_64: return sizeof(double);
+
+        case Primitive_Data_Types::String:
+        case Primitive_Data_Types::Blob: return STRING_SLOT_BYTES;
+        }
+        return 0;
+    }
+    typedef void (*_Compare_Kernel)(const char* data, size_t stride, size_t count, const void* constant, uint8_t* mask);
+    template <typename T>
+    inline _Compare_Kernel _compare_kernel(Comparison comparison) {
+        switch (comparison) {
+        case Comparison::Equal: return _compare_strided<T, Comparison::Equal>;
+        case Comparison::Not_Equal: return _compare_strided<T, Comparison::Not_Equal>;
+        case Comparison::Less: return _compare_strided<T, Comparison::Less>;
+        case Comparison::Less_Equal: return _compare_strided<T, Comparison::Less_Equal>;
+        case Comparison::Greater: return _compare_strided<T, Comparison::Greater>;
+        case Comparison::Greater_Equal: return _compare_strided<T, Comparison::Greater_Equal>;
+        }
+        return nullptr;
+    }
+    inline _Compare_Kernel _compare_kernel(Primitive_Data_Types type, Comparison comparison) {
+        switch (type) {
+        case Primitive_Data_Types::Int_8: return _compare_kernel<int8_t>(comparison);
+        case Primitive_Data_Types::Int_16: return _compare_kernel<int16_t>(comparison);
+        case Primitive_Data_Types::Int_32: return _compare_kernel<int32_t>(comparison);
+        case Primitive_Data_Types::Int_64: return _compare_kernel<int64_t>(comparison);
+
+        case Primitive_Data_Types::Unsigned_Int_8: return _compare_kernel<uint8_t>(comparison);
+        case Primitive_Data_Types::Unsigned_Int_16: return _compare_kernel<uint16_t>(comparison);
+        case Primitive_Data_Types::Unsigned_Int_32: return _compare_kernel<uint32_t>(comparison);
+        case Primitive_Data_Types::Unsigned_Int_64: return _compare_kernel<uint64_t>(comparison);
+
+        case Primitive_Data_Types::Char: return _compare_kernel<char>(comparison);
+
+        case Primitive_Data_Types::Boolean: return _compare_kernel<bool>(comparison);
+
+        case Primitive_Data_Types::Float_32: return _compare_kernel<float>(comparison);
+        case Primitive_Data_Types::Float_64: return _compare_kernel<double>(comparison);
+
+        // Rejected by the parser of predicates
+        case Primitive_Data_Types::String:
+        case Primitive_Data_Types::Blob: break;
+        }
+        return nullptr;
+    }
+
+    /* Pack `count` bytes of 0 or 1, at most 64, into bits from the lowest one */
+    inline uint64_t _pack_mask(const uint8_t* mask, size_t count) {
+        uint64_t word = 0;
+        size_t bit = 0;
+#if !defined(__BYTE_ORDER__) || __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+        // Multiplying gathers the lowest bit of each of 8 bytes into the highest byte
+        for (; bit + 8 <= count; bit += 8) {
+            uint64_t bytes;
+            memcpy(&bytes, mask + bit, sizeof(bytes));
+            word |= ((bytes * 0x0102040810204080ULL) >> 56) << bit;
+        }
+#endif
+        for (; bit < count; ++bit) word |= static_cast<uint64_t>(mask[bit]) << bit;
+        return word;
+    }
+
+    /* Comparison of one Primitive Type inside the row with a constant, whose kernel is selected when bound */
+    struct _Predicate_Term {
+        Field_Path field;
+        Comparison comparison;
+        /* Constant in the representation of the field */
+        uint64_t constant;
+        _Compare_Kernel kernel;
+    };
+    struct _Predicate_Instruction {
+        enum class Opcode { Term, And, Or, Not };
+        Opcode opcode;
+        size_t term;
+    };
+
+    /**
+     * Recursive-descent parser of predicates into a postfix program, where
+     * predicate := conjunction ('||' conjunction)*
+     * conjunction := negation ('&&' negation)*
+     * negation := '!' negation | '(' predicate ')' | path (operator literal)?
+     * A path without operator must be Boolean and means `path == true`.
+     */
+    class _Predicate_Parser {
+    private:
+        const Schema& schema;
+        const char* begin;
+        const char* current;
+        const char* end;
+        std::vector<_Predicate_Term>& terms;
+        std::vector<_Predicate_Instruction>& program;
+        std::string scratch;
+
+        [[noreturn]] void fail(const std::string& expectation) const {
+            throw std::invalid_argument(("Value Error: Unable to parse predicate at position " + std::to_string(current - begin) + ", expect " + expectation).c_str());
+        }
+        void skip_spaces() {
+            while (current != end && isspace(static_cast<unsigned char>(*current))) ++current;
+        }
+        bool consume(const char* token) {
+            skip_spaces();
+            size_t length = strlen(token);
+            if (static_cast<size_t>(end - current) < length || memcmp(current, token, length) != 0) return false;
+            current += length;
+            return true;
+        }
+        void parse_disjunction() {
+            parse_conjunction();
+            while (consume("||")) {
+                parse_conjunction();
+                program.push_back({ _Predicate_Instruction::Opcode::Or, 0 });
+            }
+        }
+        void parse_conjunction() {
+            parse_negation();
+            while (consume("&&")) {
+                parse_negation();
+                program.push_back({ _Predicate_Instruction::Opcode::And, 0 });
+            }
+        }
+        void parse_negation() {
+            if (consume("!")) {
+                parse_negation();
+                program.push_back({ _Predicate_Instruction::Opcode::Not, 0 });
+            } else if (consume("(")) {
+                parse_disjunction();
+                if (!consume(")")) fail("')'");
+            } else {
+                parse_comparison();
+            }
+        }
+        void parse_comparison() {
+            static const char* operators[] = { "==", "!=", "<=", ">=", "<", ">" };
+            static const Comparison comparisons[] = { Comparison::Equal, Comparison::Not_Equal, Comparison::Less_Equal, Comparison::Greater_Equal, Comparison::Less, Comparison::Greater };
+            skip_spaces();
+            const char* first = current;
+            while (current != end && !isspace(static_cast<unsigned char>(*current)) && !strchr("=!<>&|()'\"", *current)) ++current;
+            if (current == first) fail("path");
+            std::string path(first, current);
+            Field_Path field = schema.compile_path(path);
+            if (is_variable_length(field.get_Type())) {
+                current = first;
+                fail("path of a Primitive Type other than String and Blob");
+            }
+
+            size_t index = 0;
+            while (index < 6 && !consume(operators[index])) ++index;
+            uint64_t constant = 0;
+            if (index == 6) {
+                if (field.get_Type() != Primitive_Data_Types::Boolean) fail("comparison operator after path '" + path + "'");
+                bool truth = true;
+                memcpy(&constant, &truth, sizeof(bool));
+                terms.push_back({ field, Comparison::Equal, constant, _compare_kernel(field.get_Type(), Comparison::Equal) });
+            } else {
+                skip_spaces();
+                const char* literal = current;
+                const char* literal_begin = current;
+                const char* literal_end = current;
+                if (current != end && (*current == '\'' || *current == '"')) {
+                    const char* close = static_cast<const char*>(memchr(current + 1, *current, end - current - 1));
+                    if (close == nullptr) fail("closing quote");
+                    literal_begin = current + 1;
+                    literal_end = close;
+                    current = close + 1;
+                } else {
+                    while (current != end && !isspace(static_cast<unsigned char>(*current)) && !strchr("&|()", *current)) ++current;
+                    literal_end = current;
+                }
+                if (parse_value(field.get_Type(), literal_begin, literal_end, &constant, scratch) != Status::Ok) {
+                    current = literal;
+                    fail("value of " + get_string_from_type(field.get_Type()));
+                }
+                terms.push_back({ field, comparisons[index], constant, _compare_kernel(field.get_Type(), comparisons[index]) });
+            }
+            program.push_back({ _Predicate_Instruction::Opcode::Term, terms.size() - 1 });
+        }
+    public:
+        _Predicate_Parser(const Schema& _schema, const std::string& expression, std::vector<_Predicate_Term>& _terms, std::vector<_Predicate_Instruction>& _program):schema(_schema), begin(expression.data()), current(expression.data()), end(expression.data() + expression.length()), terms(_terms), program(_program) {}
+        void parse() {
+            parse_disjunction();
+            skip_spaces();
+            if (current != end) fail("'&&', '||' or end of predicate");
+        }
+    };
+
+    /**
+     * Boolean expression over Primitive Types of a row, like `price > 10.5 && active && region == 'E'`, compiled for scans
+     * Paths are resolved into offsets and constants are parsed into the data type of their field once, when the predicate is bound to a type.
+     * Scans evaluate each comparison over a block of rows with a kernel specialized for its data type and operator,
+     * and combine the masks of blocks by a postfix program, so that no row goes through a virtual call or a lookup.
+     * 
+     * Comparisons support `==`, `!=`, `<`, `<=`, `>` and `>=` between a path and a literal, where Char literals are quoted,
+     * and combine with `&&`, `||`, `!` and parentheses. Floats compare as IEEE, so `nan` only satisfies `!=`.
+     */
+    class Predicate {
+    private:
+        std::shared_ptr<const Schema> schema;
+        std::string expression;
+        std::vector<_Predicate_Term> terms;
+        std::vector<_Predicate_Instruction> program;
+        /* Largest number of masks alive while running the program */
+        size_t depth;
+
+        void check_schema(const std::shared_ptr<const Schema>& other, const char* storage) const {
+            if (other != schema) {
+                throw std::invalid_argument(("Value Error: Cannot filter " + std::string(storage) + " of type '" + other->get_name() + "' by predicate of type '" + schema->get_name() + "'").c_str());
+            }
+        }
+        /**
+         * Evaluate `count` rows from row `first` into the first mask of `masks`, whose masks are `width` bytes apart
+         * The value of term `t` at row `r` is at `bases[t] + strides[t] * r`.
+         */
+        void evaluate(const char* const* bases, const size_t* strides, size_t first, size_t count, uint8_t* masks, size_t width) const {
+            size_t top = 0;
+            for (const _Predicate_Instruction& instruction : program) {
+                // Masks form a stack, where `top` is the next free one
+                switch (instruction.opcode) {
+                case _Predicate_Instruction::Opcode::Term: {
+                    const _Predicate_Term& term = terms[instruction.term];
+                    term.kernel(bases[instruction.term] + strides[instruction.term] * first, strides[instruction.term], count, &term.constant, masks + width * top);
+                    ++top;
+                    break;
+                }
+                case _Predicate_Instruction::Opcode::And: {
+                    uint8_t* left = masks + width * (top - 2);
+                    // A constant distance between masks lets the loop be vectorized
+                    if (width == FILTER_BLOCK_ROWS) for (size_t index = 0; index < count; ++index) left[index] &= left[index + FILTER_BLOCK_ROWS];
+                    else for (size_t index = 0; index < count; ++index) left[index] &= left[index + width];
+                    --top;
+                    break;
+                }
+                case _Predicate_Instruction::Opcode::Or: {
+                    uint8_t* left = masks + width * (top - 2);
+                    if (width == FILTER_BLOCK_ROWS) for (size_t index = 0; index < count; ++index) left[index] |= left[index + FILTER_BLOCK_ROWS];
+                    else for (size_t index = 0; index < count; ++index) left[index] |= left[index + width];
+                    --top;
+                    break;
+                }
+                case _Predicate_Instruction::Opcode::Not: {
+                    uint8_t* operand = masks + width * (top - 1);
+                    for (size_t index = 0; index < count; ++index) operand[index] ^= 1;
+                    break;
+                }
+                }
+            }
+        }
+        /* Number of threads scanning `rows` rows, where each thread scans at least `FILTER_PARALLEL_ROWS` rows */
+        static size_t count_parts(size_t rows, size_t threads) {
+            if (threads == 0) threads = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+            return std::max<size_t>(std::min(threads, rows / FILTER_PARALLEL_ROWS), 1);
+        }
+        /**
+         * Evaluate `rows` rows by `parts` threads, calling `consume(part, first, count, mask)` for each block
+         * Parts are multiples of `FILTER_BLOCK_ROWS` rows, and the calling thread scans the first part itself.
+         */
+        template <typename Consume>
+        void scan(const std::vector<const char*>& bases, const std::vector<size_t>& strides, size_t rows, size_t parts, Consume consume) const {
+            size_t blocks = (rows + FILTER_BLOCK_ROWS - 1) / FILTER_BLOCK_ROWS;
+            size_t part_rows = (blocks + parts - 1) / parts * FILTER_BLOCK_ROWS;
+            std::vector<std::exception_ptr> errors(parts);
+            auto run = [&](size_t part) {
+                try {
+                    std::vector<uint8_t> masks(FILTER_BLOCK_ROWS * depth);
+                    for (size_t first = part * part_rows; first < std::min(rows, (part + 1) * part_rows); first += FILTER_BLOCK_ROWS) {
+                        size_t count = std::min(FILTER_BLOCK_ROWS, rows - first);
+                        evaluate(bases.data(), strides.data(), first, count, masks.data(), FILTER_BLOCK_ROWS);
+                        consume(part, first, count, masks.data());
+                    }
+                } catch (...) {
+                    errors[part] = std::current_exception();
+                }
+            };
+            std::vector<std::thread> workers;
+            for (size_t part = 1; part < parts; ++part) workers.emplace_back(run, part);
+            run(0);
+            for (std::thread& worker : workers) worker.join();
+            for (const std::exception_ptr& error : errors) {
+                if (error != nullptr) std::rethrow_exception(error);
+            }
+        }
+        std::vector<size_t> select(const std::vector<const char*>& bases, const std::vector<size_t>& strides, size_t rows, size_t threads) const {
+            size_t parts = count_parts(rows, threads);
+            std::vector<std::vector<size_t>> selections(parts);
+            scan(bases, strides, rows, parts, [&selections](size_t part, size_t first, size_t count, const uint8_t* mask) {
+                std::vector<size_t>& selection = selections[part];
+                size_t size = selection.size();
+                selection.resize(size + count);
+                // Write every row and advance only past selected ones, which avoids branches on the mask
+                for (size_t index = 0; index < count; ++index) {
+                    selection[size] = first + index;
+                    size += mask[index];
+                }
+                selection.resize(size);
+            });
+            for (size_t part = 1; part < parts; ++part) selections[0].insert(selections[0].end(), selections[part].begin(), selections[part].end());
+            return std::move(selections[0]);
+        }
+        std::vector<uint64_t> bitmap(const std::vector<const char*>& bases, const std::vector<size_t>& strides, size_t rows, size_t threads) const {
+            std::vector<uint64_t> bits((rows + 63) / 64);
+            // Blocks are multiples of 64 rows, so threads never write the same word
+            scan(bases, strides, rows, count_parts(rows, threads), [&bits](size_t, size_t first, size_t count, const uint8_t* mask) {
+                for (size_t index = 0; index < count; index += 64) bits[(first + index) / 64] = _pack_mask(mask + index, std::min<size_t>(64, count - index));
+            });
+            return bits;
+        }
+        void row_bases(const void* data, size_t stride, std::vector<const char*>& bases, std::vector<size_t>& strides) const {
+            for (const _Predicate_Term& term : terms) {
+                bases.push_back(static_cast<const char*>(data) + term.field.get_Offset());
+                strides.push_back(stride);
+            }
+        }
+        void column_bases(Column_Batch& columns, std::vector<const char*>& bases, std::vector<size_t>& strides) const {
+            for (const _Predicate_Term& term : terms) {
+                bases.push_back(static_cast<const char*>(columns.get_Column(term.field)));
+                strides.push_back(_size_of_primitive(term.field.get_Type()));
+            }
+        }
+    public:
+        Predicate(const Type* type, const std::string& _expression):Predicate(type->get_Schema(), _expression) {}
+        Predicate(const std::shared_ptr<const Schema>& _schema, const std::string& _expression):schema(_schema), expression(_expression), depth(0) {
+            _Predicate_Parser(*schema, expression, terms, program).parse();
+            size_t top = 0;
+            for (const _Predicate_Instruction& instruction : program) {
+                if (instruction.opcode == _Predicate_Instruction::Opcode::Term) depth = std::max(depth, ++top);
+                else if (instruction.opcode != _Predicate_Instruction::Opcode::Not) --top;
+            }
+        }
+        const std::shared_ptr<const Schema>& get_Schema() const { return schema; }
+        const std::string& get_Expression() const { return expression; }
+
+        /* Whether a single row satisfies the predicate, which should be viewed from the bound type */
+        bool operator()(const Type_View& row) const {
+            if (&row.get_Schema() != schema.get()) {
+                throw std::invalid_argument(("Value Error: Cannot filter row of type '" + row.get_name() + "' by predicate of type '" + schema->get_name() + "'").c_str());
+            }
+            if (row.get_data() == nullptr) throw std::invalid_argument(("Nullpointer Error: Cannot filter null pointer of type '" + schema->get_name() + "'").c_str());
+            std::vector<const char*> bases;
+            std::vector<size_t> strides;
+            row_bases(row.get_data(), 0, bases, strides);
+            std::vector<uint8_t> masks(depth);
+            evaluate(bases.data(), strides.data(), 0, 1, masks.data(), 1);
+            return masks[0] != 0;
+        }
+
+        /**
+         * Get ascending indices of rows satisfying the predicate
+         * \param threads number of threads scanning parts of rows, where 0 means every core
+         */
+        std::vector<size_t> select(const Record_Batch& rows, size_t threads = 0) const {
+            check_schema(rows.get_Schema(), "rows");
+            std::vector<const char*> bases;
+            std::vector<size_t> strides;
+            row_bases(rows.get_data(), rows.get_Stride(), bases, strides);
+            return select(bases, strides, rows.get_Size(), threads);
+        }
+        std::vector<size_t> select(Column_Batch& columns, size_t threads = 0) const {
+            check_schema(columns.get_Schema(), "columns");
+            std::vector<const char*> bases;
+            std::vector<size_t> strides;
+            column_bases(columns, bases, strides);
+            return select(bases, strides, columns.get_Size(), threads);
+        }
+        std::vector<size_t> select(Mapped_Record_File& file, size_t threads = 0) const {
+            check_schema(file.get_Schema(), "rows");
+            std::vector<const char*> bases;
+            std::vector<size_t> strides;
+            row_bases(file.get_data(), file.get_Stride(), bases, strides);
+            return select(bases, strides, file.get_Size(), threads);
+        }
+        /* Get a bitmap of rows, where bit `row % 64` of word `row / 64` is set if `row` satisfies the predicate */
+        std::vector<uint64_t> bitmap(const Record_Batch& rows, size_t threads = 0) const {
+            check_schema(rows.get_Schema(), "rows");
+            std::vector<const char*> bases;
+            std::vector<size_t> strides;
+            row_bases(rows.get_data(), rows.get_Stride(), bases, strides);
+            return bitmap(bases, strides, rows.get_Size(), threads);
+        }
+        std::vector<uint64_t> bitmap(Column_Batch& columns, size_t threads = 0) const {
+            check_schema(columns.get_Schema(), "columns");
+            std::vector<const char*> bases;
+            std::vector<size_t> strides;
+            column_bases(columns, bases, strides);
+            return bitmap(bases, strides, columns.get_Size(), threads);
+        }
+        std::vector<uint64_t> bitmap(Mapped_Record_File& file, size_t threads = 0) const {
+            check_schema(file.get_Schema(), "rows");
+            std::vector<const char*> bases;
+            std::vector<size_t> strides;
+            row_bases(file.get_data(), file.get_Stride(), bases, strides);
+            return bitmap(bases, strides, file.get_Size(), threads);
+        }
+    };
+
+    /* Convert `count` values of `From` into `To`, which are `src_stride` and `dst_stride` bytes apart */
+    template <typename From, typename To>
+    inline void _convert_strided(char* dst, size_t dst_stride, const char* src, size_t src_stride, size_t count) {
+        for (size_t index = 0; index < count; ++index) {
+            From value;
+            memcpy(&value, src + src_stride * index, sizeof(From));
+            To result = static_cast<To>(value);
+            memcpy(dst + dst_stride * index, &result, sizeof(To));
+        }
+    }
+
+    /* Fill `count` elements of `element_size` bytes with zero, which are `dst_stride` bytes apart */
+    inline void _zero_strided(char* dst, size_t dst_stride, size_t element_size, size_t count) {
+        static const char zeros[32] = {};
+        if (element_size <= 32) copy_strided(dst, dst_stride, zeros, 0, element_size, count);
+        else for (size_t index = 0; index < count; ++index) memset(dst + dst_stride * index, 0, element_size);
+    }
+
+    typedef void (*_Convert_Kernel)(char* dst, size_t dst_stride, const char* src, size_t src_stride, size_t count);
+
+    /**
+     * Whether every value of `from` is kept exactly by `to`
+     * Integers widen into larger integers which hold their range and into floats whose mantissa holds their bits,
+     * while Char and Boolean only convert into themselves.
+     */
+    inline bool is_widening(Primitive_Data_Types from, Primitive_Data_Types to) {
+        if (from == to) return true;
+        switch (from) {
+        case Primitive_Data_Types::Int_8:
+            return to == Primitive_Data_Types::Int_16 || to == Primitive_Data_Types::Int_32 || to == Primitive_Data_Types::Int_64 || to == Primitive_Data_Types::Float_32 || to == Primitive_Data_Types::Float_64;
+        case Primitive_Data_Types::Int_16:
+            return to == Primitive_Data_Types::Int_32 || to == Primitive_Data_Types::Int_64 || to == Primitive_Data_Types::Float_32 || to == Primitive_Data_Types::Float_64;
+        case Primitive_Data_Types::Int_32:
+            return to == Primitive_Data_Types::Int_64 || to == Primitive_Data_Types::Float_64;
+        case Primitive_Data_Types::Unsigned_Int_8:
+            return to == Primitive_Data_Types::Unsigned_Int_16 || to == Primitive_Data_Types::Unsigned_Int_32 || to == Primitive_Data_Types::Unsigned_Int_64 ||
+                to == Primitive_Data_Types::Int_16 || to == Primitive_Data_Types::Int_32 || to == Primitive_Data_Types::Int_64 || to == Primitive_Data_Types::Float_32 || to == Primitive_Data_Types::Float_64;
+        case Primitive_Data_Types::Unsigned_Int_16:
+            return to == Primitive_Data_Types::Unsigned_Int_32 || to == Primitive_Data_Types::Unsigned_Int_64 ||
+                to == Primitive_Data_Types::Int_32 || to == Primitive_Data_Types::Int_64 || to == Primitive_Data_Types::Float_32 || to == Primitive_Data_Types::Float_64;
+        case Primitive_Data_Types::Unsigned_Int_32:
+            return to == Primitive_Data_Types::Unsigned_Int_64 || to == Primitive_Data_Types::Int_64 || to == Primitive_Data_Types::Float_64;
+        case Primitive_Data_Types::Float_32:
+            return to == Primitive_Data_Types::Float_64;
+        default:
+            return false;
+        }
+    }
+
+    template <typename From>
+    inline _Convert_Kernel _convert_kernel(Primitive_Data_Types to) {
+        switch (to) {
+        case Primitive_Data_Types::Int_16: return _convert_strided<From, int16_t>;
+        case Primitive_Data_Types::Int_32: return _convert_strided<From, int32_t>;
+        case Primitive_Data_Types::Int_64: return _convert_strided<From, int64_t>;
+        case Primitive_Data_Types::Unsigned_Int_16: return _convert_strided<From, uint16_t>;
+        case Primitive_Data_Types::Unsigned_Int_32: return _convert_strided<From, uint32_t>;
+        case Primitive_Data_Types::Unsigned_Int_64: return _convert_strided<From, uint64_t>;
+        case Primitive_Data_Types::Float_32: return _convert_strided<From, float>;
+        case Primitive_Data_Types::Float_64: return _convert_strided<From, double>;
+        default: return nullptr;
+        }
+    }
+
+    /* Kernel of a widening conversion, which should be checked by `is_widening` before */
+    inline _Convert_Kernel _convert_kernel(Primitive_Data_Types from, Primitive_Data_Types to) {
+        switch (from) {
+        case Primitive_Data_Types::Int_8: return _convert_kernel<int8_t>(to);
+        case Primitive_Data_Types::Int_16: return _convert_kernel<int16_t>(to);
+        case Primitive_Data_Types::Int_32: return _convert_kernel<int32_t>(to);
+        case Primitive_Data_Types::Unsigned_Int_8: return _convert_kernel<uint8_t>(to);
+        case Primitive_Data_Types::Unsigned_Int_16: return _convert_kernel<uint16_t>(to);
+        case Primitive_Data_Types::Unsigned_Int_32: return _convert_kernel<uint32_t>(to);
+        case Primitive_Data_Types::Float_32: return _convert_kernel<float>(to);
+        default: return nullptr;
+        }
+    }
+
+    /* One step of `Copy_Plan`, which writes `size` bytes of the destination row from `dst_offset` */
+    struct Copy_Step {
+        enum class Kind {
+            Copy,
+            Convert,
+            Zero
+        };
+        Kind kind;
+        size_t src_offset;
+        size_t dst_offset;
+        size_t size;
+        Primitive_Data_Types src_type;
+        Primitive_Data_Types dst_type;
+        _Convert_Kernel kernel;
+    };
+
+    /**
+     * Precomputed plan of converting rows from one version of a `Type` into another
+     * Primitive Types are matched by their flattened paths like "point.x" or "tensor[3]", so fields could be
+     * reordered, re-laid out, nested into other positions or widened by `is_widening`.
+     * Renamed fields are matched by `renames`, which maps a path or a path prefix in the destination into the source.
+     * Every byte of the destination row is written: matched fields are copied or converted, and new fields and padding are zero-filled.
+     * Adjacent copies and zero-fills are merged into single runs, so rows of the same layout are copied by one `memcpy`.
+     * String and Blob are copied as slots, and their long values are then copied into the arena of the destination.
+     */
+    class Copy_Plan {
+    private:
+        std::shared_ptr<const Schema> source;
+        std::shared_ptr<const Schema> destination;
+        std::vector<Copy_Step> steps;
+        /* Offsets of copied String and Blob in the destination row */
+        std::vector<size_t> string_offsets;
+
+        static std::string rename(const std::string& path, const std::map<std::string, std::string>& renames) {
+            const std::map<std::string, std::string>::const_iterator exact = renames.find(path);
+            if (exact != renames.end()) return exact->second;
+            // The longest prefix ending at a field or an element wins, so "a.b" overrides "a" for "a.b.c"
+            std::string result = path;
+            size_t longest = 0;
+            for (const std::pair<const std::string, std::string>& entry : renames) {
+                const std::string& prefix = entry.first;
+                if (prefix.size() <= longest || prefix.size() >= path.size() || path.compare(0, prefix.size(), prefix) != 0) continue;
+                if (path[prefix.size()] != '.' && path[prefix.size()] != '[') continue;
+                result = entry.second + path.substr(prefix.size());
+                longest = prefix.size();
+            }
+            return result;
+        }
+        void push(const Copy_Step& step) {
+            if (!steps.empty()) {
+                Copy_Step& last = steps.back();
+                bool adjacent = last.dst_offset + last.size == step.dst_offset;
+                if (adjacent && last.kind == Copy_Step::Kind::Zero && step.kind == Copy_Step::Kind::Zero) {
+                    last.size += step.size;
+                    return;
+                }
+                if (adjacent && last.kind == Copy_Step::Kind::Copy && step.kind == Copy_Step::Kind::Copy && last.src_offset + last.size == step.src_offset) {
+                    last.size += step.size;
+                    return;
+                }
+            }
+            steps.push_back(step);
+        }
+        void compile(const std::map<std::string, std::string>& renames) {
+            if (source->get_Type_Class() != Type_Class::Struct || destination->get_Type_Class() != Type_Class::Struct) {
+                throw std::invalid_argument(("Value Error: Cannot plan copy from type '" + source->get_name() + "' into type '" + destination->get_name() + "', which are not both Struct Type").c_str());
+            }
+            std::map<std::string, Primitive_Field> source_fields;
+            for (const Primitive_Field& field : flatten_primitives(*source)) source_fields.insert(std::make_pair(field.path, field));
+            std::vector<Primitive_Field> destination_fields = flatten_primitives(*destination);
+            std::sort(destination_fields.begin(), destination_fields.end(), [](const Primitive_Field& a, const Primitive_Field& b) { return a.offset < b.offset; });
+
+            size_t offset = 0;
+            for (const Primitive_Field& field : destination_fields) {
+                size_t size = _size_of_primitive(field.type);
+                if (field.offset > offset) push({ Copy_Step::Kind::Zero, 0, offset, field.offset - offset, field.type, field.type, nullptr });
+                std::string path = rename(field.path, renames);
+                const std::map<std::string, Primitive_Field>::const_iterator found = source_fields.find(path);
+                if (found == source_fields.end()) {
+                    if (path != field.path) {
+                        throw std::invalid_argument(("Value Error: Cannot find '" + path + "', renamed from '" + field.path + "', in type '" + source->get_name() + "'").c_str());
+                    }
+                    push({ Copy_Step::Kind::Zero, 0, field.offset, size, field.type, field.type, nullptr });
+                } else if (found->second.type == field.type) {
+                    push({ Copy_Step::Kind::Copy, found->second.offset, field.offset, size, field.type, field.type, nullptr });
+                    if (is_variable_length(field.type)) string_offsets.push_back(field.offset);
+                } else if (is_widening(found->second.type, field.type)) {
+                    push({ Copy_Step::Kind::Convert, found->second.offset, field.offset, size, found->second.type, field.type, _convert_kernel(found->second.type, field.type) });
+                } else {
+                    throw std::invalid_argument(("Value Error: Cannot convert '" + path + "' from " + get_string_from_type(found->second.type) + " in type '" + source->get_name() +
+                        "' into " + get_string_from_type(field.type) + " '" + field.path + "' in type '" + destination->get_name() + "', which is not widening").c_str());
+                }
+                offset = field.offset + size;
+            }
+            if (destination->size_of() > offset) {
+                push({ Copy_Step::Kind::Zero, 0, offset, destination->size_of() - offset, Primitive_Data_Types::Char, Primitive_Data_Types::Char, nullptr });
+            }
+        }
+        void check_schemas(const std::shared_ptr<const Schema>& src, const std::shared_ptr<const Schema>& dst) const {
+            if (src != source || dst != destination) {
+                throw std::invalid_argument(("Value Error: Cannot copy type '" + src->get_name() + "' into type '" + dst->get_name() + "' by plan from type '" +
+                    source->get_name() + "' into type '" + destination->get_name() + "'").c_str());
+            }
+        }
+    public:
+        Copy_Plan(const Type* _source, const Type* _destination, const std::map<std::string, std::string>& renames = std::map<std::string, std::string>())
+            :Copy_Plan(_source->get_Schema(), _destination->get_Schema(), renames) {}
+        Copy_Plan(const std::shared_ptr<const Schema>& _source, const std::shared_ptr<const Schema>& _destination, const std::map<std::string, std::string>& renames = std::map<std::string, std::string>())
+            :source(_source), destination(_destination) {
+            compile(renames);
+        }
+        const std::shared_ptr<const Schema>& get_Source() const { return source; }
+        const std::shared_ptr<const Schema>& get_Destination() const { return destination; }
+        const std::vector<Copy_Step>& get_Steps() const { return steps; }
+        /* Whether rows are copied by a single `memcpy` of the whole row */
+        bool is_Identity() const {
+            return steps.size() == 1 && steps[0].kind == Copy_Step::Kind::Copy && steps[0].src_offset == 0 && steps[0].size == source->size_of();
+        }
+
+        /* One step in each line, like "copy [0, 8) -> [8, 16)" */
+        std::string string() const {
+            std::string str;
+            for (const Copy_Step& step : steps) {
+                std::string target = "[" + std::to_string(step.dst_offset) + ", " + std::to_string(step.dst_offset + step.size) + ")";
+                if (step.kind == Copy_Step::Kind::Copy) {
+                    str += "copy [" + std::to_string(step.src_offset) + ", " + std::to_string(step.src_offset + step.size) + ") -> " + target + "\n";
+                } else if (step.kind == Copy_Step::Kind::Convert) {
+                    str += "convert " + get_string_from_type(step.src_type) + " [" + std::to_string(step.src_offset) + ", " + std::to_string(step.src_offset + _size_of_primitive(step.src_type)) +
+                        ") -> " + get_string_from_type(step.dst_type) + " " + target + "\n";
+                } else {
+                    str += "zero " + target + "\n";
+                }
+            }
+            return str;
+        }
+
+        /**
+         * Convert `rows` rows from `src` into `dst` without checking, whose rows are `src_stride` and `dst_stride` bytes apart
+         * Long String or Blob of `dst` still refer to the arena of `src`, unless they are copied by `apply` of `Type` or `Record_Batch`.
+         * Steps run over blocks of `CONVERSION_BLOCK_ROWS` rows, so each kernel loops over many rows while the block stays in cache.
+         */
+        void apply(const void* src, size_t src_stride, void* dst, size_t dst_stride, size_t rows) const {
+            const char* _src = static_cast<const char*>(src);
+            char* _dst = static_cast<char*>(dst);
+            if (is_Identity() && src_stride == dst_stride && src_stride == source->size_of()) {
+                if (rows != 0) memcpy(_dst, _src, src_stride * rows);
+                return;
+            }
+            for (size_t first = 0; first < rows; first += CONVERSION_BLOCK_ROWS) {
+                size_t count = std::min(CONVERSION_BLOCK_ROWS, rows - first);
+                const char* src_block = _src + src_stride * first;
+                char* dst_block = _dst + dst_stride * first;
+                for (const Copy_Step& step : steps) {
+                    char* target = dst_block + step.dst_offset;
+                    switch (step.kind) {
+                    case Copy_Step::Kind::Copy:
+                        copy_strided(target, dst_stride, src_block + step.src_offset, src_stride, step.size, count);
+                        break;
+                    case Copy_Step::Kind::Convert:
+                        step.kernel(target, dst_stride, src_block + step.src_offset, src_stride, count);
+                        break;
+                    case Copy_Step::Kind::Zero:
+                        _zero_strided(target, dst_stride, step.size, count);
+                        break;
+                    }
+                }
+            }
+        }
+        /* Convert the data of `src` into the data of `dst`, which should be of the planned types */
+        void apply(Type& src, Type& dst) const {
+            check_schemas(src.get_Schema(), dst.get_Schema());
+            if (src.get_data() == nullptr || dst.get_data() == nullptr) {
+                throw std::invalid_argument(("Nullpointer Error: Cannot copy type '" + source->get_name() + "' into type '" + destination->get_name() + "' of null pointer").c_str());
+            }
+            apply(src.get_data(), 0, dst.get_data(), 0, 1);
+            if (string_offsets.empty()) return;
+            String_Arena* arena = dst.get_Arena();
+            if (arena == nullptr) {
+                throw std::invalid_argument(("Nullpointer Error: Cannot copy String or Blob into type '" + destination->get_name() + "' without an arena").c_str());
+            }
+            for (size_t offset : string_offsets) _rehome_strings(static_cast<char*>(dst.get_data()) + offset, 0, 1, src.get_Arena(), *arena);
+        }
+        /* Replace rows of `dst` by rows of `src` converted in order */
+        void apply(const Record_Batch& src, Record_Batch& dst) const {
+            check_schemas(src.get_Schema(), dst.get_Schema());
+            // Every byte is overwritten by the plan, so existing rows are kept rather than zero-filled again
+            dst.resize(std::min(dst.get_Size(), src.get_Size()));
+            dst.resize(src.get_Size());
+            apply(src.get_data(), src.get_Stride(), dst.get_data(), dst.get_Stride(), src.get_Size());
+            if (string_offsets.empty() || &src == &dst) return;
+            // Long values of replaced rows are no longer referred to
+            dst.get_Arena().clear();
+            for (size_t offset : string_offsets) {
+                _rehome_strings(static_cast<char*>(dst.get_data()) + offset, dst.get_Stride(), dst.get_Size(), &src.get_Arena(), dst.get_Arena());
+            }
+        }
+    };
+
+    const uint64_t _HASH_MULTIPLIER = 0x9e3779b97f4a7c15ULL;
+
+    inline uint64_t _load_word(const char* src) {
+        uint64_t word;
+        memcpy(&word, src, sizeof(word));
+        return word;
+    }
+    inline uint64_t _mix_word(uint64_t hash, uint64_t word) {
+        hash = (hash ^ word) * _HASH_MULTIPLIER;
+        return hash ^ (hash >> 29);
+    }
+    /**
+     * Hash `length` bytes by 8-byte words, where four independent lanes consume 32-byte blocks
+     * The result only depends on the bytes, so keys gathered from different layouts hash the same.
+     */
+    inline uint64_t hash_bytes(const void* src, size_t length) {
+        const char* bytes = static_cast<const char*>(src);
+        uint64_t hash = length * _HASH_MULTIPLIER;
+        size_t index = 0;
+        if (length >= 32) {
+            uint64_t lanes[4] = { hash, hash + 1, hash + 2, hash + 3 };
+            for (; index + 32 <= length; index += 32) {
+                for (size_t lane = 0; lane < 4; ++lane) lanes[lane] = _mix_word(lanes[lane], _load_word(bytes + index + lane * 8));
+            }
+            hash = _mix_word(_mix_word(_mix_word(lanes[0], lanes[1]), lanes[2]), lanes[3]);
+        }
+        for (; index + 8 <= length; index += 8) hash = _mix_word(hash, _load_word(bytes + index));
+        // The tail is read by fixed-size loads, which overlap bytes already read, instead of calling `memcpy` of a variable size
+        if (index < length) {
+            uint64_t word;
+            if (length >= 8) {
+                word = _load_word(bytes + length - 8);
+            } else if (length >= 4) {
+                uint32_t low, high;
+                memcpy(&low, bytes, sizeof(low));
+                memcpy(&high, bytes + length - 4, sizeof(high));
+                word = low | static_cast<uint64_t>(high) << 32;
+            } else {
+                word = static_cast<uint64_t>(static_cast<unsigned char>(bytes[0])) | static_cast<uint64_t>(static_cast<unsigned char>(bytes[length / 2])) << 8 |
+                    static_cast<uint64_t>(static_cast<unsigned char>(bytes[length - 1])) << 16;
+            }
+            hash = _mix_word(hash, word);
+        }
+        // Finalizer of MurmurHash3, so that low bits are usable as slots
+        hash ^= hash >> 33;
+        hash *= 0xff51afd7ed558ccdULL;
+        hash ^= hash >> 33;
+        hash *= 0xc4ceb9fe1a85ec53ULL;
+        return hash ^ (hash >> 33);
+    }
+
+    /* Run of key bytes in a row, where floats are normalized so that -0.0 equals 0.0 and every NaN equals each other */
+    struct _Key_Segment {
+        enum class Kind {
+            Bytes,
+            Float_32,
+            Float_64
+        };
+        Kind kind;
+        size_t offset;
+        size_t size;
+    };
+
+    inline uint32_t _normalize_float(uint32_t bits) {
+        if ((bits & 0x7fffffffu) == 0) return 0;
+        if ((bits & 0x7f800000u) == 0x7f800000u && (bits & 0x007fffffu) != 0) return 0x7fc00000u;
+        return bits;
+    }
+    inline uint64_t _normalize_float(uint64_t bits) {
+        if ((bits & 0x7fffffffffffffffULL) == 0) return 0;
+        if ((bits & 0x7ff0000000000000ULL) == 0x7ff0000000000000ULL && (bits & 0x000fffffffffffffULL) != 0) return 0x7ff8000000000000ULL;
+        return bits;
+    }
+    template <typename Bits>
+    inline void _normalize_floats(char* dst, const char* src, size_t size) {
+        for (size_t index = 0; index < size; index += sizeof(Bits)) {
+            Bits bits;
+            memcpy(&bits, src + index, sizeof(Bits));
+            bits = _normalize_float(bits);
+            memcpy(dst + index, &bits, sizeof(Bits));
+        }
+    }
+    template <typename Bits>
+    inline bool _equal_floats(const char* a, const char* b, size_t size) {
+        for (size_t index = 0; index < size; index += sizeof(Bits)) {
+            Bits x, y;
+            memcpy(&x, a + index, sizeof(Bits));
+            memcpy(&y, b + index, sizeof(Bits));
+            if (_normalize_float(x) != _normalize_float(y)) return false;
+        }
+        return true;
+    }
+
+    /* Compare bytes of a Primitive Type by a fixed-size load, instead of calling `memcmp` of a variable size */
+    inline bool _equal_bytes(const char* a, const char* b, size_t size) {
+        switch (size) {
+        case 1: return *a == *b;
+        case 2: { uint16_t x, y; memcpy(&x, a, sizeof(x)); memcpy(&y, b, sizeof(y)); return x == y; }
+        case 4: { uint32_t x, y; memcpy(&x, a, sizeof(x)); memcpy(&y, b, sizeof(y)); return x == y; }
+        case 8: { uint64_t x, y; memcpy(&x, a, sizeof(x)); memcpy(&y, b, sizeof(y)); return x == y; }
+        default: return memcmp(a, b, size) == 0;
+        }
+    }
+
+    /* Bytes of key gathered on the stack, beyond which a thread-local buffer is used */
+    const size_t HASH_STACK_BYTES = 256;
+
+    /**
+     * Hash and equality of rows compiled from a `Struct` and optional key paths
+     * Keys could be paths of any Type like "id", "point" or "tags[1]", where every Primitive Type inside is a part of the key,
+     * and all Primitive Types are keys if `keys` is empty. Padding and other fields never take part.
+     * Keys in consecutive bytes are merged into runs compared by `memcmp` and hashed by words,
+     * while Float_32 and Float_64 are normalized so that -0.0 equals 0.0 and NaN equals NaN.
+     * The hash only depends on the values of keys in order, so rows of different types hash the same when their keys have the same types.
+     * String and Blob cannot be keys, since long values live in an arena rather than in the row.
+     */
+    class Record_Hasher {
+        friend class Record_Hash_Table;
+    private:
+        std::shared_ptr<const Schema> schema;
+        std::vector<_Key_Segment> segments;
+        /* Each key before merging, which are compared pairwise with keys of another type */
+        std::vector<_Key_Segment> key_fields;
+        std::vector<Primitive_Data_Types> key_types;
+        /* Bytes of all keys */
+        size_t width;
+
+        void push(_Key_Segment::Kind kind, size_t offset, size_t size) {
+            if (!segments.empty()) {
+                _Key_Segment& last = segments.back();
+                if (last.kind == kind && last.offset + last.size == offset) {
+                    last.size += size;
+                    return;
+                }
+            }
+            segments.push_back({ kind, offset, size });
+        }
+        /* Write normalized keys of `row` into `width` bytes of `dst` */
+        void gather(const char* row, char* dst) const {
+            for (const _Key_Segment& segment : segments) {
+                switch (segment.kind) {
+                case _Key_Segment::Kind::Bytes: copy_strided(dst, 0, row + segment.offset, 0, segment.size, 1); break;
+                case _Key_Segment::Kind::Float_32: _normalize_floats<uint32_t>(dst, row + segment.offset, segment.size); break;
+                case _Key_Segment::Kind::Float_64: _normalize_floats<uint64_t>(dst, row + segment.offset, segment.size); break;
+                }
+                dst += segment.size;
+            }
+        }
+        /* Whether keys are a single run of bytes, which are hashed and compared in place */
+        bool contiguous() const {
+            return segments.size() == 1 && segments[0].kind == _Key_Segment::Kind::Bytes;
+        }
+        char* scratch(char* stack) const {
+            if (width <= HASH_STACK_BYTES) return stack;
+            static thread_local std::vector<char> buffer;
+            if (buffer.size() < width) buffer.resize(width);
+            return buffer.data();
+        }
+        void check_view(const Type_View& row) const {
+            if (&row.get_Schema() != schema.get()) {
+                throw std::invalid_argument(("Value Error: Cannot hash row of type '" + row.get_name() + "' by keys of type '" + schema->get_name() + "'").c_str());
+            }
+            if (row.get_data() == nullptr) throw std::invalid_argument(("Nullpointer Error: Cannot hash null pointer of type '" + schema->get_name() + "'").c_str());
+        }
+    public:
+        Record_Hasher(const Type* type, const std::vector<std::string>& keys = std::vector<std::string>()):Record_Hasher(type->get_Schema(), keys) {}
+        Record_Hasher(const std::shared_ptr<const Schema>& _schema, const std::vector<std::string>& keys = std::vector<std::string>()):schema(_schema), width(0) {
+            std::vector<Primitive_Field> fields = flatten_primitives(*schema);
+            std::vector<const Primitive_Field*> selected;
+            if (keys.empty()) {
+                for (const Primitive_Field& field : fields) selected.push_back(&field);
+            }
+            for (const std::string& key : keys) {
+                size_t count = selected.size();
+                for (const Primitive_Field& field : fields) {
+                    const std::string& path = field.path;
+                    if (path == key || (path.size() > key.size() && path.compare(0, key.size(), key) == 0 && (path[key.size()] == '.' || path[key.size()] == '['))) {
+                        selected.push_back(&field);
+                    }
+                }
+                if (selected.size() == count) throw std::invalid_argument(("Value Error: Cannot find key '" + key + "' in type '" + schema->get_name() + "'").c_str());
+            }
+            for (const Primitive_Field* field : selected) {
+                if (is_variable_length(field->type)) {
+                    throw std::invalid_argument(("Value Error: Cannot hash " + get_string_from_type(field->type) + " key '" + field->path + "' of type '" + schema->get_name() + "'").c_str());
+                }
+                size_t size = _size_of_primitive(field->type);
+                _Key_Segment::Kind kind = field->type == Primitive_Data_Types::Float_32 ? _Key_Segment::Kind::Float_32 :
+                    field->type == Primitive_Data_Types::Float_64 ? _Key_Segment::Kind::Float_64 : _Key_Segment::Kind::Bytes;
+                push(kind, field->offset, size);
+                key_fields.push_back({ kind, field->offset, size });
+                key_types.push_back(field->type);
+                width += size;
+            }
+        }
+        const std::shared_ptr<const Schema>& get_Schema() const { return schema; }
+        /* Types of keys in order, which should be the same for rows of two types to match */
+        const std::vector<Primitive_Data_Types>& get_Key_Types() const { return key_types; }
+        /* Number of runs compared at a time */
+        size_t get_Segment_Count() const { return segments.size(); }
+        size_t get_Width() const { return width; }
+        bool is_Compatible(const Record_Hasher& other) const { return key_types == other.key_types; }
+
+        /* Hash the data of a row without checking */
+        uint64_t hash(const void* row) const {
+            const char* _row = static_cast<const char*>(row);
+            if (contiguous()) return hash_bytes(_row + segments[0].offset, width);
+            char stack[HASH_STACK_BYTES];
+            char* buffer = scratch(stack);
+            gather(_row, buffer);
+            return hash_bytes(buffer, width);
+        }
+        /* Compare keys of the data of two rows of this type without checking */
+        bool equal(const void* a, const void* b) const {
+            const char* _a = static_cast<const char*>(a);
+            const char* _b = static_cast<const char*>(b);
+            for (const _Key_Segment& segment : segments) {
+                const char* x = _a + segment.offset;
+                const char* y = _b + segment.offset;
+                switch (segment.kind) {
+                case _Key_Segment::Kind::Bytes: if (memcmp(x, y, segment.size) != 0) return false; break;
+                case _Key_Segment::Kind::Float_32: if (!_equal_floats<uint32_t>(x, y, segment.size)) return false; break;
+                case _Key_Segment::Kind::Float_64: if (!_equal_floats<uint64_t>(x, y, segment.size)) return false; break;
+                }
+            }
+            return true;
+        }
+        /* Compare keys of the data of a row of this type with a row of `other` type without checking, whose keys should be compatible */
+        bool equal(const void* a, const Record_Hasher& other, const void* b) const {
+            if (&other == this) return equal(a, b);
+            const char* _a = static_cast<const char*>(a);
+            const char* _b = static_cast<const char*>(b);
+            if (contiguous() && other.contiguous()) return memcmp(_a + segments[0].offset, _b + other.segments[0].offset, width) == 0;
+            for (size_t index = 0; index < key_fields.size(); ++index) {
+                const _Key_Segment& field = key_fields[index];
+                const char* x = _a + field.offset;
+                const char* y = _b + other.key_fields[index].offset;
+                switch (field.kind) {
+                case _Key_Segment::Kind::Bytes: if (!_equal_bytes(x, y, field.size)) return false; break;
+                case _Key_Segment::Kind::Float_32: if (!_equal_floats<uint32_t>(x, y, field.size)) return false; break;
+                case _Key_Segment::Kind::Float_64: if (!_equal_floats<uint64_t>(x, y, field.size)) return false; break;
+                }
+            }
+            return true;
+        }
+
+        uint64_t operator()(const Type_View& row) const {
+            check_view(row);
+            return hash(row.get_data());
+        }
+        bool equal(const Type_View& a, const Type_View& b) const {
+            check_view(a);
+            check_view(b);
+            return equal(a.get_data(), b.get_data());
+        }
+    };
+
+    /**
+     * Open-addressing hash table keyed by rows, which maps each distinct key to a value like the index of its first row
+     * Rows are referenced rather than copied, so they should stay in place while the table is used.
+     * Slots keep the hash of their row, so that probing compares hashes before keys and growing never rehashes rows.
+     */
+    class Record_Hash_Table {
+    private:
+        struct Record_Slot {
+            uint64_t hash;
+            const void* row;
+            size_t value;
+        };
+        Record_Hasher hasher;
+        std::vector<Record_Slot> slots;
+        size_t size;
+
+        /* Return the slot of the key of `row` hashed by `probe_hasher`, or the empty slot where it would be inserted */
+        size_t probe(const Record_Hasher& probe_hasher, const void* row, uint64_t hash) const {
+            size_t mask = slots.size() - 1;
+            for (size_t slot = hash & mask; ; slot = (slot + 1) & mask) {
+                const Record_Slot& candidate = slots[slot];
+                if (candidate.row == nullptr) return slot;
+                if (candidate.hash == hash && hasher.equal(candidate.row, probe_hasher, row)) return slot;
+            }
+        }
+        void rehash(size_t slot_count) {
+            std::vector<Record_Slot> old_slots(slot_count, Record_Slot{ 0, nullptr, 0 });
+            old_slots.swap(slots);
+            size_t mask = slots.size() - 1;
+            for (const Record_Slot& old_slot : old_slots) {
+                if (old_slot.row == nullptr) continue;
+                size_t slot = old_slot.hash & mask;
+                while (slots[slot].row != nullptr) slot = (slot + 1) & mask;
+                slots[slot] = old_slot;
+            }
+        }
+    public:
+        static const size_t npos = static_cast<size_t>(-1);
+
+        Record_Hash_Table(const Type* type, const std::vector<std::string>& keys = std::vector<std::string>(), size_t capacity = 0):Record_Hash_Table(Record_Hasher(type, keys), capacity) {}
+        Record_Hash_Table(const Record_Hasher& _hasher, size_t capacity = 0):hasher(_hasher), size(0) {
+            reserve(capacity);
+        }
+        const Record_Hasher& get_Hasher() const { return hasher; }
+        /* Get Number of distinct keys */
+        size_t get_Size() const { return size; }
+        /* `reserve` keeps the load factor at most 1/2 for `capacity` keys */
+        void reserve(size_t capacity) {
+            size_t slot_count = 16;
+            while (slot_count < capacity * 2) slot_count *= 2;
+            if (slot_count > slots.size()) rehash(slot_count);
+        }
+        void clear() {
+            std::fill(slots.begin(), slots.end(), Record_Slot{ 0, nullptr, 0 });
+            size = 0;
+        }
+
+        /**
+         * Insert the data of `row` with `value` unless a row of the same key exists, without checking
+         * Return the value of the key, which could be changed in place, and whether `row` is inserted.
+         */
+        std::pair<size_t&, bool> insert(const void* row, size_t value) {
+            if ((size + 1) * 2 > slots.size()) rehash(slots.size() * 2);
+            uint64_t hash = hasher.hash(row);
+            size_t slot = probe(hasher, row, hash);
+            Record_Slot& target = slots[slot];
+            if (target.row != nullptr) return std::pair<size_t&, bool>(target.value, false);
+            target = Record_Slot{ hash, row, value };
+            ++size;
+            return std::pair<size_t&, bool>(target.value, true);
+        }
+        std::pair<size_t&, bool> insert(const Type_View& row, size_t value) {
+            hasher.check_view(row);
+            return insert(row.get_data(), value);
+        }
+        /* Get the value of the key of `row` hashed by `probe_hasher`, or `npos` if not found, without checking */
+        size_t find(const Record_Hasher& probe_hasher, const void* row) const {
+            const Record_Slot& slot = slots[probe(probe_hasher, row, probe_hasher.hash(row))];
+            if (slot.row == nullptr) return npos;
+            return slot.value;
+        }
+        size_t find(const void* row) const {
+            return find(hasher, row);
+        }
+        size_t find(const Type_View& row) const {
+            hasher.check_view(row);
+            return find(row.get_data());
+        }
+    };
+
+    /* Get ascending indices of the first row of each distinct key, where all Primitive Types are keys if `keys` is empty */
+    inline std::vector<size_t> distinct(const Record_Batch& rows, const std::vector<std::string>& keys = std::vector<std::string>()) {
+        Record_Hash_Table table(Record_Hasher(rows.get_Schema(), keys), rows.get_Size());
+        std::vector<size_t> selection;
+        const char* data = static_cast<const char*>(rows.get_data());
+        for (size_t row = 0; row < rows.get_Size(); ++row) {
+            if (table.insert(data + rows.get_Stride() * row, row).second) selection.push_back(row);
+        }
+        return selection;
+    }
+
+    /**
+     * Join rows of `probe` with rows of `build` of the same keys by a hash table built on `build`
+     * Return pairs of (build row, probe row) in the order of probe rows and then build rows.
+     * Keys of both sides should have the same types in order, like `{ "customer_id" }` and `{ "id" }`.
+     */
+    inline std::vector<std::pair<size_t, size_t>> hash_join(const Record_Batch& build, const std::vector<std::string>& build_keys, const Record_Batch& probe, const std::vector<std::string>& probe_keys) {
+        Record_Hasher build_hasher(build.get_Schema(), build_keys), probe_hasher(probe.get_Schema(), probe_keys);
+        if (!build_hasher.is_Compatible(probe_hasher)) {
+            throw std::invalid_argument(("Value Error: Cannot join keys of type '" + probe.get_Schema()->get_name() + "' with keys of different types in type '" + build.get_Schema()->get_name() + "'").c_str());
+        }
+        Record_Hash_Table table(build_hasher, build.get_Size());
+        // Rows of the same key are chained from the first one, by inserting backward
+        // `npos` is copied, since binding the static member to a reference would need its definition at link time
+        const size_t none = Record_Hash_Table::npos;
+        std::vector<size_t> next(build.get_Size(), none);
+        const char* build_data = static_cast<const char*>(build.get_data());
+        for (size_t row = build.get_Size(); row-- > 0; ) {
+            std::pair<size_t&, bool> inserted = table.insert(build_data + build.get_Stride() * row, row);
+            if (!inserted.second) {
+                next[row] = inserted.first;
+                inserted.first = row;
+            }
+        }
+        std::vector<std::pair<size_t, size_t>> matches;
+        const char* probe_data = static_cast<const char*>(probe.get_data());
+        for (size_t row = 0; row < probe.get_Size(); ++row) {
+            for (size_t match = table.find(probe_hasher, probe_data + probe.get_Stride() * row); match != none; match = next[match]) {
+                matches.push_back(std::make_pair(match, row));
+            }
+        }
+        return matches;
+    }
+
+    /* Number of threads working on `rows` rows, where each thread takes at least `part_rows` rows and 0 threads means every core */
+    inline size_t _count_parts(size_t rows, size_t threads, size_t part_rows) {
+        if (threads == 0) threads = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+        return std::max<size_t>(std::min(threads, rows / part_rows), 1);
+    }
+    /* Run `function(part)` for each part on its own thread, where the calling thread runs the first part itself, and rethrow the first error */
+    template <typename Function>
+    inline void _run_parts(size_t parts, Function function) {
+        if (parts == 1) {
+            function(0);
+            return;
+        }
+        std::vector<std::exception_ptr> errors(parts);
+        auto run = [&](size_t part) {
+            try {
+                function(part);
+            } catch (...) {
+                errors[part] = std::current_exception();
+            }
+        };
+        std::vector<std::thread> workers;
+        for (size_t part = 1; part < parts; ++part) workers.emplace_back(run, part);
+        run(0);
+        for (std::thread& worker : workers) worker.join();
+        for (const std::exception_ptr& error : errors) {
+            if (error != nullptr) std::rethrow_exception(error);
+        }
+    }
+
+    /* Number of rows sorted by each thread at least, below which sorting stays on the calling thread */
+    const size_t SORT_PARALLEL_ROWS = 1 << 16;
+    /* Number of rows sorted by LSD radix sort at most, whose entries should fit in cache */
+    const size_t SORT_BUCKET_ROWS = 1 << 14;
+
+    enum class Sort_Order {
+        Ascending,
+        Descending
+    };
+
+    /* Key of `Record_Sorter`, which is a path ending with a Primitive Type like `{ "price", Sort_Order::Descending }` */
+    struct Sort_Key {
+        std::string path;
+        Sort_Order order;
+        Sort_Key(const char* _path, Sort_Order _order = Sort_Order::Ascending):path(_path), order(_order) {}
+        Sort_Key(const std::string& _path, Sort_Order _order = Sort_Order::Ascending):path(_path), order(_order) {}
+    };
+
+    /**
+     * Map a Primitive value into an unsigned integer of the same size, whose unsigned order is the order of values
+     * Signed integers, and Char where `char` is signed, flip their sign bit, and floats flip every bit if negative
+     * or their sign bit otherwise, after -0.0 becomes 0.0 and NaN becomes a positive NaN, which is larger than infinity.
+     */
+    inline uint64_t _order_bits(const char* src, Primitive_Data_Types type) {
+        switch (type) {
+        case Primitive_Data_Types::Int_8: { uint8_t bits; memcpy(&bits, src, sizeof(bits)); return bits ^ 0x80u; }
+        case Primitive_Data_Types::Int_16: { uint16_t bits; memcpy(&bits, src, sizeof(bits)); return bits ^ 0x8000u; }
+        case Primitive_Data_Types::Int_32: { uint32_t bits; memcpy(&bits, src, sizeof(bits)); return bits ^ 0x80000000u; }
+        case Primitive_Data_Types::Int_64: { uint64_t bits; memcpy(&bits, src, sizeof(bits)); return bits ^ 0x8000000000000000ULL; }
+
+        case Primitive_Data_Types::Unsigned_Int_8:
+        case Primitive_Data_Types::Boolean: { uint8_t bits; memcpy(&bits, src, sizeof(bits)); return bits; }
+        // Char is ordered as `char`, the same as predicates and reductions
+        case Primitive_Data_Types::Char: { uint8_t bits; memcpy(&bits, src, sizeof(bits)); return std::numeric_limits<char>::is_signed ? bits ^ 0x80u : bits; }
+        case Primitive_Data_Types::Unsigned_Int_16: { uint16_t bits; memcpy(&bits, src, sizeof(bits)); return bits; }
+        case Primitive_Data_Types::Unsigned_Int_32: { uint32_t bits; memcpy(&bits, src, sizeof(bits)); return bits; }
+        case Primitive_Data_Types::Unsigned_Int_64: { uint64_t bits; memcpy(&bits, src, sizeof(bits)); return bits; }
+
+        case Primitive_Data_Types::Float_32: {
+            uint32_t bits;
+            memcpy(&bits, src, sizeof(bits));
+            bits = _normalize_float(bits);
+            return (bits & 0x80000000u) != 0 ? static_cast<uint32_t>(~bits) : bits | 0x80000000u;
+        }
+        case Primitive_Data_Types::Float_64: {
+            uint64_t bits;
+            memcpy(&bits, src, sizeof(bits));
+            bits = _normalize_float(bits);
+            return (bits & 0x8000000000000000ULL) != 0 ? ~bits : bits | 0x8000000000000000ULL;
+        }
+
+        // Rejected as keys by `Record_Sorter`
+        case Primitive_Data_Types::String:
+        case Primitive_Data_Types::Blob: break;
+        }
+        return 0;
+    }
+
+    /* Field of `Record_Sorter`, placed at byte `position` of the normalized key */
+    struct _Sort_Field {
+        size_t offset;
+        Primitive_Data_Types type;
+        size_t size;
+        /* All bits of `size` bytes for descending order, otherwise 0 */
+        uint64_t invert;
+        size_t position;
+    };
+
+    /**
+     * Stable sort of rows of a `Struct` by keys, each in ascending or descending order
+     * Keys of each row are normalized into big-endian words whose unsigned order is the order of rows,
+     * which are then sorted with the row indices by radix sort of 8-bit digits: MSD passes split rows into buckets
+     * until they fit in cache, and each bucket is sorted by LSD passes. Digits shared by every row are skipped.
+     * With more than one thread, the first pass scatters parts of rows in parallel, and then threads sort buckets independently.
+     * String and Blob cannot be keys, since long values live in an arena rather than in the row.
+     */
+    class Record_Sorter {
+    private:
+        std::shared_ptr<const Schema> schema;
+        std::vector<Sort_Key> keys;
+        std::vector<_Sort_Field> fields;
+        /* Bytes of normalized key */
+        size_t width;
+        /* Words of normalized key, after which each entry holds the index of its row */
+        size_t words;
+
+        void check_schema(const std::shared_ptr<const Schema>& other) const {
+            if (other != schema) {
+                throw std::invalid_argument(("Value Error: Cannot sort rows of type '" + other->get_name() + "' by keys of type '" + schema->get_name() + "'").c_str());
+            }
+        }
+        void encode(const char* row, uint64_t* entry) const {
+            for (size_t word = 0; word < words; ++word) entry[word] = 0;
+            for (const _Sort_Field& field : fields) {
+                uint64_t bits = _order_bits(row + field.offset, field.type) ^ field.invert;
+                size_t word = field.position / 8;
+                size_t end = field.position % 8 + field.size;
+                if (end <= 8) {
+                    entry[word] |= bits << (8 * (8 - end));
+                } else {
+                    // The field straddles two words
+                    entry[word] |= bits >> (8 * (end - 8));
+                    entry[word + 1] |= bits << (8 * (16 - end));
+                }
+            }
+        }
+        static size_t digit(const uint64_t* entry, size_t byte) {
+            return static_cast<size_t>(entry[byte / 8] >> (8 * (7 - byte % 8))) & 0xff;
+        }
+        template <size_t entry_words>
+        static void scatter(const uint64_t* src, uint64_t* dst, size_t first, size_t last, size_t byte, size_t* offsets) {
+            for (size_t row = first; row < last; ++row) {
+                const uint64_t* entry = src + entry_words * row;
+                uint64_t* target = dst + entry_words * offsets[digit(entry, byte)]++;
+                for (size_t word = 0; word < entry_words; ++word) target[word] = entry[word];
+            }
+        }
+        static void scatter(const uint64_t* src, uint64_t* dst, size_t entry_words, size_t first, size_t last, size_t byte, size_t* offsets) {
+            switch (entry_words) {
+            case 2: scatter<2>(src, dst, first, last, byte, offsets); break;
+            case 3: scatter<3>(src, dst, first, last, byte, offsets); break;
+            case 4: scatter<4>(src, dst, first, last, byte, offsets); break;
+            default:
+                for (size_t row = first; row < last; ++row) {
+                    const uint64_t* entry = src + entry_words * row;
+                    memcpy(dst + entry_words * offsets[digit(entry, byte)]++, entry, entry_words * sizeof(uint64_t));
+                }
+            }
+        }
+        /* LSD radix sort of `count` entries of `src` by bytes from `byte`, using `dst` as buffer and leaving them in `src` */
+        void sort_bucket(uint64_t* src, uint64_t* dst, size_t count, size_t byte) const {
+            size_t entry_words = words + 1;
+            std::vector<size_t> counts((width - byte) * 256);
+            for (size_t row = 0; row < count; ++row) {
+                for (size_t index = byte; index < width; ++index) ++counts[(index - byte) * 256 + digit(src + entry_words * row, index)];
+            }
+            uint64_t* from = src;
+            uint64_t* to = dst;
+            size_t offsets[256];
+            for (size_t index = width; index-- > byte; ) {
+                const size_t* count_of = counts.data() + (index - byte) * 256;
+                if (std::find(count_of, count_of + 256, count) != count_of + 256) continue;
+                size_t offset = 0;
+                for (size_t value = 0; value < 256; ++value) {
+                    offsets[value] = offset;
+                    offset += count_of[value];
+                }
+                scatter(from, to, entry_words, 0, count, index, offsets);
+                std::swap(from, to);
+            }
+            if (from != src) memcpy(src, from, entry_words * count * sizeof(uint64_t));
+        }
+        /**
+         * MSD radix sort of `count` entries of `src` by bytes from `byte`, using `dst` as buffer and leaving them in `src`
+         * Each digit splits entries into buckets, until buckets of `SORT_BUCKET_ROWS` entries fit in cache for `sort_bucket`.
+         */
+        void sort_range(uint64_t* src, uint64_t* dst, size_t count, size_t byte) const {
+            if (count <= 1 || byte >= width) return;
+            if (count <= SORT_BUCKET_ROWS) {
+                sort_bucket(src, dst, count, byte);
+                return;
+            }
+            size_t entry_words = words + 1;
+            size_t counts[256] = {};
+            for (size_t row = 0; row < count; ++row) ++counts[digit(src + entry_words * row, byte)];
+            if (std::find(counts, counts + 256, count) != counts + 256) {
+                sort_range(src, dst, count, byte + 1);
+                return;
+            }
+            size_t offsets[256];
+            size_t offset = 0;
+            for (size_t value = 0; value < 256; ++value) {
+                offsets[value] = offset;
+                offset += counts[value];
+            }
+            scatter(src, dst, entry_words, 0, count, byte, offsets);
+            size_t first = 0;
+            for (size_t value = 0; value < 256; ++value) {
+                sort_range(dst + entry_words * first, src + entry_words * first, counts[value], byte + 1);
+                first += counts[value];
+            }
+            memcpy(src, dst, entry_words * count * sizeof(uint64_t));
+        }
+    public:
+        Record_Sorter(const Type* type, const std::vector<Sort_Key>& _keys):Record_Sorter(type->get_Schema(), _keys) {}
+        Record_Sorter(const std::shared_ptr<const Schema>& _schema, const std::vector<Sort_Key>& _keys):schema(_schema), keys(_keys), width(0) {
+            if (keys.empty()) throw std::invalid_argument(("Value Error: Cannot sort rows of type '" + schema->get_name() + "' without keys").c_str());
+            for (const Sort_Key& key : keys) {
+                Field_Path path = schema->compile_path(key.path);
+                if (is_variable_length(path.get_Type())) {
+                    throw std::invalid_argument(("Value Error: Cannot sort by " + get_string_from_type(path.get_Type()) + " key '" + key.path + "' of type '" + schema->get_name() + "'").c_str());
+                }
+                size_t size = _size_of_primitive(path.get_Type());
+                uint64_t invert = key.order == Sort_Order::Descending ? (size == 8 ? ~0ULL : (1ULL << (8 * size)) - 1) : 0;
+                fields.push_back({ path.get_Offset(), path.get_Type(), size, invert, width });
+                width += size;
+            }
+            words = (width + 7) / 8;
+        }
+        const std::shared_ptr<const Schema>& get_Schema() const { return schema; }
+        const std::vector<Sort_Key>& get_Keys() const { return keys; }
+        /* Get Bytes of normalized key of each row */
+        size_t get_Width() const { return width; }
+
+        /**
+         * Get the permutation of `rows` rows from `data` without checking, whose rows are `stride` bytes apart
+         * The i-th row in sorted order is row `order(...)[i]`, and rows of equal keys keep their order.
+         * \param threads number of threads sorting parts of rows, where 0 means every core
+         */
+        std::vector<size_t> order(const void* data, size_t stride, size_t rows, size_t threads = 0) const {
+            const char* _data = static_cast<const char*>(data);
+            size_t entry_words = words + 1;
+            size_t parts = _count_parts(rows, threads, SORT_PARALLEL_ROWS);
+            std::vector<uint64_t> entries(entry_words * rows), buffer(entry_words * rows);
+            // Counts of each digit of each byte in each part
+            std::vector<size_t> counts(parts * width * 256);
+            _run_parts(parts, [&](size_t part) {
+                size_t* count = counts.data() + part * width * 256;
+                for (size_t row = rows * part / parts; row < rows * (part + 1) / parts; ++row) {
+                    uint64_t* entry = entries.data() + entry_words * row;
+                    encode(_data + stride * row, entry);
+                    entry[words] = row;
+                    for (size_t byte = 0; byte < width; ++byte) ++count[byte * 256 + digit(entry, byte)];
+                }
+            });
+            std::vector<size_t> totals(256);
+            size_t byte = 0;
+            for (; byte < width; ++byte) {
+                std::fill(totals.begin(), totals.end(), 0);
+                for (size_t part = 0; part < parts; ++part) {
+                    for (size_t value = 0; value < 256; ++value) totals[value] += counts[(part * width + byte) * 256 + value];
+                }
+                if (std::find(totals.begin(), totals.end(), rows) == totals.end()) break;
+            }
+            const uint64_t* sorted = entries.data();
+            if (byte < width && rows <= SORT_BUCKET_ROWS) {
+                sort_bucket(entries.data(), buffer.data(), rows, byte);
+            } else if (byte < width) {
+                // Rows of a digit are placed by part, so that earlier parts stay before later ones
+                std::vector<size_t> offsets(parts * 256), starts(257);
+                for (size_t value = 0; value < 256; ++value) {
+                    starts[value + 1] = starts[value] + totals[value];
+                    size_t offset = starts[value];
+                    for (size_t part = 0; part < parts; ++part) {
+                        offsets[part * 256 + value] = offset;
+                        offset += counts[(part * width + byte) * 256 + value];
+                    }
+                }
+                _run_parts(parts, [&](size_t part) {
+                    scatter(entries.data(), buffer.data(), entry_words, rows * part / parts, rows * (part + 1) / parts, byte, offsets.data() + part * 256);
+                });
+                // Buckets are sorted independently, each by the next idle thread
+                std::atomic<size_t> next(0);
+                _run_parts(parts, [&](size_t) {
+                    for (size_t value = next++; value < 256; value = next++) {
+                        sort_range(buffer.data() + entry_words * starts[value], entries.data() + entry_words * starts[value], totals[value], byte + 1);
+                    }
+                });
+                sorted = buffer.data();
+            }
+            std::vector<size_t> permutation(rows);
+            for (size_t row = 0; row < rows; ++row) permutation[row] = static_cast<size_t>(sorted[entry_words * row + words]);
+            return permutation;
+        }
+        std::vector<size_t> order(const Record_Batch& rows, size_t threads = 0) const {
+            check_schema(rows.get_Schema());
+            return order(rows.get_data(), rows.get_Stride(), rows.get_Size(), threads);
+        }
+        /* Reorder rows in place by keys */
+        void sort(Record_Batch& rows, size_t threads = 0) const {
+            std::vector<size_t> permutation = order(rows, threads);
+            size_t stride = rows.get_Stride();
+            char* data = static_cast<char*>(rows.get_data());
+            std::vector<char> sorted(stride * rows.get_Size());
+            size_t parts = _count_parts(rows.get_Size(), threads, SORT_PARALLEL_ROWS);
+            _run_parts(parts, [&](size_t part) {
+                for (size_t row = rows.get_Size() * part / parts; row < rows.get_Size() * (part + 1) / parts; ++row) {
+                    memcpy(sorted.data() + stride * row, data + stride * permutation[row], stride);
+                }
+            });
+            if (!sorted.empty()) memcpy(data, sorted.data(), sorted.size());
+        }
+    };
+
+    /* Number of rows grouped by each thread at least, below which grouping stays on the calling thread */
+    const size_t AGGREGATE_PARALLEL_ROWS = 1 << 16;
+    /* Number of rows hashed at a time before their groups are probed, whose hashes stay in cache */
+    const size_t AGGREGATE_BLOCK_ROWS = 512;
+
+    /* Name of a field derived from `path`, like "point_x" from "point.x" or "tags_1" from "tags[1]" */
+    inline std::string _field_name_of_path(const std::string& path) {
+        std::string name;
+        for (char c : path) {
+            if (c == '.' || c == '[') name += '_';
+            else if (c != ']') name += c;
+        }
+        return name;
+    }
+
+    /**
+     * Aggregate of `Group_By`, like `{ Reduction::Sum, "amount" }`, or `{ Reduction::Count }` which counts rows without a path
+     * Its field in the output is `name`, which is like "sum_amount" or "count" by default.
+     */
+    struct Aggregate {
+        Reduction operation;
+        std::string path;
+        std::string name;
+        Aggregate(Reduction _operation, const std::string& _path = "", const std::string& _name = ""):operation(_operation), path(_path), name(_name) {
+            if (!name.empty()) return;
+            switch (operation) {
+            case Reduction::Sum: name = "sum"; break;
+            case Reduction::Min: name = "min"; break;
+            case Reduction::Max: name = "max"; break;
+            case Reduction::Mean: name = "mean"; break;
+            case Reduction::Count_Nonzero: name = "count_nonzero"; break;
+            case Reduction::Count: name = "count"; break;
+            }
+            if (!path.empty()) name += "_" + _field_name_of_path(path);
+        }
+    };
+
+    /* Update aggregate state at `state` by a value at `value`, or merge another state at `value` into it */
+    typedef void (*_Aggregate_Kernel)(char* state, const char* value);
+
+    template <typename T, typename Accumulator>
+    inline void _aggregate_sum(char* state, const char* value) {
+        Accumulator sum;
+        T element;
+        memcpy(&sum, state, sizeof(sum));
+        memcpy(&element, value, sizeof(element));
+        sum += element;
+        memcpy(state, &sum, sizeof(sum));
+    }
+    /* NaN is skipped as `reduce` does, unless every value is NaN */
+    template <typename T>
+    inline void _aggregate_min(char* state, const char* value) {
+        T extreme, element;
+        memcpy(&extreme, state, sizeof(extreme));
+        memcpy(&element, value, sizeof(element));
+        if (element < extreme || extreme != extreme) memcpy(state, &element, sizeof(element));
+    }
+    template <typename T>
+    inline void _aggregate_max(char* state, const char* value) {
+        T extreme, element;
+        memcpy(&extreme, state, sizeof(extreme));
+        memcpy(&element, value, sizeof(element));
+        if (element > extreme || extreme != extreme) memcpy(state, &element, sizeof(element));
+    }
+    template <typename T>
+    inline void _aggregate_count_nonzero(char* state, const char* value) {
+        uint64_t count;
+        T element;
+        memcpy(&count, state, sizeof(count));
+        memcpy(&element, value, sizeof(element));
+        count += element != T();
+        memcpy(state, &count, sizeof(count));
+    }
+    inline void _aggregate_count(char* state, const char*) {
+        uint64_t count;
+        memcpy(&count, state, sizeof(count));
+        ++count;
+        memcpy(state, &count, sizeof(count));
+    }
+    /* State of Mean is a Float_64 sum followed by an Unsigned_Int_64 count */
+    template <typename T>
+    inline void _aggregate_mean(char* state, const char* value) {
+        _aggregate_sum<T, double>(state, value);
+        _aggregate_count(state + sizeof(double), nullptr);
+    }
+    inline void _aggregate_merge_mean(char* state, const char* value) {
+        _aggregate_sum<double, double>(state, value);
+        _aggregate_sum<uint64_t, uint64_t>(state + sizeof(double), value + sizeof(double));
+    }
+
+    /* Kernels and the type of state of `operation` over values of `T` */
+    template <typename T>
+    inline void _aggregate_kernels(Reduction operation, _Aggregate_Kernel& update, _Aggregate_Kernel& merge, Primitive_Data_Types& state_type) {
+        typedef typename _Reduction_Traits<T>::Accumulator Accumulator;
+        switch (operation) {
+        case Reduction::Sum:
+            update = _aggregate_sum<T, Accumulator>;
+            merge = _aggregate_sum<Accumulator, Accumulator>;
+            state_type = _Native_Primitive<Accumulator>::type;
+            break;
+        case Reduction::Min:
+            update = merge = _aggregate_min<T>;
+            break;
+        case Reduction::Max:
+            update = merge = _aggregate_max<T>;
+            break;
+        case Reduction::Mean:
+            update = _aggregate_mean<T>;
+            merge = _aggregate_merge_mean;
+            state_type = Primitive_Data_Types::Float_64;
+            break;
+        case Reduction::Count_Nonzero:
+            update = _aggregate_count_nonzero<T>;
+            merge = _aggregate_sum<uint64_t, uint64_t>;
+            state_type = Primitive_Data_Types::Unsigned_Int_64;
+            break;
+        case Reduction::Count:
+            update = _aggregate_count;
+            merge = _aggregate_sum<uint64_t, uint64_t>;
+            state_type = Primitive_Data_Types::Unsigned_Int_64;
+            break;
+        }
+    }
+    inline void _aggregate_kernels(Reduction operation, Primitive_Data_Types type, _Aggregate_Kernel& update, _Aggregate_Kernel& merge, Primitive_Data_Types& state_type) {
+        // Min and Max keep the type of values
+        state_type = type;
+        switch (type) {
+        case Primitive_Data_Types::Int_8: _aggregate_kernels<int8_t>(operation, update, merge, state_type); break;
+        case Primitive_Data_Types::Int_16: _aggregate_kernels<int16_t>(operation, update, merge, state_type); break;
+        case Primitive_Data_Types::Int_32: _aggregate_kernels<int32_t>(operation, update, merge, state_type); break;
+        case Primitive_Data_Types::Int_64: _aggregate_kernels<int64_t>(operation, update, merge, state_type); break;
+
+        case Primitive_Data_Types::Unsigned_Int_8: _aggregate_kernels<uint8_t>(operation, update, merge, state_type); break;
+        case Primitive_Data_Types::Unsigned_Int_16: _aggregate_kernels<uint16_t>(operation, update, merge, state_type); break;
+        case Primitive_Data_Types::Unsigned_Int_32: _aggregate_kernels<uint32_t>(operation, update, merge, state_type); break;
+        case Primitive_Data_Types::Unsigned_Int_64: _aggregate_kernels<uint64_t>(operation, update, merge, state_type); break;
+
+        case Primitive_Data_Types::Char: _aggregate_kernels<char>(operation, update, merge, state_type); break;
+
+        case Primitive_Data_Types::Boolean: _aggregate_kernels<bool>(operation, update, merge, state_type); break;
+
+        case Primitive_Data_Types::Float_32: _aggregate_kernels<float>(operation, update, merge, state_type); break;
+        case Primitive_Data_Types::Float_64: _aggregate_kernels<double>(operation, update, merge, state_type); break;
+
+        case Primitive_Data_Types::String:
+        case Primitive_Data_Types::Blob:
+            throw std::invalid_argument(("Value Error: Cannot aggregate " + get_string_from_type(type) + " except by Count").c_str());
+        }
+    }
+
+    /**
+     * Hash-based group-by over rows of a `Struct`, like "sum(amount), count(*), max(ts) group by region, product"
+     * Keys and aggregates are bound to offsets once. Each group keeps its keys and aggregate states in a row of
+     * a packed Struct derived from them, and groups are found through an open-addressing table of group indices.
+     * Rows are hashed by blocks of `AGGREGATE_BLOCK_ROWS` before their groups are probed.
+     * With more than one thread, each thread groups a part of rows into its own table, which are merged in order,
+     * so that groups are always in the order of their first rows.
+     * The output is a `Record_Batch` of the derived output Struct, whose fields are keys named like "point_x" followed by aggregates.
+     */
+    class Group_By {
+    private:
+        struct Group_Slot {
+            uint64_t hash;
+            size_t group;
+        };
+        /* Groups of a part of rows, whose states are rows of `state_schema` */
+        struct Partial {
+            std::unique_ptr<Record_Batch> states;
+            std::vector<uint64_t> hashes;
+            std::vector<Group_Slot> slots;
+        };
+        struct Bound_Aggregate {
+            Reduction operation;
+            size_t input_offset;
+            size_t input_size;
+            size_t state_offset;
+            _Aggregate_Kernel update;
+            _Aggregate_Kernel merge;
+        };
+        struct Bound_Key {
+            size_t input_offset;
+            size_t state_offset;
+            size_t size;
+        };
+
+        std::shared_ptr<const Schema> schema;
+        std::vector<std::string> keys;
+        std::vector<Aggregate> aggregates;
+        std::shared_ptr<const Schema> state_schema;
+        std::shared_ptr<const Schema> output_schema;
+        Record_Hasher input_hasher;
+        Record_Hasher state_hasher;
+        std::vector<Bound_Key> bound_keys;
+        std::vector<Bound_Aggregate> bound_aggregates;
+        /* Offsets of Mean in output and in state */
+        std::vector<std::pair<size_t, size_t>> means;
+
+        static std::shared_ptr<const Schema> make_schema(const std::shared_ptr<const Schema>& input, const std::vector<std::string>& keys,
+            const std::vector<Aggregate>& aggregates, bool state, const std::string& name) {
+            std::vector<std::shared_ptr<const Schema>> fields;
+            for (const std::string& key : keys) {
+                fields.push_back(Schema::make_Primitive(input->compile_path(key).get_Type(), _field_name_of_path(key)));
+            }
+            for (const Aggregate& aggregate : aggregates) {
+                Primitive_Data_Types type = Primitive_Data_Types::Unsigned_Int_64;
+                _Aggregate_Kernel update, merge;
+                if (aggregate.operation != Reduction::Count) _aggregate_kernels(aggregate.operation, input->compile_path(aggregate.path).get_Type(), update, merge, type);
+                fields.push_back(Schema::make_Primitive(type, aggregate.name));
+                if (state && aggregate.operation == Reduction::Mean) fields.push_back(Schema::make_Primitive(Primitive_Data_Types::Unsigned_Int_64, "count_of_" + aggregate.name));
+            }
+            return Schema::make_Struct(fields, name);
+        }
+        static std::vector<std::string> key_names(const std::vector<std::string>& keys) {
+            std::vector<std::string> names;
+            for (const std::string& key : keys) names.push_back(_field_name_of_path(key));
+            return names;
+        }
+        /* Return the slot of the group of keys of `row` hashed by `hasher`, or the empty slot where it would be inserted */
+        size_t probe(const Partial& partial, const Record_Hasher& hasher, const char* row, uint64_t hash) const {
+            size_t mask = partial.slots.size() - 1;
+            const char* states = static_cast<const char*>(partial.states->get_data());
+            size_t stride = partial.states->get_Stride();
+            for (size_t slot = hash & mask; ; slot = (slot + 1) & mask) {
+                const Group_Slot& candidate = partial.slots[slot];
+                if (candidate.group == Record_Hash_Table::npos) return slot;
+                if (candidate.hash == hash && state_hasher.equal(states + stride * candidate.group, hasher, row)) return slot;
+            }
+        }
+        /* Add an empty group into `slot`, growing the table to keep its load factor at most 1/2 */
+        char* insert(Partial& partial, size_t slot, uint64_t hash) const {
+            size_t group = partial.states->get_Size();
+            partial.slots[slot] = Group_Slot{ hash, group };
+            partial.hashes.push_back(hash);
+            char* state = static_cast<char*>(partial.states->append().get_data());
+            if ((group + 1) * 2 > partial.slots.size()) {
+                std::vector<Group_Slot> slots(partial.slots.size() * 2, Group_Slot{ 0, Record_Hash_Table::npos });
+                size_t mask = slots.size() - 1;
+                for (size_t index = 0; index <= group; ++index) {
+                    size_t target = partial.hashes[index] & mask;
+                    while (slots[target].group != Record_Hash_Table::npos) target = (target + 1) & mask;
+                    slots[target] = Group_Slot{ partial.hashes[index], index };
+                }
+                partial.slots.swap(slots);
+            }
+            return state;
+        }
+        void group(Partial& partial, const char* data, size_t stride, size_t first, size_t last) const {
+            partial.states.reset(new Record_Batch(state_schema));
+            partial.slots.assign(16, Group_Slot{ 0, Record_Hash_Table::npos });
+            uint64_t hashes[AGGREGATE_BLOCK_ROWS];
+            for (size_t block = first; block < last; block += AGGREGATE_BLOCK_ROWS) {
+                size_t count = std::min(AGGREGATE_BLOCK_ROWS, last - block);
+                const char* rows = data + stride * block;
+                for (size_t index = 0; index < count; ++index) hashes[index] = input_hasher.hash(rows + stride * index);
+                for (size_t index = 0; index < count; ++index) {
+                    const char* row = rows + stride * index;
+                    size_t slot = probe(partial, input_hasher, row, hashes[index]);
+                    if (partial.slots[slot].group != Record_Hash_Table::npos) {
+                        char* state = static_cast<char*>(partial.states->get_data()) + partial.states->get_Stride() * partial.slots[slot].group;
+                        for (const Bound_Aggregate& aggregate : bound_aggregates) aggregate.update(state + aggregate.state_offset, row + aggregate.input_offset);
+                        continue;
+                    }
+                    char* state = insert(partial, slot, hashes[index]);
+                    for (const Bound_Key& key : bound_keys) memcpy(state + key.state_offset, row + key.input_offset, key.size);
+                    for (const Bound_Aggregate& aggregate : bound_aggregates) {
+                        // Min and Max start from the first value, and others start from zero
+                        if (aggregate.operation == Reduction::Min || aggregate.operation == Reduction::Max) memcpy(state + aggregate.state_offset, row + aggregate.input_offset, aggregate.input_size);
+                        else aggregate.update(state + aggregate.state_offset, row + aggregate.input_offset);
+                    }
+                }
+            }
+        }
+        /* Merge groups of `from` into `into`, where new groups are appended in order */
+        void merge(Partial& into, const Partial& from) const {
+            const char* states = static_cast<const char*>(from.states->get_data());
+            size_t stride = from.states->get_Stride();
+            for (size_t group = 0; group < from.states->get_Size(); ++group) {
+                const char* other = states + stride * group;
+                size_t slot = probe(into, state_hasher, other, from.hashes[group]);
+                if (into.slots[slot].group == Record_Hash_Table::npos) {
+                    memcpy(insert(into, slot, from.hashes[group]), other, stride);
+                    continue;
+                }
+                char* state = static_cast<char*>(into.states->get_data()) + stride * into.slots[slot].group;
+                for (const Bound_Aggregate& aggregate : bound_aggregates) aggregate.merge(state + aggregate.state_offset, other + aggregate.state_offset);
+            }
+        }
+    public:
+        Group_By(const Type* type, const std::vector<std::string>& _keys, const std::vector<Aggregate>& _aggregates):Group_By(type->get_Schema(), _keys, _aggregates) {}
+        Group_By(const std::shared_ptr<const Schema>& _schema, const std::vector<std::string>& _keys, const std::vector<Aggregate>& _aggregates)
+            :schema(_schema), keys(_keys), aggregates(_aggregates),
+            state_schema(make_schema(_schema, _keys, _aggregates, true, _schema->get_name() + "_state")),
+            output_schema(make_schema(_schema, _keys, _aggregates, false, _schema->get_name() + "_group")),
+            input_hasher(_schema, _keys), state_hasher(state_schema, key_names(_keys)) {
+            if (keys.empty()) throw std::invalid_argument(("Value Error: Cannot group rows of type '" + schema->get_name() + "' without keys").c_str());
+            for (size_t pos = 0; pos < keys.size(); ++pos) {
+                Field_Path path = schema->compile_path(keys[pos]);
+                bound_keys.push_back({ path.get_Offset(), state_schema->get_Field_Offset(pos), _size_of_primitive(path.get_Type()) });
+            }
+            for (const Aggregate& aggregate : aggregates) {
+                Bound_Aggregate bound = { aggregate.operation, 0, 0, state_schema->get_Field_Offset(state_schema->find(aggregate.name.data(), aggregate.name.length())), nullptr, nullptr };
+                Primitive_Data_Types type = Primitive_Data_Types::Unsigned_Int_64;
+                if (aggregate.operation == Reduction::Count) {
+                    _aggregate_kernels<uint64_t>(aggregate.operation, bound.update, bound.merge, type);
+                } else {
+                    Field_Path path = schema->compile_path(aggregate.path);
+                    bound.input_offset = path.get_Offset();
+                    bound.input_size = _size_of_primitive(path.get_Type());
+                    _aggregate_kernels(aggregate.operation, path.get_Type(), bound.update, bound.merge, type);
+                }
+                bound_aggregates.push_back(bound);
+                if (aggregate.operation == Reduction::Mean) {
+                    means.push_back(std::make_pair(output_schema->get_Field_Offset(output_schema->find(aggregate.name.data(), aggregate.name.length())), bound.state_offset));
+                }
+            }
+        }
+        const std::shared_ptr<const Schema>& get_Schema() const { return schema; }
+        /* Get the Struct of states of groups, where Mean keeps a sum and a count */
+        const std::shared_ptr<const Schema>& get_State_Schema() const { return state_schema; }
+        /* Get the Struct of output rows, which could be held by `Struct_Type` */
+        const std::shared_ptr<const Schema>& get_Output_Schema() const { return output_schema; }
+
+        /**
+         * Group `rows` rows from `data` without checking, whose rows are `stride` bytes apart
+         * \param threads number of threads grouping parts of rows, where 0 means every core
+         */
+        std::unique_ptr<Record_Batch> run(const void* data, size_t stride, size_t rows, size_t threads = 0) const {
+            const char* _data = static_cast<const char*>(data);
+            size_t parts = _count_parts(rows, threads, AGGREGATE_PARALLEL_ROWS);
+            std::vector<Partial> partials(parts);
+            _run_parts(parts, [&](size_t part) {
+                group(partials[part], _data, stride, rows * part / parts, rows * (part + 1) / parts);
+            });
+            for (size_t part = 1; part < parts; ++part) merge(partials[0], partials[part]);
+            const Record_Batch& states = *partials[0].states;
+            std::unique_ptr<Record_Batch> output(new Record_Batch(output_schema, states.get_Size()));
+            output->resize(states.get_Size());
+            Copy_Plan(state_schema, output_schema).apply(states.get_data(), states.get_Stride(), output->get_data(), output->get_Stride(), states.get_Size());
+            for (const std::pair<size_t, size_t>& mean : means) {
+                for (size_t group = 0; group < states.get_Size(); ++group) {
+                    const char* state = static_cast<const char*>(states.get_data()) + states.get_Stride() * group + mean.second;
+                    double sum;
+                    uint64_t count;
+                    memcpy(&sum, state, sizeof(sum));
+                    memcpy(&count, state + sizeof(sum), sizeof(count));
+                    sum /= count;
+                    memcpy(static_cast<char*>(output->get_data()) + output->get_Stride() * group + mean.first, &sum, sizeof(sum));
+                }
+            }
+            return output;
+        }
+        std::unique_ptr<Record_Batch> run(const Record_Batch& rows, size_t threads = 0) const {
+            if (rows.get_Schema() != schema) {
+                throw std::invalid_argument(("Value Error: Cannot group rows of type '" + rows.get_Schema()->get_name() + "' by keys of type '" + schema->get_name() + "'").c_str());
+            }
+            return run(rows.get_data(), rows.get_Stride(), rows.get_Size(), threads);
+        }
+    };
 };
 
 #endif
\ No newline at end of file
@@ -1,7 +1,21 @@
+#define DYNAMIC_STRUCT_INSTRUMENTATION
 #include "dynamic_struct.h"
+#include <sstream>
+#include <fstream>
+#include <cstdio>
+#include <thread>
 
 using namespace dynamic_struct;
 
+/* Number of failed checks, which makes `main` exit with failure */
+size_t failures = 0;
+#define CHECK(condition) do {\
+        if (!(condition)) {\
+            ++failures;\
+            std::cerr << "Check failed at line " << __LINE__ << ": " << #condition << std::endl;\
+        }\
+    } while (false)
+
 void test_1() {
     std::string data_type;
     std::cin >> data_type;
@@ -94,6 +108,1099 @@ void test_5() {
     std::cout << Deserialize(Serialize(&type))->type() << std::endl;
 }
 
-int main() {
-    test_1();
+void test_6() {
+    Struct_Type sub_struct({
+        Int_8("x"),
+        Int_8("y")
+    }, "sub_struct");
+    Struct_Type type({
+        Array(8, Float_32(), "var"),
+        &sub_struct
+    }, "type");
+    type.init();
+
+    Field_Path var = type.compile_path("var[3]");
+    Field_Path y = type.compile_path("sub_struct.y");
+    var.set(type.get_data(), 1.5f);
+    y.set(type.get_data(), static_cast<int8_t>(-7));
+
+    std::cout << var.get_Offset() << " " << type["var"][3]->string() << std::endl;
+    std::cout << y.get_Offset() << " " << type["sub_struct"]["y"] << std::endl;
+
+    // 2^64 + 1 must not wrap around to a valid position
+    try {
+        type.compile_path("var[18446744073709551617]");
+    } catch (std::out_of_range& e) {
+        std::cout << e.what() << std::endl;
+    }
+}
+
+void test_7() {
+    Struct_Type type({
+        Tensor(4, 3, 2, Int_32(), "tensor"),
+        Boolean("flag")
+    }, "type");
+    type.init();
+
+    Type_View tensor = type.view()["tensor"];
+    for (size_t i = 0; i < tensor.get_Size(); ++i)
+        for (size_t j = 0; j < tensor[i].get_Size(); ++j)
+            for (size_t k = 0; k < tensor[i][j].get_Size(); ++k)
+                tensor[i][j][k].set(static_cast<int32_t>(i * 100 + j * 10 + k));
+    type.view()["flag"].set(true);
+
+    std::cout << tensor[3][2][1] << " " << *type["tensor"][1]->at(2)->at(0)->get_Int_32() << " " << type["flag"] << std::endl;
+}
+
+void test_8() {
+    Struct_Type point({
+        Int_32("x"),
+        Int_32("y")
+    }, "point");
+    Record_Batch batch(&point);
+
+    for (int32_t index = 0; index < 100; ++index) {
+        Type_View row = batch.append();
+        row["x"].set(index);
+        row["y"].set(index * index);
+    }
+    point.init();
+    point["x"].set(static_cast<int32_t>(-1));
+    batch.append(point.get_data());
+
+    batch.hold(point, 42);
+    std::cout << batch.get_Size() << " " << point["y"] << " " << batch[100]["x"] << std::endl;
+
+    // A row of the batch itself is copied even when appending grows the buffer
+    Record_Batch full(&point, 8);
+    for (int32_t index = 0; index < 8; ++index) full.append()["y"].set(index + 10);
+    full.append(full[0].get_data());
+    std::cout << full.get_Capacity() << " " << full[8]["y"] << std::endl;
+    try {
+        full.reserve(std::numeric_limits<size_t>::max() / 2);
+    } catch (std::overflow_error& e) {
+        std::cout << e.what() << std::endl;
+    }
+}
+
+void test_9() {
+    Struct_Type point({
+        Int_32("x"),
+        Float_64("y")
+    }, "point");
+    Struct_Type type({
+        Struct_Clone(point, "point"),
+        Array(3, Char(), "tag")
+    }, "type");
+    Record_Batch rows(&type);
+    for (int32_t index = 0; index < 10; ++index) {
+        Type_View row = rows.append();
+        row["point"]["x"].set(index);
+        row["point"]["y"].set(index * 0.5);
+        row["tag"][index % 3].set('a');
+    }
+
+    Column_Batch columns(rows);
+    for (size_t column = 0; column < columns.get_Column_Count(); ++column) std::cout << columns.get_Column_Name(column) << " ";
+    std::cout << std::endl;
+
+    int32_t* x = static_cast<int32_t*>(columns.get_Column("point.x"));
+    int32_t sum = 0;
+    for (size_t row = 0; row < columns.get_Size(); ++row) sum += x[row];
+    columns[4]["point"]["y"].set(-1.0);
+
+    Record_Batch converted(&type);
+    columns.export_rows(converted);
+    std::cout << sum << " " << columns[7]["point"]["y"] << " " << converted[4]["point"]["y"] << " " << converted[5]["tag"][2] << std::endl;
+}
+
+void test_10() {
+    Array_Type array(1000, Int_32(), "array");
+    array.init();
+    Type_View view = array.view();
+    for (int32_t index = 0; index < 1000; ++index) view[index].set(index % 7 - 3);
+
+    std::cout << reduce(Reduction::Sum, array).int_value << " "
+              << reduce(Reduction::Min, array).int_value << " "
+              << reduce(Reduction::Max, array).int_value << " "
+              << reduce(Reduction::Mean, array).float_value << " "
+              << reduce(Reduction::Count_Nonzero, array, Instruction_Set::Scalar).unsigned_value << std::endl;
+}
+
+void test_11() {
+    Struct_Type point({
+        Int_32("x"),
+        Float_64("y"),
+        Boolean("visible")
+    }, "point");
+    point.init();
+    point["x"].set(static_cast<int32_t>(7));
+    point["y"].set(2.5);
+    point["visible"].set(true);
+
+    std::stringstream instance;
+    Save(instance, &point);
+    std::unique_ptr<Type> loaded = Load(instance);
+    std::cout << loaded->type() << " " << loaded->get("x") << " " << loaded->get("y") << " " << loaded->get("visible") << std::endl;
+
+    Record_Batch batch(&point);
+    for (int32_t index = 0; index < 5; ++index) batch.append()["x"].set(index * 10);
+    std::stringstream rows;
+    Save(rows, batch);
+    std::unique_ptr<Record_Batch> loaded_batch = Load_Batch(rows);
+    std::cout << loaded_batch->get_Size() << " " << loaded_batch->at(3)["x"] << std::endl;
+
+    // Corrupt the Boolean of the last row
+    std::string bytes = rows.str();
+    bytes[bytes.length() - 1] = 2;
+    std::stringstream corrupted(bytes);
+    try {
+        Load_Batch(corrupted);
+    } catch (std::invalid_argument& e) {
+        std::cout << e.what() << std::endl;
+    }
+}
+
+void test_12() {
+    Struct_Type point({
+        Int_32("x"),
+        Float_64("y")
+    }, "point");
+    {
+        Mapped_Record_File file("test_12.bin", &point);
+        for (int32_t index = 0; index < 1000; ++index) {
+            Type_View row = file.append();
+            row["x"].set(index);
+            row["y"].set(index * 0.5);
+        }
+        file.flush();
+    }
+
+    Mapped_Record_File file("test_12.bin");
+    file.check_Schema(&point);
+    std::unique_ptr<Type> row(point.clone());
+    file.hold(*row, 999);
+    std::cout << file.get_Size() << " " << file[10]["y"] << " " << row->get("x") << std::endl;
+
+    std::ifstream input("test_12.bin", std::ios::binary);
+    std::cout << Load_Batch(input)->at(500)["x"] << std::endl;
+    input.close();
+    std::remove("test_12.bin");
+
+    // A row of the file itself is copied even when appending remaps the file
+    {
+        Mapped_Record_File copies("test_12.bin", &point, 8);
+        for (int32_t index = 0; index < 8; ++index) copies.append()["x"].set(index + 10);
+        copies.append(copies[0].get_data());
+        std::cout << copies.get_Capacity() << " " << copies[8]["x"] << std::endl;
+    }
+    std::remove("test_12.bin");
+}
+
+void test_13() {
+    Struct_Type point({
+        Int_8("x"),
+        Float_64("y"),
+        Char("tag")
+    }, "point");
+    Record_Batch batch(&point);
+    Text_Loader loader(&point, ',', true);
+    std::string text = "x,y,tag\n1,0.5,a\n200,1.5,b\n3,-2.5e1,\",\"\n4,abc\n5,6,c,7\n";
+
+    std::cout << loader.load(text, batch) << " " << batch[1]["y"] << " " << batch[1]["tag"] << std::endl;
+    for (const Parse_Error& error : loader.get_Errors()) std::cout << loader.get_Error_Message(error) << std::endl;
+}
+
+void test_14() {
+    Struct_Type point({
+        Int_32("x"),
+        Float_32("y"),
+        Char("tag")
+    }, "point");
+    Record_Batch batch(&point);
+    for (int32_t index = 0; index < 3; ++index) {
+        Type_View row = batch.append();
+        row["x"].set(-index);
+        row["y"].set(index * 0.25f);
+        row["tag"].set(index == 1 ? ',' : 'a');
+    }
+
+    Text_Writer writer(&point, ',', true);
+    writer.write(batch);
+    std::cout << writer.get_Text();
+
+    Array_Type array(4, Int_64(), "array");
+    array.init();
+    array[3]->set(static_cast<int64_t>(-9));
+    Text_Writer elements(&array.get_Element_Type(), ' ');
+    elements.write_elements(&array);
+    std::cout << elements.get_Text();
+
+    Text_Writer row(&array, ' ');
+    row.write(&array);
+    std::cout << row.get_Text();
+}
+
+void test_15() {
+    Struct_Type packed({
+        Char("tag"),
+        Int_64("id"),
+        Int_16("count")
+    }, "record");
+    std::unique_ptr<Struct_Type> aligned(packed.clone());
+    aligned->set_Layout_Policy(Layout_Policy::Aligned);
+    std::unique_ptr<Struct_Type> compact(packed.clone());
+    compact->set_Layout_Policy(Layout_Policy::Compact);
+
+    for (Struct_Type* type : { &packed, aligned.get(), compact.get() }) {
+        std::cout << type->size_of() << " " << type->alignment_of();
+        for (std::string key : type->get_Keys()) std::cout << " " << key << "@" << type->get_Offset(key);
+        std::cout << " " << Serialize(type) << std::endl;
+    }
+    std::unique_ptr<Type> deserialized = Deserialize(Serialize(compact.get()));
+    std::cout << deserialized->get_Offset("count") << " " << Array(4, compact.get(), "array")->size_of() << std::endl;
+}
+
+void test_16() {
+    Struct_Type point({
+        Int_32("x"),
+        Int_32("y")
+    }, "point");
+    std::unique_ptr<Struct_Type> copy(point.clone());
+    Struct_Type same({
+        Int_32("x"),
+        Int_32("y")
+    }, "point");
+    // Clones and structurally equal types share the same schema
+    std::cout << (copy->get_Schema() == point.get_Schema()) << " " << (same.get_Schema() == point.get_Schema()) << std::endl;
+
+    copy->init();
+    (*copy)["y"].set(int32_t(7));
+    (*copy)["y"].set_name("z");
+    std::cout << (copy->get_Schema() == point.get_Schema()) << " " << copy->get_Offset("z") << " " << (*copy)["z"] << std::endl;
+
+    Struct_Type shape({
+        Struct_Clone(point, "center"),
+        Array(2, &point, "corners")
+    }, "shape");
+    shape["center"].append(Int_32("z"));
+    shape["corners"].get_Element_Type().append(Int_32("z"));
+    std::cout << shape.size_of() << " " << shape.get_Offset("corners") << " " << Serialize(&shape) << std::endl;
+    std::cout << point.type() << std::endl;
+}
+
+void test_17() {
+    std::string descriptor = "{shape:aligned,(tag,Char),[corners,2,{point,(x,Int_32),(y,Int_32)}],{empty}}";
+    std::shared_ptr<const Schema> schema = Deserialize_Schema(descriptor);
+    std::cout << (Serialize(*schema) == descriptor) << " " << schema->size_of() << " " << (Deserialize(descriptor)->get_Schema() == schema) << std::endl;
+
+    const char* corrupted[] = { "{shape,(tag,Char)", "[corners,x,(x,Int_32)]", "(x,Int_128)", "{shape,(x,Int_8),(x,Int_8)}", "(x,Int_8))" };
+    for (const char* src : corrupted) {
+        try {
+            Deserialize(src);
+        } catch (const std::invalid_argument& e) {
+            std::cout << e.what() << std::endl;
+        }
+    }
+}
+
+void test_18() {
+    std::string text = "{shape:compact,(tag,Char),[corners,4,{point,(x,Int_32),(y,Int_32)}],{empty},[matrix,2,[,3,(,Float_64)]]}";
+    std::string binary = text_to_binary_descriptor(text);
+    std::cout << text.length() << " " << binary.length() << " " << (binary_to_text_descriptor(binary) == text) << " " << (Deserialize_Binary(binary) == Deserialize_Schema(text)) << std::endl;
+
+    std::string corrupted[] = { binary.substr(0, binary.length() - 1), binary + '\0', std::string(1, '\2') + binary.substr(1) };
+    for (const std::string& src : corrupted) {
+        try {
+            Deserialize_Binary(src);
+        } catch (const std::invalid_argument& e) {
+            std::cout << e.what() << std::endl;
+        }
+    }
+}
+
+void test_19() {
+    std::vector<std::unique_ptr<Primitive_Type>> properties;
+    std::vector<Type*> types;
+    for (size_t index = 0; index < 300; ++index) {
+        properties.push_back(_Int_16("field_" + std::to_string(index)));
+        types.push_back(properties.back().get());
+    }
+    Struct_Type wide(types, "wide");
+    const Schema& schema = *wide.get_Schema();
+    const char* path = "field_123.x";
+    std::cout << schema.find("field_0") << " " << schema.find(path, 9) << " " << (schema.find("field_300") == Schema::npos) << " " << wide.get_Offset("field_299") << std::endl;
+
+    try {
+        wide.append(Int_8("field_42"));
+    } catch (const std::invalid_argument& e) {
+        std::cout << e.what() << std::endl;
+    }
+}
+
+struct Native_Order {
+    int64_t id;
+    int32_t quantity;
+    float price[2];
+    struct {
+        char code;
+        bool paid;
+    } status;
+};
+
+void test_20() {
+    Struct_Type status({
+        Char("code"),
+        Boolean("paid")
+    }, "status");
+    Struct_Type order({
+        Int_64("id"),
+        Int_32("quantity"),
+        Array(2, Float_32(), "price"),
+        Struct_Clone(status, "status")
+    }, "order", Layout_Policy::Aligned);
+    Native_Binding<Native_Order> binding(&order, {
+        NATIVE_FIELD(Native_Order, id),
+        NATIVE_FIELD(Native_Order, quantity),
+        NATIVE_FIELD(Native_Order, price),
+        NATIVE_FIELD(Native_Order, status.code),
+        NATIVE_FIELD(Native_Order, status.paid)
+    });
+
+    Record_Batch batch(&order);
+    for (int64_t index = 0; index < 4; ++index) batch.append()["id"].set(index * 100);
+    Native_Order* rows = binding.rows(batch);
+    for (size_t row = 0; row < batch.get_Size(); ++row) rows[row].price[1] = row * 0.5f;
+    binding(batch, 2).status.code = 'x';
+    std::cout << rows[3].id << " " << batch[3]["price"][1] << " " << batch[2]["status"]["code"] << std::endl;
+
+    order.init();
+    binding.get(order).quantity = 7;
+    std::cout << order["quantity"] << std::endl;
+
+    std::unique_ptr<Struct_Type> packed(order.clone());
+    packed->set_Layout_Policy(Layout_Policy::Packed);
+    try {
+        Native_Binding<Native_Order> mismatched(packed.get(), { NATIVE_FIELD(Native_Order, id) });
+    } catch (const std::invalid_argument& e) {
+        std::cout << e.what() << std::endl;
+    }
+    try {
+        Native_Binding<Native_Order> missing(&order, { NATIVE_FIELD(Native_Order, id), NATIVE_FIELD(Native_Order, price) });
+    } catch (const std::invalid_argument& e) {
+        std::cout << e.what() << std::endl;
+    }
+}
+
+void test_21() {
+    reset_instrumentation();
+    Struct_Type sample({
+        Int_32("id"),
+        Array(3, Float_64(), "values")
+    }, "sample");
+    sample.init();
+    sample["id"].set(std::string("42"));
+    for (size_t index = 0; index < 3; ++index) (*sample["values"][index]).set(index * 1.5);
+    try {
+        sample["id"].set(1.0);
+    } catch (const std::invalid_argument& e) {}
+    try {
+        sample["id"].set(std::string("forty-two"));
+    } catch (const std::invalid_argument& e) {}
+    std::unique_ptr<Struct_Type> copy(sample.clone());
+
+    std::thread worker([]() {
+        Primitive_Type counter(Primitive_Data_Types::Int_64, "counter");
+        counter.init();
+        for (int index = 0; index < 10; ++index) counter.set(std::to_string(index));
+    });
+    worker.join();
+
+    Instrumentation_Snapshot snapshot = instrumentation_snapshot();
+    std::cout << snapshot["sample"][Counter::Key_Lookups] << " " << snapshot["sample"][Counter::Element_Views] << " " << snapshot["counter"][Counter::Parses] << std::endl;
+    std::cout << instrumentation_report(snapshot);
+
+    reset_instrumentation();
+    std::cout << instrumentation_snapshot()["sample"][Counter::Exceptions] << std::endl;
+}
+
+void test_22() {
+    Struct_Type reading({
+        Int_8("level"),
+        Float_64("value"),
+        Boolean("valid")
+    }, "reading");
+    std::cout << get_string_from_status(reading["level"].try_set(int8_t(1))) << std::endl;
+    reading.init();
+
+    const char* inputs[] = { "12", "300", "1x", "", "-128" };
+    for (const char* input : inputs) {
+        Status status = reading["level"].try_parse(input);
+        std::cout << get_string_from_status(status) << " " << reading["level"] << std::endl;
+    }
+    std::cout << get_string_from_status(reading["value"].try_set(3)) << " " << get_string_from_status(reading["value"].try_set(2.5)) << std::endl;
+    std::cout << get_string_from_status(reading.try_parse("1")) << " " << get_string_from_status(reading["valid"].try_parse(std::string("true"))) << std::endl;
+
+    double value = 0;
+    bool valid = false;
+    int32_t wrong = 0;
+    std::cout << get_string_from_status(reading["value"].try_get(value)) << " " << value << " " << get_string_from_status(reading["valid"].try_get(valid)) << " " << valid << std::endl;
+    std::cout << get_string_from_status(reading["value"].try_get(wrong)) << " " << wrong << std::endl;
+
+    try {
+        reading["level"].set(std::string("300"));
+    } catch (const std::out_of_range& e) {
+        std::cout << e.what() << std::endl;
+    }
+    try {
+        reading["valid"].set(std::string("yes"));
+    } catch (const std::invalid_argument& e) {
+        std::cout << e.what() << std::endl;
+    }
+}
+
+void test_23() {
+    Struct_Type trade({
+        Int_64("id"),
+        Float_64("price"),
+        Int_32("quantity")
+    }, "trade");
+    std::shared_ptr<const Schema> schema = trade.freeze();
+    try {
+        trade["price"].set_name("cost");
+    } catch (const std::invalid_argument& e) {
+        std::cout << e.what() << std::endl;
+    }
+
+    const size_t rows = 100000, threads = 8;
+    Record_Batch batch(schema, rows);
+    batch.resize(rows);
+    Field_Path id = trade.compile_path("id"), price = trade.compile_path("price");
+
+    // Writers fill disjoint partitions, half through paths and half through views
+    std::vector<std::thread> workers;
+    for (size_t part = 0; part < threads; ++part) {
+        workers.emplace_back([&, part]() {
+            for (Cursor cursor = Cursor(batch).partition(part, threads); cursor.valid(); cursor.next()) {
+                id.set(cursor.get_data(), static_cast<int64_t>(cursor.get_Row()));
+                price.set(cursor.get_data(), cursor.get_Row() * 0.5);
+                cursor["quantity"].set(static_cast<int32_t>(part));
+            }
+        });
+    }
+    for (std::thread& worker : workers) worker.join();
+    workers.clear();
+
+    // Readers scan every row at the same time
+    std::vector<int64_t> sums(threads);
+    std::vector<double> totals(threads);
+    for (size_t reader = 0; reader < threads; ++reader) {
+        workers.emplace_back([&, reader]() {
+            for (Cursor cursor(batch); cursor.valid(); cursor.next()) {
+                // Fields of the packed row are read by bytes, since they might not be aligned
+                int64_t value;
+                int32_t quantity;
+                double amount;
+                memcpy(&value, id.locate(cursor.get_data()), sizeof(value));
+                memcpy(&quantity, cursor["quantity"].get_data(), sizeof(quantity));
+                memcpy(&amount, price.locate(cursor.get_data()), sizeof(amount));
+                sums[reader] += value + quantity;
+                totals[reader] += amount;
+            }
+        });
+    }
+    for (std::thread& worker : workers) worker.join();
+    bool same = true;
+    for (size_t reader = 1; reader < threads; ++reader) same = same && sums[reader] == sums[0] && totals[reader] == totals[0];
+    std::cout << sums[0] << " " << totals[0] << " " << same << std::endl;
+
+    Cursor cursor = Cursor(batch).partition(7, threads);
+    std::cout << cursor.get_Begin() << " " << cursor.get_End() << " " << cursor["quantity"] << std::endl;
+    try {
+        cursor.seek(rows + 1);
+    } catch (const std::out_of_range& e) {
+        std::cout << e.what() << std::endl;
+    }
+}
+
+void test_24() {
+    Struct_Type item({
+        Int_32("id"),
+        Float_64("price"),
+        Boolean("active"),
+        Char("region"),
+        Array(2, Int_16(), "stock")
+    }, "item");
+    Record_Batch rows(&item);
+    const size_t count = 200000;
+    for (size_t index = 0; index < count; ++index) {
+        Type_View row = rows.append();
+        row["id"].set(static_cast<int32_t>(index));
+        row["price"].set((index % 100) * 0.25);
+        row["active"].set(index % 3 != 0);
+        row["region"].set("NESW"[index % 4]);
+        row["stock"][1].set(static_cast<int16_t>(index % 7));
+    }
+    Column_Batch columns(rows);
+
+    Predicate predicate(&item, "price > 10.5 && active == true && region == 'E'");
+    std::vector<size_t> selection = predicate.select(rows, 1);
+    std::vector<size_t> parallel = predicate.select(rows, 4);
+    std::vector<size_t> columnar = predicate.select(columns, 3);
+    size_t expected = 0;
+    bool ordered = true;
+    for (size_t index = 0; index < count; ++index) {
+        bool match = (index % 100) * 0.25 > 10.5 && index % 3 != 0 && index % 4 == 1;
+        if (match && (expected >= selection.size() || selection[expected] != index)) ordered = false;
+        expected += match;
+    }
+    std::cout << selection.size() << " " << expected << " " << ordered << " " << (parallel == selection) << " " << (columnar == selection) << std::endl;
+    CHECK(selection.size() == expected && ordered);
+    CHECK(parallel == selection);
+    CHECK(columnar == selection);
+
+    std::vector<uint64_t> bits = predicate.bitmap(rows, 4);
+    std::vector<uint64_t> column_bits = predicate.bitmap(columns, 2);
+    size_t population = 0;
+    for (uint64_t word : bits) for (; word != 0; word &= word - 1) ++population;
+    std::cout << bits.size() << " " << population << " " << (bits == column_bits) << " " << ((bits[selection[0] / 64] >> (selection[0] % 64)) & 1) << std::endl;
+    // The bitmap sets exactly the selected rows
+    bool selected_bits = bits.size() == (count + 63) / 64;
+    for (size_t row : selection) selected_bits = selected_bits && ((bits[row / 64] >> (row % 64)) & 1) != 0;
+    CHECK(selected_bits && population == selection.size());
+    CHECK(bits == column_bits);
+
+    Predicate nested(&item, "!(active || stock[1] >= 5) || (id < 3 && region != 'N')");
+    std::vector<size_t> few = nested.select(rows);
+    std::cout << few.size() << " " << few[0] << " " << few[1] << " " << few[2] << " " << nested(rows[few[2]]) << " " << nested(rows[4]) << std::endl;
+    Predicate flag(&item, "active");
+    std::cout << flag.select(columns).size() << std::endl;
+
+    const char* malformed[] = { "price > ", "price >> 1", "active && (id < 3", "id < 3.5", "region == 'E", "price 3", "missing == 1" };
+    for (const char* expression : malformed) {
+        try {
+            Predicate wrong(&item, expression);
+        } catch (const std::invalid_argument& e) {
+            std::cout << e.what() << std::endl;
+        }
+    }
+}
+
+void test_25() {
+    Struct_Type point({
+        Int_32("x"),
+        Int_32("y")
+    }, "point");
+    Struct_Type version_1({
+        Int_32("id"),
+        Int_16("qty"),
+        Float_32("price"),
+        Struct_Clone(point, "point"),
+        Char("grade")
+    }, "order");
+    Struct_Type version_2({
+        Int_64("id"),
+        Struct_Clone(point, "position"),
+        Int_32("qty"),
+        Float_64("price"),
+        Char("grade"),
+        Boolean("paid"),
+        Array(2, Int_16(), "tags")
+    }, "order", Layout_Policy::Aligned);
+
+    Copy_Plan plan(&version_1, &version_2, { { "position", "point" } });
+    std::cout << plan.string();
+    Record_Batch old_rows(&version_1);
+    for (int32_t index = 0; index < 1000; ++index) {
+        Type_View row = old_rows.append();
+        row["id"].set(index - 500);
+        row["qty"].set(static_cast<int16_t>(-index));
+        row["price"].set(index * 0.5f);
+        row["point"]["x"].set(index * 2);
+        row["point"]["y"].set(index * 3);
+        row["grade"].set("ABC"[index % 3]);
+    }
+    Record_Batch new_rows(&version_2);
+    new_rows.append();
+    new_rows[0]["paid"].set(true);
+    plan.apply(old_rows, new_rows);
+    Type_View last = new_rows[999];
+    std::cout << new_rows.get_Size() << " " << last["id"].string() << " " << last["position"]["x"].string() << " " << last["position"]["y"].string() << " " << last["qty"].string() << " " <<
+        last["price"].string() << " " << last["grade"].string() << std::endl;
+    std::cout << new_rows[0]["id"].string() << " " << new_rows[0]["paid"].string() << " " << new_rows[0]["tags"][1].string() << std::endl;
+
+    version_1.init();
+    version_2.init();
+    version_1["id"].set(7);
+    version_1["price"].set(1.25f);
+    plan.apply(version_1, version_2);
+    std::cout << version_2["id"].string() << " " << version_2["price"].string() << std::endl;
+
+    // Appending a field keeps the old fields in one run
+    Struct_Type version_3({
+        Int_32("id"),
+        Int_16("qty"),
+        Float_32("price"),
+        Struct_Clone(point, "point"),
+        Char("grade"),
+        Int_64("total")
+    }, "order");
+    std::cout << Copy_Plan(&version_1, &version_3).string() << Copy_Plan(&version_1, &version_1).is_Identity() << std::endl;
+
+    try {
+        Copy_Plan narrowing(&version_2, &version_1);
+    } catch (std::invalid_argument& e) {
+        std::cout << e.what() << std::endl;
+    }
+    try {
+        Copy_Plan missing(&version_1, &version_2, { { "position.x", "origin.x" } });
+    } catch (std::invalid_argument& e) {
+        std::cout << e.what() << std::endl;
+    }
+    try {
+        plan.apply(new_rows, old_rows);
+    } catch (std::invalid_argument& e) {
+        std::cout << e.what() << std::endl;
+    }
+}
+
+void test_26() {
+    Struct_Type reading({
+        Char("unit"),
+        Float_64("value"),
+        Int_32("sensor")
+    }, "reading", Layout_Policy::Aligned);
+    Record_Batch rows(&reading);
+    Type_View a = rows.append(), b = rows.append();
+    // Padding of `b` holds garbage, which should not change its hash
+    memset(b.get_data(), 0x5a, reading.size_of());
+    a["unit"].set('C');
+    b["unit"].set('C');
+    a["value"].set(0.0);
+    b["value"].set(-0.0);
+    a["sensor"].set(7);
+    b["sensor"].set(7);
+    Record_Hasher hasher(&reading);
+    std::cout << hasher.get_Segment_Count() << " " << hasher.get_Width() << " " << hasher.equal(rows[0], rows[1]) << " " << (hasher(rows[0]) == hasher(rows[1])) << std::endl;
+    a["value"].set(std::nan(""));
+    b["value"].set(-std::nan("1"));
+    std::cout << hasher.equal(rows[0], rows[1]) << " " << (hasher(rows[0]) == hasher(rows[1])) << std::endl;
+    b["sensor"].set(8);
+    Record_Hasher by_value(&reading, { "unit", "value" });
+    std::cout << hasher.equal(rows[0], rows[1]) << " " << by_value.equal(rows[0], rows[1]) << " " << (by_value(rows[0]) == by_value(rows[1])) << std::endl;
+
+    // The same keys hash the same in another layout
+    Struct_Type packed({
+        Int_32("sensor"),
+        Char("unit")
+    }, "packed");
+    packed.init();
+    packed["sensor"].set(8);
+    packed["unit"].set('C');
+    Record_Hasher packed_hasher(&packed);
+    Record_Hasher swapped(&reading, { "sensor", "unit" });
+    std::cout << packed_hasher.get_Segment_Count() << " " << swapped.get_Segment_Count() << " " << (packed_hasher(packed.view()) == swapped(rows[1])) << " " << swapped.equal(rows[1].get_data(), packed_hasher, packed.get_data()) << std::endl;
+
+    Struct_Type event({
+        Int_64("user"),
+        Array(2, Int_16(), "tags"),
+        Float_32("score")
+    }, "event");
+    Record_Batch events(&event);
+    for (int64_t index = 0; index < 1000; ++index) {
+        Type_View row = events.append();
+        row["user"].set(index % 97);
+        row["tags"][1].set(static_cast<int16_t>(index % 2));
+        row["score"].set(index % 2 == 0 ? 0.0f : -0.0f);
+    }
+    std::vector<size_t> users = distinct(events, { "user" });
+    std::vector<size_t> pairs = distinct(events, { "user", "tags" });
+    std::vector<size_t> whole = distinct(events);
+    std::cout << users.size() << " " << users[96] << " " << pairs.size() << " " << whole.size() << " " << pairs[1] << std::endl;
+
+    Record_Hash_Table table(&event, { "user" });
+    for (size_t row = 0; row < events.get_Size(); ++row) {
+        std::pair<size_t&, bool> inserted = table.insert(events[row], 1);
+        if (!inserted.second) ++inserted.first;
+    }
+    Type_View probe = events[3];
+    std::cout << table.get_Size() << " " << table.find(probe) << " " << table.find(events[96]) << std::endl;
+
+    Struct_Type user({
+        Int_32("age"),
+        Int_64("id")
+    }, "user");
+    Record_Batch users_rows(&user);
+    for (int64_t id : { 3, 5, 3, 11 }) {
+        Type_View row = users_rows.append();
+        row["id"].set(id);
+        row["age"].set(static_cast<int32_t>(id * 10));
+    }
+    std::vector<std::pair<size_t, size_t>> matches = hash_join(users_rows, { "id" }, events, { "user" });
+    std::cout << matches.size() << " (" << matches[0].first << "," << matches[0].second << ") (" << matches[1].first << "," << matches[1].second << ") (" << matches[2].first << "," << matches[2].second << ")" << std::endl;
+    // Build rows of a duplicated key are chained, and each of them matches in order
+    users_rows.append()["id"].set(static_cast<int64_t>(3));
+    matches = hash_join(users_rows, { "id" }, events, { "user" });
+    for (const std::pair<size_t, size_t>& match : matches) {
+        if (match.second == 3) std::cout << match.first << " ";
+    }
+    std::cout << std::endl;
+    // A nested loop finds the same pairs, in the order of probe rows and then of build rows
+    std::vector<std::pair<size_t, size_t>> nested;
+    for (size_t probe_row = 0; probe_row < events.get_Size(); ++probe_row) {
+        for (size_t build_row = 0; build_row < users_rows.get_Size(); ++build_row) {
+            if (users_rows[build_row]["id"].string() == events[probe_row]["user"].string()) nested.push_back(std::make_pair(build_row, probe_row));
+        }
+    }
+    CHECK(matches == nested);
+
+    try {
+        Record_Hasher missing(&event, { "tag" });
+    } catch (std::invalid_argument& e) {
+        std::cout << e.what() << std::endl;
+    }
+    try {
+        hash_join(users_rows, { "age" }, events, { "user" });
+    } catch (std::invalid_argument& e) {
+        std::cout << e.what() << std::endl;
+    }
+    try {
+        hasher(events[0]);
+    } catch (std::invalid_argument& e) {
+        std::cout << e.what() << std::endl;
+    }
+}
+
+void test_27() {
+    Struct_Type trade({
+        Int_64("id"),
+        Float_64("price"),
+        Unsigned_Int_32("volume"),
+        Char("side"),
+        Int_16("delta")
+    }, "trade", Layout_Policy::Aligned);
+    Record_Batch rows(&trade);
+    const double prices[] = { 2.5, -1.0, 0.0, std::numeric_limits<double>::infinity(), -0.0, std::nan(""), -std::numeric_limits<double>::infinity(), 2.5, -3.75 };
+    for (size_t index = 0; index < 9; ++index) {
+        Type_View row = rows.append();
+        row["id"].set(static_cast<int64_t>(index));
+        row["price"].set(prices[index]);
+        row["side"].set(index % 2 == 0 ? 'B' : 'S');
+    }
+    Record_Sorter by_price(&trade, { "price" });
+    for (size_t row : by_price.order(rows)) std::cout << row << " ";
+    std::cout << std::endl;
+    Record_Sorter by_side(&trade, { "side", { "price", Sort_Order::Descending } });
+    for (size_t row : by_side.order(rows)) std::cout << row << " ";
+    std::cout << by_side.get_Width() << std::endl;
+
+    // Char is ordered as `char`, the same as in a Predicate
+    Struct_Type letter({
+        Char("c")
+    }, "letter");
+    Record_Batch letters(&letter);
+    for (char c : { 'a', static_cast<char>(0xE9), 'Z' }) letters.append()["c"].set(c);
+    Predicate before_a(&letter, "c < 'a'");
+    for (size_t row : Record_Sorter(&letter, { "c" }).order(letters)) std::cout << row << ":" << before_a(letters[row]) << " ";
+    std::cout << std::endl;
+
+    // Compare with a comparison sort over many rows, on one thread and on parts of rows
+    const size_t count = 300000;
+    rows.clear();
+    uint64_t state = 7;
+    for (size_t index = 0; index < count; ++index) {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        Type_View row = rows.append();
+        row["id"].set(static_cast<int64_t>(state >> 1) - (static_cast<int64_t>(1) << 62));
+        row["price"].set(static_cast<double>(static_cast<int64_t>(state >> 44) - 500000) / 8);
+        row["volume"].set(static_cast<uint32_t>(state >> 52));
+        row["side"].set("BS"[(state >> 20) & 1]);
+        row["delta"].set(static_cast<int16_t>((state >> 24) % 200 - 100));
+    }
+    std::vector<size_t> expected(count);
+    for (size_t index = 0; index < count; ++index) expected[index] = index;
+    std::stable_sort(expected.begin(), expected.end(), [&rows](size_t a, size_t b) {
+        Type_View x = rows[a], y = rows[b];
+        if (*x["side"].get_Char() != *y["side"].get_Char()) return *x["side"].get_Char() < *y["side"].get_Char();
+        if (*x["delta"].get_Int_16() != *y["delta"].get_Int_16()) return *x["delta"].get_Int_16() > *y["delta"].get_Int_16();
+        return *x["volume"].get_Unsigned_Int_32() < *y["volume"].get_Unsigned_Int_32();
+    });
+    Record_Sorter sorter(&trade, { "side", { "delta", Sort_Order::Descending }, "volume" });
+    std::vector<size_t> serial_order = sorter.order(rows, 1), parallel_order = sorter.order(rows, 4);
+    std::cout << (serial_order == expected) << " " << (parallel_order == expected) << std::endl;
+    CHECK(serial_order == expected);
+    CHECK(parallel_order == expected);
+
+    std::vector<int64_t> ids(count);
+    for (size_t index = 0; index < count; ++index) ids[index] = *rows[index]["id"].get_Int_64();
+    std::sort(ids.begin(), ids.end());
+    Record_Sorter(&trade, { "id" }).sort(rows, 3);
+    bool sorted = true;
+    for (size_t index = 0; index < count; ++index) sorted = sorted && *rows[index]["id"].get_Int_64() == ids[index];
+    std::cout << sorted << std::endl;
+    CHECK(sorted);
+
+    try {
+        Record_Sorter(&trade, { "side", "missing" });
+    } catch (std::invalid_argument& e) {
+        std::cout << e.what() << std::endl;
+    }
+    Struct_Type other({
+        Int_64("id")
+    }, "other");
+    Record_Batch other_rows(&other);
+    try {
+        sorter.order(other_rows);
+    } catch (std::invalid_argument& e) {
+        std::cout << e.what() << std::endl;
+    }
+}
+
+void test_28() {
+    Struct_Type sale({
+        Char("region"),
+        Int_32("product"),
+        Float_64("amount"),
+        Int_64("ts"),
+        Boolean("returned")
+    }, "sale", Layout_Policy::Aligned);
+    Record_Batch rows(&sale);
+    const char regions[] = { 'N', 'S', 'N', 'E', 'S', 'N' };
+    const int32_t products[] = { 1, 2, 1, 1, 2, 3 };
+    const double amounts[] = { 10.0, 4.5, 2.5, 7.0, 0.5, 1.0 };
+    for (size_t index = 0; index < 6; ++index) {
+        Type_View row = rows.append();
+        row["region"].set(regions[index]);
+        row["product"].set(products[index]);
+        row["amount"].set(amounts[index]);
+        row["ts"].set(static_cast<int64_t>(100 - index * 10));
+        row["returned"].set(index == 4);
+    }
+    Group_By group_by(&sale, { "region", "product" }, {
+        { Reduction::Sum, "amount" },
+        { Reduction::Count },
+        { Reduction::Max, "ts", "latest" },
+        { Reduction::Mean, "amount" },
+        { Reduction::Count_Nonzero, "returned" }
+    });
+    Struct_Type output(group_by.get_Output_Schema());
+    std::cout << output.type() << std::endl;
+    std::cout << group_by.get_State_Schema()->size_of() << " " << output.size_of() << std::endl;
+    std::unique_ptr<Record_Batch> groups = group_by.run(rows);
+    for (size_t index = 0; index < groups->get_Size(); ++index) {
+        Type_View group = (*groups)[index];
+        std::cout << group["region"].string() << " " << group["product"].string() << " " << group["sum_amount"].string() << " " << group["count"].string() << " " <<
+            group["latest"].string() << " " << group["mean_amount"].string() << " " << group["count_nonzero_returned"].string() << std::endl;
+    }
+
+    // Parts of rows grouped by threads give the same groups in the same order
+    const size_t count = 400000;
+    rows.clear();
+    uint64_t state = 3;
+    for (size_t index = 0; index < count; ++index) {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        Type_View row = rows.append();
+        row["region"].set("NSEW"[(state >> 60) & 3]);
+        row["product"].set(static_cast<int32_t>((state >> 33) % 1000));
+        row["amount"].set(static_cast<double>((state >> 20) % 100));
+        row["ts"].set(static_cast<int64_t>(index));
+    }
+    Group_By by_product(&sale, { "product" }, { { Reduction::Sum, "amount" }, { Reduction::Min, "ts", "first" }, { Reduction::Count } });
+    std::unique_ptr<Record_Batch> serial = by_product.run(rows, 1), parallel = by_product.run(rows, 4);
+    bool same = serial->get_Size() == parallel->get_Size() && memcmp(serial->get_data(), parallel->get_data(), serial->get_Stride() * serial->get_Size()) == 0;
+    uint64_t total = 0;
+    bool ordered = true;
+    for (size_t index = 0; index < serial->get_Size(); ++index) {
+        // Groups are packed, so values are read through their text rather than unaligned pointers
+        total += std::stoull((*serial)[index]["count"].string());
+        if (index > 0) ordered = ordered && std::stoll((*serial)[index]["first"].string()) > std::stoll((*serial)[index - 1]["first"].string());
+    }
+    std::cout << serial->get_Size() << " " << same << " " << total << " " << ordered << std::endl;
+    CHECK(same);
+    CHECK(total == count);
+    CHECK(ordered);
+    // Sums and counts match a std::map over the same rows, whose amounts are small integers and sum exactly
+    std::map<int32_t, std::pair<double, uint64_t>> reference;
+    for (size_t index = 0; index < count; ++index) {
+        std::pair<double, uint64_t>& group = reference[std::stoi(rows[index]["product"].string())];
+        group.first += std::stod(rows[index]["amount"].string());
+        ++group.second;
+    }
+    bool aggregated = reference.size() == serial->get_Size();
+    for (size_t index = 0; aggregated && index < serial->get_Size(); ++index) {
+        Type_View group = (*serial)[index];
+        const std::pair<double, uint64_t>& expected = reference[std::stoi(group["product"].string())];
+        aggregated = std::stod(group["sum_amount"].string()) == expected.first && std::stoull(group["count"].string()) == expected.second;
+    }
+    CHECK(aggregated);
+
+    try {
+        Group_By(&sale, { "region" }, { { Reduction::Sum, "price" } });
+    } catch (std::invalid_argument& e) {
+        std::cout << e.what() << std::endl;
+    }
+    try {
+        Group_By(&sale, { "region" }, { { Reduction::Sum, "amount", "region" } });
+    } catch (std::invalid_argument& e) {
+        std::cout << e.what() << std::endl;
+    }
+}
+
+void test_29() {
+    Struct_Type user({
+        Int_32("id"),
+        String("name"),
+        Blob("key"),
+        Boolean("admin")
+    }, "user", Layout_Policy::Aligned);
+    std::cout << user.type() << " " << user.size_of() << std::endl;
+    user.init();
+    user["id"].set(7);
+    user["name"].set(std::string("Ada"));
+    user["key"].set_bytes("\x01\xab\xff", 3);
+    std::cout << user.get("name") << " " << user["name"].get_bytes().length << " " << user.get("key") << " " << user.get_Arena()->get_Size() << std::endl;
+    user["name"].set(std::string("Ada Lovelace, Countess of Lovelace"));
+    std::cout << user.get("name") << " " << user.get_Arena()->get_Size() << std::endl;
+
+    std::cout << (Deserialize(Serialize(&user))->get_Schema() == user.get_Schema()) << " " << (Deserialize_Binary(Serialize_Binary(*user.get_Schema())) == user.get_Schema()) << std::endl;
+
+    // Long values of rows share the arena of the batch
+    Record_Batch rows(&user);
+    const char* names[] = { "Ada", "", "Grace Brewster Murray Hopper", "say \"hi\", twice", " padded " };
+    for (int32_t index = 0; index < 5; ++index) {
+        Type_View row = rows.append();
+        row["id"].set(index);
+        row["name"].set(names[index]);
+        row["key"].set(index == 2 ? "00112233445566778899aabbccddeeff" : "beef");
+    }
+    std::cout << rows[2]["name"].string() << " " << rows[2]["key"].string() << " " << rows[2]["name"].get_bytes().length << " " << rows.get_Arena().get_Size() << std::endl;
+
+    std::stringstream binary;
+    Save(binary, rows);
+    std::unique_ptr<Record_Batch> loaded = Load_Batch(binary);
+    std::cout << loaded->get_Size() << " " << (*loaded)[2]["name"].string() << " " << (*loaded)[2]["key"].string() << std::endl;
+
+    // A row of a batch keeps its values when loaded into another batch
+    std::stringstream instance;
+    Save(instance, &user);
+    Record_Batch others(&user);
+    others.append()["name"].set("Charles Babbage, inventor");
+    std::unique_ptr<Type> row(user.clone());
+    others.hold(*row, 0);
+    Load(instance, row.get());
+    std::cout << others[0]["name"].string() << " " << others[0]["key"].string() << " " << others.get_Arena().get_Size() << std::endl;
+
+    Text_Writer writer(&user, ',', true);
+    writer.write(rows);
+    std::cout << writer.get_Text();
+    Record_Batch parsed(&user);
+    Text_Loader loader(&user, ',', true);
+    std::cout << loader.load(writer.get_Text(), parsed) << " [" << parsed[4]["name"].string() << "] [" << parsed[3]["name"].string() << "] " << parsed[2]["key"].string() << std::endl;
+    parsed.clear();
+    loader.load("id,name,key,admin\n1,x,abc,false\n", parsed);
+    for (const Parse_Error& error : loader.get_Errors()) std::cout << loader.get_Error_Message(error) << std::endl;
+
+    Column_Batch columns(rows);
+    Record_Batch exported(&user);
+    columns.export_rows(exported);
+    Cursor cursor(exported);
+    cursor.seek(2);
+    std::cout << columns[3]["name"].string() << " " << cursor["name"].string() << std::endl;
+
+    // Fields are copied with their values into the arena of the destination
+    Struct_Type renamed({
+        String("full_name"),
+        Int_64("id")
+    }, "user", Layout_Policy::Aligned);
+    Copy_Plan plan(&user, &renamed, { { "full_name", "name" } });
+    Record_Batch migrated(&renamed);
+    plan.apply(rows, migrated);
+    rows.clear();
+    std::cout << migrated[2]["full_name"].string() << " " << migrated[4]["id"].string() << " " << migrated.get_Arena().get_Size() << std::endl;
+
+    Struct_Type detached(user.get_Schema());
+    char data[64] = {};
+    detached.hold(data);
+    try {
+        detached["name"].set(std::string("longer than twelve bytes"));
+    } catch (std::invalid_argument& e) {
+        std::cout << e.what() << std::endl;
+    }
+    try {
+        Record_Sorter(&user, { "name" });
+    } catch (std::invalid_argument& e) {
+        std::cout << e.what() << std::endl;
+    }
+    try {
+        Record_Hasher hasher(&user);
+    } catch (std::invalid_argument& e) {
+        std::cout << e.what() << std::endl;
+    }
+    try {
+        Predicate(&user, "name == 'Ada'");
+    } catch (std::invalid_argument& e) {
+        std::cout << e.what() << std::endl;
+    }
+    try {
+        Mapped_Record_File("test_29.bin", &user);
+    } catch (std::invalid_argument& e) {
+        std::cout << e.what() << std::endl;
+    }
+}
+
+/* Tests which do not read stdin, in the order `all` runs them */
+const std::pair<const char*, void (*)()> tests[] = {
+    { "test_5", test_5 },
+    { "test_6", test_6 },
+    { "test_7", test_7 },
+    { "test_8", test_8 },
+    { "test_9", test_9 },
+    { "test_10", test_10 },
+    { "test_11", test_11 },
+    { "test_12", test_12 },
+    { "test_13", test_13 },
+    { "test_14", test_14 },
+    { "test_15", test_15 },
+    { "test_16", test_16 },
+    { "test_17", test_17 },
+    { "test_18", test_18 },
+    { "test_19", test_19 },
+    { "test_20", test_20 },
+    { "test_21", test_21 },
+    { "test_22", test_22 },
+    { "test_23", test_23 },
+    { "test_24", test_24 },
+    { "test_25", test_25 },
+    { "test_26", test_26 },
+    { "test_27", test_27 },
+    { "test_28", test_28 },
+    { "test_29", test_29 }
+};
+
+/**
+ * Usage: test [all | test_N ...]
+ * Without arguments, `test_1` reads a type from stdin. Otherwise the selected tests run,
+ * and the exit status is 1 if any check fails.
+ */
+int main(int argc, char* argv[]) {
+    if (argc == 1) {
+        test_1();
+        return 0;
+    }
+    for (int index = 1; index < argc; ++index) {
+        std::string argument = argv[index];
+        bool found = false;
+        for (const std::pair<const char*, void (*)()>& test : tests) {
+            if (argument != "all" && argument != test.first) continue;
+            std::cout << "== " << test.first << std::endl;
+            test.second();
+            found = true;
+        }
+        if (!found) {
+            std::cerr << "Unknown test '" << argument << "'" << std::endl;
+            return 2;
+        }
+    }
+    if (failures != 0) std::cerr << failures << " checks failed" << std::endl;
+    return failures == 0 ? 0 : 1;
 }
\ No newline at end of file